@@ -0,0 +1,182 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+// Minimal benchmark harness, each benchmark prints its own results.
+// Run CoreBenchmark with a substring as the first argument to only run matching benchmarks.
+namespace Benchmark
+{
+	using Clock = std::chrono::steady_clock;
+
+	struct BenchmarkEntry
+	{
+		const char* Name;
+		void (*Function)();
+		BenchmarkEntry* Next;
+	};
+
+	inline BenchmarkEntry*& Registry()
+	{
+		static BenchmarkEntry* head = nullptr;
+		return head;
+	}
+
+	struct Registrar
+	{
+		Registrar(BenchmarkEntry& entry)
+		{
+			// Keep registration order within a file
+			auto** it = &Registry();
+			while (*it)
+			{
+				it = &(*it)->Next;
+			}
+			*it = &entry;
+		}
+	};
+
+	template<typename T>
+	inline void DoNotOptimize(T const& value)
+	{
+#if defined(_MSC_VER)
+		static volatile const void* sink;
+		sink = &value;
+#else
+		asm volatile("" : : "r,m"(value) : "memory");
+#endif
+	}
+
+	inline double ElapsedSeconds(Clock::time_point start)
+	{
+		return std::chrono::duration<double>(Clock::now() - start).count();
+	}
+
+	// Returns the average nanoseconds per call of function
+	template<typename Function>
+	double NanosecondsPerOperation(std::size_t iterationCount, Function&& function)
+	{
+		auto start = Clock::now();
+
+		for (std::size_t i = 0; i < iterationCount; ++i)
+		{
+			function();
+		}
+
+		return (ElapsedSeconds(start) * 1e9) / static_cast<double>(iterationCount);
+	}
+
+	// Runs function(threadIndex) on threadCount threads released at the same time,
+	// returns the wall time in seconds until the last thread finished
+	template<typename Function>
+	double RunOnThreads(std::size_t threadCount, Function&& function)
+	{
+		std::atomic<std::size_t> ready{ 0 };
+		std::atomic<bool> go{ false };
+
+		std::vector<std::thread> threads;
+		threads.reserve(threadCount);
+
+		for (std::size_t threadIndex = 0; threadIndex < threadCount; ++threadIndex)
+		{
+			threads.emplace_back([&, threadIndex]()
+			{
+				ready.fetch_add(1);
+				while (!go.load(std::memory_order_acquire))
+				{
+					std::this_thread::yield();
+				}
+
+				function(threadIndex);
+			});
+		}
+
+		while (ready.load() != threadCount)
+		{
+			std::this_thread::yield();
+		}
+
+		auto start = Clock::now();
+		go.store(true, std::memory_order_release);
+
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+
+		return ElapsedSeconds(start);
+	}
+
+	// Resident set size of the process in bytes, 0 when it is not available on this platform
+	inline std::size_t ResidentMemoryBytes()
+	{
+#if defined(__linux__)
+		std::size_t totalPages = 0;
+		std::size_t residentPages = 0;
+
+		if (std::FILE* statm = std::fopen("/proc/self/statm", "r"))
+		{
+			if (std::fscanf(statm, "%zu %zu", &totalPages, &residentPages) != 2)
+			{
+				residentPages = 0;
+			}
+			std::fclose(statm);
+		}
+
+		return residentPages * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#else
+		return 0;
+#endif
+	}
+
+	// Single producer single consumer queue of allocations
+	template<std::size_t Capacity>
+	struct AllocationQueue
+	{
+		bool TryPush(void* allocation)
+		{
+			auto tail = Tail.load(std::memory_order_relaxed);
+			if (tail - Head.load(std::memory_order_acquire) == Capacity)
+			{
+				return false;
+			}
+
+			Allocations[tail % Capacity] = allocation;
+			Tail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		void* TryPop()
+		{
+			auto head = Head.load(std::memory_order_relaxed);
+			if (head == Tail.load(std::memory_order_acquire))
+			{
+				return nullptr;
+			}
+
+			void* allocation = Allocations[head % Capacity];
+			Head.store(head + 1, std::memory_order_release);
+			return allocation;
+		}
+
+		alignas(64) std::atomic<std::size_t> Head{ 0 };
+		alignas(64) std::atomic<std::size_t> Tail{ 0 };
+		void* Allocations[Capacity];
+	};
+
+	constexpr std::size_t ThreadCounts[] = { 1, 2, 4, 8, 16, 32, 64 };
+}
+
+#define BAROQUE_BENCHMARK(Group, Name) \
+	static void Group##_##Name##_Benchmark(); \
+	static Benchmark::BenchmarkEntry Group##_##Name##_Entry{ #Group "." #Name, &Group##_##Name##_Benchmark, nullptr }; \
+	static Benchmark::Registrar Group##_##Name##_Registrar(Group##_##Name##_Entry); \
+	static void Group##_##Name##_Benchmark()
@@ -0,0 +1,158 @@
+#include "Benchmarks/Core/Benchmark.h"
+
+#include "Core/Containers/Array.h"
+#include "Core/Containers/GrowthPolicy.h"
+#include "Core/Memory/Memory.h"
+
+#include <memory>
+
+namespace
+{
+	constexpr std::size_t SmallArrayCount = 200000;
+	constexpr std::size_t MaxSmallArraySize = 300;
+	constexpr std::size_t LargeArraySize = 50000000;
+
+	// Default allocator counting the bytes of the blocks it really gives
+	class PeakAllocator
+	{
+	public:
+		static constexpr std::size_t StackCapacity = 0;
+
+		void* Allocate(const std::size_t size)
+		{
+			void* ptr = _allocator.Allocate(size);
+			addLiveBytes(ptr ? GetAllocationSize(size) : 0);
+			return ptr;
+		}
+
+		void* Allocate(const std::size_t size, const std::size_t alignment)
+		{
+			void* ptr = _allocator.Allocate(size, alignment);
+			addLiveBytes(ptr ? GetAllocationSize(size) : 0);
+			return ptr;
+		}
+
+		void Deallocate(void* ptr, const std::size_t size)
+		{
+			if (ptr)
+			{
+				LiveBytes -= GetAllocationSize(size);
+			}
+
+			_allocator.Deallocate(ptr, size);
+		}
+
+		void* Reallocate(void* ptr, const std::size_t oldSize, const std::size_t newSize)
+		{
+			void* newPtr = _allocator.Reallocate(ptr, oldSize, newSize);
+
+			if (newPtr)
+			{
+				LiveBytes -= GetAllocationSize(oldSize);
+				addLiveBytes(GetAllocationSize(newSize));
+			}
+
+			return newPtr;
+		}
+
+		static std::size_t GetAllocationSize(const std::size_t size)
+		{
+			return Baroque::Memory::ThreadCachingAllocator::GetAllocationSize(size);
+		}
+
+		static void Reset()
+		{
+			LiveBytes = 0;
+			PeakLiveBytes = 0;
+		}
+
+		static inline std::size_t LiveBytes = 0;
+		static inline std::size_t PeakLiveBytes = 0;
+
+	private:
+		static void addLiveBytes(std::size_t size)
+		{
+			LiveBytes += size;
+			PeakLiveBytes = Baroque::Algorithm::Max(PeakLiveBytes, LiveBytes);
+		}
+
+		Baroque::Memory::ThreadCachingAllocator _allocator;
+	};
+
+	BAROQUE_DEFINE_ALLOCATOR(BenchmarkAllocator, PeakAllocator);
+
+	std::size_t smallArraySize(std::size_t index)
+	{
+		return 1 + (index * 2654435761u) % MaxSmallArraySize;
+	}
+
+	// Lots of arrays filled one item at a time, like the adjacency lists of a graph
+	template<typename GrowthPolicy>
+	void smallArrays(const char* name)
+	{
+		using SmallArray = Baroque::Array<std::uint32_t, BenchmarkAllocator, GrowthPolicy>;
+
+		PeakAllocator::Reset();
+
+		std::unique_ptr<SmallArray[]> arrays(new SmallArray[SmallArrayCount]);
+		std::size_t itemCount = 0;
+
+		auto nanoseconds = Benchmark::NanosecondsPerOperation(SmallArrayCount, [&, index = std::size_t(0)]() mutable
+		{
+			auto& array = arrays[index];
+			const auto size = smallArraySize(index++);
+
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				array.Add(static_cast<std::uint32_t>(i));
+			}
+
+			itemCount += size;
+		});
+
+		const auto usedBytes = itemCount * sizeof(std::uint32_t);
+
+		std::printf("%-32s %8.2f ns per item %8.2f MB peak %6.1f%% unused\n", name, nanoseconds * SmallArrayCount / itemCount, PeakAllocator::PeakLiveBytes / 1e6, 100.0 * (PeakAllocator::PeakLiveBytes - usedBytes) / PeakAllocator::PeakLiveBytes);
+	}
+
+	// One array filled one item at a time until it takes hundreds of MB
+	template<typename GrowthPolicy>
+	void largeArray(const char* name)
+	{
+		PeakAllocator::Reset();
+
+		std::size_t finalBytes = 0;
+
+		auto nanoseconds = Benchmark::NanosecondsPerOperation(1, [&]()
+		{
+			Baroque::Array<std::uint64_t, BenchmarkAllocator, GrowthPolicy> values;
+
+			for (std::size_t i = 0; i < LargeArraySize; ++i)
+			{
+				values.Add(i);
+			}
+
+			Benchmark::DoNotOptimize(values.Data());
+			finalBytes = PeakAllocator::LiveBytes;
+		});
+
+		std::printf("%-32s %8.2f ns per item %8.2f MB peak %8.2f MB final\n", name, nanoseconds / LargeArraySize, PeakAllocator::PeakLiveBytes / 1e6, finalBytes / 1e6);
+	}
+}
+
+BAROQUE_BENCHMARK(ArrayGrowth, SmallArrays)
+{
+	smallArrays<Baroque::DoublingGrowth>("DoublingGrowth");
+	smallArrays<Baroque::OneAndHalfGrowth>("OneAndHalfGrowth");
+	smallArrays<Baroque::SizeClassGrowth<Baroque::DoublingGrowth>>("SizeClassGrowth<Doubling>");
+	smallArrays<Baroque::SizeClassGrowth<Baroque::OneAndHalfGrowth>>("SizeClassGrowth<OneAndHalf>");
+}
+
+BAROQUE_BENCHMARK(ArrayGrowth, LargeArray)
+{
+	largeArray<Baroque::DoublingGrowth>("DoublingGrowth");
+	largeArray<Baroque::OneAndHalfGrowth>("OneAndHalfGrowth");
+	largeArray<Baroque::SizeClassGrowth<Baroque::DoublingGrowth>>("SizeClassGrowth<Doubling>");
+	largeArray<Baroque::SizeClassGrowth<Baroque::OneAndHalfGrowth>>("SizeClassGrowth<OneAndHalf>");
+	largeArray<Baroque::PageGrowth<Baroque::OneAndHalfGrowth>>("PageGrowth<OneAndHalf>");
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include "Benchmarks/Core/Benchmark.h"
+
+#include "Core/Containers/Array.h"
+
+namespace
+{
+	constexpr std::size_t ArraySize = 500000;
+	constexpr std::size_t RunCount = 10;
+
+	struct SmallEntry
+	{
+		std::uint32_t Key;
+	};
+
+	struct LargeEntry
+	{
+		std::uint32_t Key;
+		std::uint32_t Payload[15];
+	};
+
+	// Removes the items whose hashed key falls below percent out of 100
+	template<typename Item>
+	bool shouldRemove(const Item& item, std::uint32_t percent)
+	{
+		return (static_cast<std::uint32_t>(item.Key * 2654435761u) >> 16) % 100 < percent;
+	}
+
+	template<typename Item>
+	Baroque::Array<Item> makeArray()
+	{
+		Baroque::Array<Item> array(ArraySize);
+
+		for (std::size_t i = 0; i < ArraySize; ++i)
+		{
+			array[i].Key = static_cast<std::uint32_t>(i);
+		}
+
+		return array;
+	}
+
+	template<typename Item, bool Unordered>
+	void removeItems(const char* name, std::uint32_t percent)
+	{
+		const auto source = makeArray<Item>();
+
+		double nanoseconds = 0;
+		std::size_t removed = 0;
+
+		for (std::size_t run = 0; run < RunCount; ++run)
+		{
+			auto array = source;
+
+			nanoseconds += Benchmark::NanosecondsPerOperation(1, [&]()
+			{
+				auto predicate = [percent](const Item& item)
+				{
+					return shouldRemove(item, percent);
+				};
+
+				if constexpr (Unordered)
+				{
+					removed = array.RemoveByPredicateUnordered(predicate);
+				}
+				else
+				{
+					removed = array.RemoveByPredicate(predicate);
+				}
+			});
+
+			Benchmark::DoNotOptimize(array.Data());
+		}
+
+		std::printf("%-32s %3u%% %8.2f ms %8.2f ns per item (%zu removed)\n", name, percent, nanoseconds / RunCount / 1e6, nanoseconds / RunCount / ArraySize, removed);
+	}
+
+	template<typename Item>
+	void removeAll()
+	{
+		for (std::uint32_t percent : { 1u, 50u, 99u })
+		{
+			removeItems<Item, false>("RemoveByPredicate", percent);
+		}
+
+		for (std::uint32_t percent : { 1u, 50u, 99u })
+		{
+			removeItems<Item, true>("RemoveByPredicateUnordered", percent);
+		}
+	}
+}
+
+BAROQUE_BENCHMARK(ArrayRemove, SmallItems)
+{
+	removeAll<SmallEntry>();
+}
+
+BAROQUE_BENCHMARK(ArrayRemove, LargeItems)
+{
+	removeAll<LargeEntry>();
+}
\ No newline at end of file
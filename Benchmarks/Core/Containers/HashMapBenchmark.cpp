@@ -0,0 +1,146 @@
+#include "Benchmarks/Core/Benchmark.h"
+
+#include "Core/Algorithms/MinMax.h"
+#include "Core/Containers/Array.h"
+#include "Core/Containers/HashMap.h"
+
+#include <unordered_map>
+
+namespace
+{
+	// Every measure runs about this many operations, small maps are filled again and again
+	constexpr std::size_t OperationCount = 4000000;
+
+	using BaroqueMap = Baroque::HashMap<std::uint64_t, std::uint64_t>;
+	using StdMap = std::unordered_map<std::uint64_t, std::uint64_t>;
+
+	std::uint64_t randomKey(std::uint64_t& state)
+	{
+		state += 0x9E3779B97F4A7C15ull;
+		return Baroque::Hashing::MixHash(state);
+	}
+
+	void insert(BaroqueMap& map, std::uint64_t key)
+	{
+		map.Add(key, key);
+	}
+
+	void insert(StdMap& map, std::uint64_t key)
+	{
+		map.emplace(key, key);
+	}
+
+	bool contains(const BaroqueMap& map, std::uint64_t key)
+	{
+		return map.Find(key) != nullptr;
+	}
+
+	bool contains(const StdMap& map, std::uint64_t key)
+	{
+		return map.find(key) != map.end();
+	}
+
+	void remove(BaroqueMap& map, std::uint64_t key)
+	{
+		map.Remove(key);
+	}
+
+	void remove(StdMap& map, std::uint64_t key)
+	{
+		map.erase(key);
+	}
+
+	template<typename Map>
+	void run(const char* name, std::size_t entryCount)
+	{
+		Baroque::Array<std::uint64_t> keys(entryCount);
+		Baroque::Array<std::uint64_t> missingKeys(entryCount);
+
+		std::uint64_t state = entryCount;
+
+		for (std::size_t i = 0; i < entryCount; ++i)
+		{
+			keys[i] = randomKey(state);
+			missingKeys[i] = randomKey(state);
+		}
+
+		const auto repeatCount = Baroque::Algorithm::Max<std::size_t>(1, OperationCount / entryCount);
+
+		double insertSeconds = 0;
+		double hitSeconds = 0;
+		double missSeconds = 0;
+		double removeSeconds = 0;
+		std::size_t found = 0;
+
+		for (std::size_t repeat = 0; repeat < repeatCount; ++repeat)
+		{
+			Map map;
+
+			auto start = Benchmark::Clock::now();
+
+			for (auto key : keys)
+			{
+				insert(map, key);
+			}
+
+			insertSeconds += Benchmark::ElapsedSeconds(start);
+
+			start = Benchmark::Clock::now();
+
+			for (auto key : keys)
+			{
+				found += contains(map, key);
+			}
+
+			hitSeconds += Benchmark::ElapsedSeconds(start);
+
+			start = Benchmark::Clock::now();
+
+			for (auto key : missingKeys)
+			{
+				found += contains(map, key);
+			}
+
+			missSeconds += Benchmark::ElapsedSeconds(start);
+
+			start = Benchmark::Clock::now();
+
+			for (auto key : keys)
+			{
+				remove(map, key);
+			}
+
+			removeSeconds += Benchmark::ElapsedSeconds(start);
+		}
+
+		Benchmark::DoNotOptimize(found);
+
+		const double operationCount = static_cast<double>(repeatCount * entryCount) / 1e9;
+
+		std::printf("%-20s %9zu entries: insert %7.2f ns, find hit %7.2f ns, find miss %7.2f ns, remove %7.2f ns\n", name, entryCount,
+			insertSeconds / operationCount, hitSeconds / operationCount, missSeconds / operationCount, removeSeconds / operationCount);
+	}
+
+	void runAll(std::size_t entryCount)
+	{
+		run<BaroqueMap>("Baroque::HashMap", entryCount);
+		run<StdMap>("std::unordered_map", entryCount);
+	}
+}
+
+BAROQUE_BENCHMARK(HashMap, Small)
+{
+	runAll(1000);
+	runAll(10000);
+}
+
+BAROQUE_BENCHMARK(HashMap, Medium)
+{
+	runAll(100000);
+	runAll(1000000);
+}
+
+BAROQUE_BENCHMARK(HashMap, Large)
+{
+	runAll(10000000);
+}
\ No newline at end of file
@@ -0,0 +1,151 @@
+#include "Benchmarks/Core/Benchmark.h"
+
+#include "Core/Containers/Array.h"
+#include "Core/Containers/RingBuffer.h"
+
+#include <deque>
+
+namespace
+{
+	constexpr std::size_t OperationCount = 10000000;
+
+	struct Message
+	{
+		std::uint64_t Id;
+		std::uint64_t Payload[3];
+	};
+
+	// Queue holding depth messages, each operation pushes one message at the back and pops one from the front
+	template<typename Push, typename PopFront>
+	double runQueue(std::size_t depth, std::size_t operationCount, Push&& push, PopFront&& popFront)
+	{
+		for (std::size_t i = 0; i < depth; ++i)
+		{
+			push(Message{ i, {} });
+		}
+
+		return Benchmark::NanosecondsPerOperation(operationCount, [&, id = depth]() mutable {
+			push(Message{ id++, {} });
+			popFront();
+		});
+	}
+
+	void runAll(std::size_t depth)
+	{
+		std::uint64_t sum = 0;
+
+		{
+			Baroque::RingBuffer<Message> queue;
+
+			const auto ns = runQueue(depth, OperationCount,
+				[&](const Message& message) { queue.PushBack(message); },
+				[&]() { sum += queue.Front().Id; queue.PopFront(); });
+
+			std::printf("%-32s depth %6zu: %6.2f ns per push and pop\n", "Baroque::RingBuffer", depth, ns);
+		}
+
+		if (depth <= 1024)
+		{
+			Baroque::FixedRingBuffer<Message, 1024> queue;
+
+			const auto ns = runQueue(depth, OperationCount,
+				[&](const Message& message) { queue.PushBack(message); },
+				[&]() { sum += queue.Front().Id; queue.PopFront(); });
+
+			std::printf("%-32s depth %6zu: %6.2f ns per push and pop\n", "Baroque::FixedRingBuffer<1024>", depth, ns);
+		}
+
+		{
+			std::deque<Message> queue;
+
+			const auto ns = runQueue(depth, OperationCount,
+				[&](const Message& message) { queue.push_back(message); },
+				[&]() { sum += queue.front().Id; queue.pop_front(); });
+
+			std::printf("%-32s depth %6zu: %6.2f ns per push and pop\n", "std::deque", depth, ns);
+		}
+
+		{
+			Baroque::Array<Message> queue;
+
+			// Every pop shifts the whole queue, fewer operations keep the run short
+			const auto ns = runQueue(depth, OperationCount / Baroque::Algorithm::Max<std::size_t>(1, depth / 16),
+				[&](const Message& message) { queue.Add(message); },
+				[&]() { sum += queue[0].Id; queue.RemoveAt(0); });
+
+			std::printf("%-32s depth %6zu: %6.2f ns per push and pop\n", "Array with RemoveAt(0)", depth, ns);
+		}
+
+		Benchmark::DoNotOptimize(sum);
+	}
+
+	// Bytes received in chunks and consumed in chunks of another size, through the two spans of the buffer
+	void runStream()
+	{
+		constexpr std::size_t ChunkSize = 1500;
+		constexpr std::size_t ReadSize = 4096;
+		constexpr std::size_t ByteCount = std::size_t(1) << 30;
+
+		std::uint8_t chunk[ChunkSize] = {};
+		std::uint8_t read[ReadSize];
+		std::uint64_t sum = 0;
+
+		{
+			Baroque::RingBuffer<std::uint8_t> buffer;
+			buffer.Reserve(64 * 1024);
+
+			auto start = Benchmark::Clock::now();
+
+			for (std::size_t received = 0; received < ByteCount; received += ChunkSize)
+			{
+				buffer.PushBack(Baroque::ArrayView<std::uint8_t>(chunk, ChunkSize));
+
+				while (buffer.Size() >= ReadSize)
+				{
+					buffer.PopFront(Baroque::ArraySpan<std::uint8_t>(read, ReadSize));
+					sum += read[0];
+				}
+			}
+
+			const auto seconds = Benchmark::ElapsedSeconds(start);
+
+			std::printf("%-32s %6.2f GB/s\n", "Baroque::RingBuffer bytes", static_cast<double>(ByteCount) / seconds / 1e9);
+		}
+
+		{
+			std::deque<std::uint8_t> buffer;
+
+			auto start = Benchmark::Clock::now();
+
+			for (std::size_t received = 0; received < ByteCount; received += ChunkSize)
+			{
+				buffer.insert(buffer.end(), chunk, chunk + ChunkSize);
+
+				while (buffer.size() >= ReadSize)
+				{
+					std::copy(buffer.begin(), buffer.begin() + ReadSize, read);
+					buffer.erase(buffer.begin(), buffer.begin() + ReadSize);
+					sum += read[0];
+				}
+			}
+
+			const auto seconds = Benchmark::ElapsedSeconds(start);
+
+			std::printf("%-32s %6.2f GB/s\n", "std::deque bytes", static_cast<double>(ByteCount) / seconds / 1e9);
+		}
+
+		Benchmark::DoNotOptimize(sum);
+	}
+}
+
+BAROQUE_BENCHMARK(RingBuffer, Queue)
+{
+	runAll(16);
+	runAll(1000);
+	runAll(100000);
+}
+
+BAROQUE_BENCHMARK(RingBuffer, Stream)
+{
+	runStream();
+}
\ No newline at end of file
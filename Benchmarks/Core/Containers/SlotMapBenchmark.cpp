@@ -0,0 +1,164 @@
+#include "Benchmarks/Core/Benchmark.h"
+
+#include "Core/Containers/Array.h"
+#include "Core/Containers/SlotMap.h"
+#include "Core/Hashing/Hash.h"
+#include "Core/Memory/MallocAllocator.h"
+#include "Core/Memory/PoolAllocator.h"
+
+namespace
+{
+	constexpr std::size_t FrameCount = 100;
+
+	struct Entity
+	{
+		float Position[3];
+		float Velocity[3];
+		std::uint32_t Flags;
+		std::uint32_t Padding;
+	};
+
+	using EntityHandle = Baroque::SlotMapHandle32<Entity>;
+	using EntityPool = Baroque::Memory::PoolObjectAllocator<Entity, Baroque::Memory::MallocAllocator, 1024>;
+
+	Entity makeEntity(std::uint64_t seed)
+	{
+		const auto value = static_cast<float>(seed & 0xFF);
+
+		return Entity{ { value, value, value }, { 1.0f, 2.0f, 3.0f }, 0, 0 };
+	}
+
+	void update(Entity& entity)
+	{
+		for (int i = 0; i < 3; ++i)
+		{
+			entity.Position[i] += entity.Velocity[i] * 0.016f;
+		}
+	}
+
+	std::size_t randomIndex(std::uint64_t& state, std::size_t count)
+	{
+		state += 0x9E3779B97F4A7C15ull;
+		return static_cast<std::size_t>(Baroque::Hashing::MixHash(state) % count);
+	}
+
+	// Each frame updates every entity, looks up a tenth of them through their handle
+	// and replaces 1% of them with new ones
+	void runSlotMap(std::size_t entityCount)
+	{
+		Baroque::SlotMap<Entity> entities;
+		Baroque::Array<EntityHandle> handles;
+
+		for (std::size_t i = 0; i < entityCount; ++i)
+		{
+			handles.Add(entities.Add(makeEntity(i)));
+		}
+
+		std::uint64_t state = 0;
+		double updateSeconds = 0;
+		double lookupSeconds = 0;
+		float sum = 0;
+
+		for (std::size_t frame = 0; frame < FrameCount; ++frame)
+		{
+			auto start = Benchmark::Clock::now();
+
+			for (auto& entity : entities)
+			{
+				update(entity);
+			}
+
+			updateSeconds += Benchmark::ElapsedSeconds(start);
+
+			start = Benchmark::Clock::now();
+
+			for (std::size_t i = 0; i < entityCount / 10; ++i)
+			{
+				sum += entities.Find(handles[randomIndex(state, entityCount)])->Position[0];
+			}
+
+			lookupSeconds += Benchmark::ElapsedSeconds(start);
+
+			for (std::size_t i = 0; i < entityCount / 100; ++i)
+			{
+				auto& handle = handles[randomIndex(state, entityCount)];
+
+				entities.Remove(handle);
+				handle = entities.Add(makeEntity(state));
+			}
+		}
+
+		Benchmark::DoNotOptimize(sum);
+
+		std::printf("%-30s %8zu entities: update %6.2f ns, lookup %6.2f ns\n", "SlotMap", entityCount,
+			updateSeconds * 1e9 / static_cast<double>(FrameCount * entityCount),
+			lookupSeconds * 1e9 / static_cast<double>(FrameCount * (entityCount / 10)));
+	}
+
+	void runPool(std::size_t entityCount)
+	{
+		EntityPool pool;
+		Baroque::Array<Entity*> entities;
+
+		for (std::size_t i = 0; i < entityCount; ++i)
+		{
+			entities.Add(pool.Allocate(makeEntity(i)));
+		}
+
+		std::uint64_t state = 0;
+		double updateSeconds = 0;
+		double lookupSeconds = 0;
+		float sum = 0;
+
+		for (std::size_t frame = 0; frame < FrameCount; ++frame)
+		{
+			auto start = Benchmark::Clock::now();
+
+			for (auto* entity : entities)
+			{
+				update(*entity);
+			}
+
+			updateSeconds += Benchmark::ElapsedSeconds(start);
+
+			start = Benchmark::Clock::now();
+
+			for (std::size_t i = 0; i < entityCount / 10; ++i)
+			{
+				sum += entities[randomIndex(state, entityCount)]->Position[0];
+			}
+
+			lookupSeconds += Benchmark::ElapsedSeconds(start);
+
+			for (std::size_t i = 0; i < entityCount / 100; ++i)
+			{
+				auto& entity = entities[randomIndex(state, entityCount)];
+
+				pool.Deallocate(entity);
+				entity = pool.Allocate(makeEntity(state));
+			}
+		}
+
+		Benchmark::DoNotOptimize(sum);
+
+		std::printf("%-30s %8zu entities: update %6.2f ns, lookup %6.2f ns\n", "PoolObjectAllocator pointers", entityCount,
+			updateSeconds * 1e9 / static_cast<double>(FrameCount * entityCount),
+			lookupSeconds * 1e9 / static_cast<double>(FrameCount * (entityCount / 10)));
+	}
+
+	void runAll(std::size_t entityCount)
+	{
+		runSlotMap(entityCount);
+		runPool(entityCount);
+	}
+}
+
+BAROQUE_BENCHMARK(SlotMap, Small)
+{
+	runAll(10000);
+}
+
+BAROQUE_BENCHMARK(SlotMap, Large)
+{
+	runAll(1000000);
+}
\ No newline at end of file
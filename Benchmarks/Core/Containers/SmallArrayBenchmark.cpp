@@ -0,0 +1,54 @@
+#include "Benchmarks/Core/Benchmark.h"
+
+#include "Core/Containers/Array.h"
+
+namespace
+{
+	constexpr std::size_t CallCount = 2000000;
+	constexpr std::size_t MaxItemCount = 8;
+
+	// Two candidates to return so the compiler can't construct the result in place
+	template<typename ArrayType, bool Copy>
+	ArrayType makeArray(std::size_t index)
+	{
+		ArrayType even;
+		ArrayType odd;
+
+		const auto itemCount = 1 + index % MaxItemCount;
+
+		for (std::size_t i = 0; i < itemCount; ++i)
+		{
+			even.Add(static_cast<int>(i));
+			odd.Add(-static_cast<int>(i));
+		}
+
+		if constexpr (Copy)
+		{
+			return ArrayType(index & 1 ? odd : even);
+		}
+		else
+		{
+			return index & 1 ? std::move(odd) : std::move(even);
+		}
+	}
+
+	template<typename ArrayType, bool Copy>
+	void returnArrays(const char* name)
+	{
+		auto nanoseconds = Benchmark::NanosecondsPerOperation(CallCount, [index = std::size_t(0)]() mutable
+		{
+			auto array = makeArray<ArrayType, Copy>(index++);
+			Benchmark::DoNotOptimize(array.Data());
+		});
+
+		std::printf("%-24s %8.2f ns per call\n", name, nanoseconds);
+	}
+}
+
+BAROQUE_BENCHMARK(SmallArray, ReturnFromFunction)
+{
+	returnArrays<Baroque::Array<int>, true>("Array copy");
+	returnArrays<Baroque::Array<int>, false>("Array move");
+	returnArrays<Baroque::SmallArray<int, MaxItemCount>, true>("SmallArray copy");
+	returnArrays<Baroque::SmallArray<int, MaxItemCount>, false>("SmallArray move");
+}
\ No newline at end of file
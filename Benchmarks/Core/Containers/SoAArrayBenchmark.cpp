@@ -0,0 +1,139 @@
+#include "Benchmarks/Core/Benchmark.h"
+
+#include "Core/Containers/Array.h"
+#include "Core/Containers/SoAArray.h"
+
+namespace
+{
+	constexpr std::size_t RecordCount = 10000000;
+	constexpr std::size_t PassCount = 10;
+
+	struct Vector3
+	{
+		float X;
+		float Y;
+		float Z;
+	};
+
+	struct Record
+	{
+		Vector3 Position;
+		Vector3 Velocity;
+		float Mass;
+		std::uint32_t Flags;
+		std::uint64_t Id;
+	};
+
+	using RecordColumns = Baroque::SoAArray<Vector3, Vector3, float, std::uint32_t, std::uint64_t>;
+
+	constexpr std::size_t PositionColumn = 0;
+	constexpr std::size_t VelocityColumn = 1;
+	constexpr std::size_t MassColumn = 2;
+
+	Record makeRecord(std::size_t index)
+	{
+		const auto value = static_cast<float>(index & 0xFF);
+
+		return Record{ { value, value, value }, { 1.0f, 2.0f, 3.0f }, value * 0.5f, 0, index };
+	}
+
+	void print(const char* name, const char* loop, double seconds)
+	{
+		std::printf("%-20s %-22s %6.3f ns per record\n", name, loop, seconds * 1e9 / static_cast<double>(RecordCount * PassCount));
+	}
+
+	void runArrayOfStructs()
+	{
+		Baroque::Array<Record> records;
+		records.Reserve(RecordCount);
+
+		for (std::size_t i = 0; i < RecordCount; ++i)
+		{
+			records.Add(makeRecord(i));
+		}
+
+		float sum = 0;
+
+		auto start = Benchmark::Clock::now();
+
+		for (std::size_t pass = 0; pass < PassCount; ++pass)
+		{
+			for (auto& record : records)
+			{
+				sum += record.Mass;
+			}
+		}
+
+		print("Array of structs", "sum Mass", Benchmark::ElapsedSeconds(start));
+
+		start = Benchmark::Clock::now();
+
+		for (std::size_t pass = 0; pass < PassCount; ++pass)
+		{
+			for (auto& record : records)
+			{
+				record.Position.X += record.Velocity.X * 0.016f;
+				record.Position.Y += record.Velocity.Y * 0.016f;
+				record.Position.Z += record.Velocity.Z * 0.016f;
+			}
+		}
+
+		print("Array of structs", "Position += Velocity", Benchmark::ElapsedSeconds(start));
+
+		Benchmark::DoNotOptimize(sum);
+		Benchmark::DoNotOptimize(records[RecordCount / 2]);
+	}
+
+	void runStructOfArrays()
+	{
+		RecordColumns records;
+		records.Reserve(RecordCount);
+
+		for (std::size_t i = 0; i < RecordCount; ++i)
+		{
+			const auto record = makeRecord(i);
+
+			records.Add(record.Position, record.Velocity, record.Mass, record.Flags, record.Id);
+		}
+
+		float sum = 0;
+
+		auto start = Benchmark::Clock::now();
+
+		for (std::size_t pass = 0; pass < PassCount; ++pass)
+		{
+			for (auto mass : records.GetColumn<MassColumn>())
+			{
+				sum += mass;
+			}
+		}
+
+		print("SoAArray", "sum Mass", Benchmark::ElapsedSeconds(start));
+
+		start = Benchmark::Clock::now();
+
+		for (std::size_t pass = 0; pass < PassCount; ++pass)
+		{
+			auto positions = records.GetColumn<PositionColumn>();
+			auto velocities = records.GetColumn<VelocityColumn>();
+
+			for (std::size_t i = 0; i < RecordCount; ++i)
+			{
+				positions[i].X += velocities[i].X * 0.016f;
+				positions[i].Y += velocities[i].Y * 0.016f;
+				positions[i].Z += velocities[i].Z * 0.016f;
+			}
+		}
+
+		print("SoAArray", "Position += Velocity", Benchmark::ElapsedSeconds(start));
+
+		Benchmark::DoNotOptimize(sum);
+		Benchmark::DoNotOptimize(records.Get<PositionColumn>(RecordCount / 2));
+	}
+}
+
+BAROQUE_BENCHMARK(SoAArray, FieldLoops)
+{
+	runArrayOfStructs();
+	runStructOfArrays();
+}
\ No newline at end of file
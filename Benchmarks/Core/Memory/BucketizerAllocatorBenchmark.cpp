@@ -0,0 +1,52 @@
+#include "Benchmarks/Core/Benchmark.h"
+
+#include "Core/Memory/BucketizerAllocator.h"
+#include "Core/Memory/MallocAllocator.h"
+#include "Core/Memory/ThreadCachingAllocator.h"
+
+#include <memory>
+
+namespace
+{
+	constexpr std::size_t AllocationCount = 20000000;
+	constexpr std::size_t BatchSize = 64;
+
+	using SmallObjectAllocator = Baroque::Memory::BucketizerAllocator<16, 512, 16>;
+
+	std::size_t allocationSize(std::size_t index)
+	{
+		return 8 + ((index * 37) & 511);
+	}
+
+	// Allocates batches of mixed small sizes and frees them
+	template<typename Allocator>
+	void mixedSizesThroughput(const char* name)
+	{
+		std::unique_ptr<Allocator> allocator(new Allocator);
+
+		void* blocks[BatchSize];
+		std::size_t index = 0;
+
+		auto nanoseconds = Benchmark::NanosecondsPerOperation(AllocationCount / BatchSize, [&]()
+		{
+			for (std::size_t j = 0; j < BatchSize; ++j)
+			{
+				blocks[j] = allocator->Allocate(allocationSize(index++));
+			}
+
+			for (std::size_t j = 0; j < BatchSize; ++j)
+			{
+				allocator->Deallocate(blocks[j]);
+			}
+		});
+
+		std::printf("%-24s %8.2f M allocations/s\n", name, static_cast<double>(BatchSize) / nanoseconds * 1e3);
+	}
+}
+
+BAROQUE_BENCHMARK(BucketizerAllocator, MixedSizes)
+{
+	mixedSizesThroughput<Baroque::Memory::MallocAllocator>("MallocAllocator");
+	mixedSizesThroughput<Baroque::Memory::ThreadCachingAllocator>("ThreadCachingAllocator");
+	mixedSizesThroughput<SmallObjectAllocator>("BucketizerAllocator");
+}
\ No newline at end of file
@@ -0,0 +1,136 @@
+#include "Benchmarks/Core/Benchmark.h"
+
+#include "Core/Memory/ConcurrentPoolAllocator.h"
+#include "Core/Memory/MallocAllocator.h"
+#include "Core/Memory/PoolAllocator.h"
+#include "Core/Threading/Mutex.h"
+
+#include <memory>
+
+namespace
+{
+	constexpr std::size_t EntrySize = 64;
+
+	constexpr std::size_t AllocationCountPerThread = 4000000;
+	constexpr std::size_t BatchSize = 64;
+
+	constexpr std::size_t ProducerConsumerAllocationCount = 4000000;
+	constexpr std::size_t ProducerConsumerPairCounts[] = { 1, 2, 4, 8, 16 };
+	constexpr std::size_t QueueCapacity = 1024;
+
+	// How a shared PoolAllocator has to be used without the concurrent variant
+	class MutexPoolAllocator
+	{
+	public:
+		static constexpr std::size_t StackCapacity = 0;
+
+		void* Allocate(const std::size_t size = 0)
+		{
+			Baroque::AutoLock autoLock(_lock);
+			return _pool.Allocate(size);
+		}
+
+		void Deallocate(void* ptr)
+		{
+			Baroque::AutoLock autoLock(_lock);
+			_pool.Deallocate(ptr);
+		}
+
+	private:
+		Baroque::Mutex _lock;
+		Baroque::Memory::PoolAllocator<Baroque::Memory::MallocAllocator, EntrySize> _pool;
+	};
+
+	using ConcurrentPool = Baroque::Memory::ConcurrentPoolAllocator<Baroque::Memory::MallocAllocator, EntrySize>;
+
+	// Allocates batches of entries and frees them on the same thread
+	template<typename Allocator>
+	void sameThreadThroughput(const char* name)
+	{
+		std::unique_ptr<Allocator> allocator(new Allocator);
+
+		for (auto threadCount : Benchmark::ThreadCounts)
+		{
+			auto seconds = Benchmark::RunOnThreads(threadCount, [&](std::size_t)
+			{
+				void* entries[BatchSize];
+
+				for (std::size_t i = 0; i < AllocationCountPerThread / threadCount; i += BatchSize)
+				{
+					for (std::size_t j = 0; j < BatchSize; ++j)
+					{
+						entries[j] = allocator->Allocate();
+					}
+
+					for (std::size_t j = 0; j < BatchSize; ++j)
+					{
+						allocator->Deallocate(entries[j]);
+					}
+				}
+			});
+
+			std::printf("%-24s threads: %2zu %8.2f M allocations/s\n", name, threadCount, static_cast<double>(AllocationCountPerThread) / seconds / 1e6);
+		}
+	}
+
+	// Producer threads allocate and consumer threads free, every entry is freed by another thread
+	template<typename Allocator>
+	void producerConsumerThroughput(const char* name)
+	{
+		std::unique_ptr<Allocator> allocator(new Allocator);
+
+		for (auto pairCount : ProducerConsumerPairCounts)
+		{
+			std::unique_ptr<Benchmark::AllocationQueue<QueueCapacity>[]> queues(new Benchmark::AllocationQueue<QueueCapacity>[pairCount]);
+
+			const std::size_t allocationCountPerPair = ProducerConsumerAllocationCount / pairCount;
+
+			auto seconds = Benchmark::RunOnThreads(pairCount * 2, [&](std::size_t threadIndex)
+			{
+				auto& queue = queues[threadIndex / 2];
+
+				if (threadIndex % 2 == 0)
+				{
+					for (std::size_t i = 0; i < allocationCountPerPair; ++i)
+					{
+						void* allocation = allocator->Allocate();
+						*static_cast<std::size_t*>(allocation) = i;
+
+						while (!queue.TryPush(allocation))
+						{
+							std::this_thread::yield();
+						}
+					}
+				}
+				else
+				{
+					for (std::size_t i = 0; i < allocationCountPerPair; ++i)
+					{
+						void* allocation = nullptr;
+
+						while (!(allocation = queue.TryPop()))
+						{
+							std::this_thread::yield();
+						}
+
+						allocator->Deallocate(allocation);
+					}
+				}
+			});
+
+			std::printf("%-24s pairs: %2zu %8.2f M allocations/s\n", name, pairCount, static_cast<double>(ProducerConsumerAllocationCount) / seconds / 1e6);
+		}
+	}
+}
+
+BAROQUE_BENCHMARK(ConcurrentPoolAllocator, SameThread)
+{
+	sameThreadThroughput<MutexPoolAllocator>("Mutex PoolAllocator");
+	sameThreadThroughput<ConcurrentPool>("ConcurrentPoolAllocator");
+}
+
+BAROQUE_BENCHMARK(ConcurrentPoolAllocator, ProducerConsumer)
+{
+	producerConsumerThroughput<MutexPoolAllocator>("Mutex PoolAllocator");
+	producerConsumerThroughput<ConcurrentPool>("ConcurrentPoolAllocator");
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include "Benchmarks/Core/Benchmark.h"
+
+#include "Core/Containers/Array.h"
+#include "Core/Memory/Memory.h"
+
+namespace
+{
+	// Same allocator as the default one, without Reallocate so every growth allocates and copies
+	class CopyingAllocator
+	{
+	public:
+		static constexpr std::size_t StackCapacity = 0;
+
+		void* Allocate(const std::size_t size)
+		{
+			return _allocator.Allocate(size);
+		}
+
+		void Deallocate(void* ptr)
+		{
+			_allocator.Deallocate(ptr);
+		}
+
+	private:
+		Baroque::Memory::ThreadCachingAllocator _allocator;
+	};
+
+	BAROQUE_DEFINE_ALLOCATOR(CopyingDefaultAllocator, CopyingAllocator);
+
+	constexpr std::size_t GrowthSize = 256 * 1024 * 1024;
+	constexpr std::size_t GrowthCount = 8;
+
+	constexpr std::size_t AppendSize = 4096;
+
+	// Byte buffer appended to in small pieces with a doubling capacity, like a file being serialized
+	template<typename Allocator>
+	void growByteArray(const char* name)
+	{
+		auto nanoseconds = Benchmark::NanosecondsPerOperation(GrowthCount, [&]()
+		{
+			Baroque::Array<std::uint8_t, Allocator> bytes;
+
+			while (bytes.Size() < GrowthSize)
+			{
+				if (bytes.Size() + AppendSize > bytes.Capacity())
+				{
+					bytes.Reserve(bytes.Capacity() ? 2 * bytes.Capacity() : AppendSize);
+				}
+
+				bytes.Resize(bytes.Size() + AppendSize);
+			}
+
+			Benchmark::DoNotOptimize(bytes.Data());
+		});
+
+		std::printf("%-24s %8.2f ms per %zu MB array\n", name, nanoseconds / 1e6, GrowthSize / (1024 * 1024));
+	}
+}
+
+BAROQUE_BENCHMARK(Reallocate, ByteArrayGrowth)
+{
+	growByteArray<CopyingDefaultAllocator>("Allocate and copy");
+	growByteArray<Baroque::Memory::DefaultAllocator>("Reallocate");
+}
\ No newline at end of file
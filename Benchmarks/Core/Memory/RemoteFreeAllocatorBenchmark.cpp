@@ -0,0 +1,103 @@
+#include "Benchmarks/Core/Benchmark.h"
+
+#include "Core/Memory/ConcurrentPoolAllocator.h"
+#include "Core/Memory/MallocAllocator.h"
+#include "Core/Memory/PoolAllocator.h"
+#include "Core/Memory/RemoteFreeAllocator.h"
+#include "Core/Threading/Mutex.h"
+
+#include <memory>
+
+namespace
+{
+	constexpr std::size_t EntrySize = 64;
+
+	constexpr std::size_t AllocationCount = 4000000;
+	constexpr std::size_t QueueCapacity = 1024;
+
+	using Pool = Baroque::Memory::PoolAllocator<Baroque::Memory::MallocAllocator, EntrySize>;
+
+	class MutexPoolAllocator
+	{
+	public:
+		static constexpr std::size_t StackCapacity = 0;
+
+		void* Allocate(const std::size_t size)
+		{
+			Baroque::AutoLock autoLock(_lock);
+			return _pool.Allocate(size);
+		}
+
+		void Deallocate(void* ptr)
+		{
+			Baroque::AutoLock autoLock(_lock);
+			_pool.Deallocate(ptr);
+		}
+
+		void BindToCurrentThread()
+		{
+		}
+
+	private:
+		Baroque::Mutex _lock;
+		Pool _pool;
+	};
+
+	class ConcurrentPool : public Baroque::Memory::ConcurrentPoolAllocator<Baroque::Memory::MallocAllocator, EntrySize>
+	{
+	public:
+		void BindToCurrentThread()
+		{
+		}
+	};
+
+	// One producer allocates and one consumer frees, every entry is freed by the other thread
+	template<typename Allocator>
+	void producerConsumerThroughput(const char* name)
+	{
+		std::unique_ptr<Allocator> allocator(new Allocator);
+		std::unique_ptr<Benchmark::AllocationQueue<QueueCapacity>> queue(new Benchmark::AllocationQueue<QueueCapacity>);
+
+		auto seconds = Benchmark::RunOnThreads(2, [&](std::size_t threadIndex)
+		{
+			if (threadIndex == 0)
+			{
+				allocator->BindToCurrentThread();
+
+				for (std::size_t i = 0; i < AllocationCount; ++i)
+				{
+					void* allocation = allocator->Allocate(EntrySize);
+					*static_cast<std::size_t*>(allocation) = i;
+
+					while (!queue->TryPush(allocation))
+					{
+						std::this_thread::yield();
+					}
+				}
+			}
+			else
+			{
+				for (std::size_t i = 0; i < AllocationCount; ++i)
+				{
+					void* allocation = nullptr;
+
+					while (!(allocation = queue->TryPop()))
+					{
+						std::this_thread::yield();
+					}
+
+					allocator->Deallocate(allocation);
+				}
+			}
+		});
+
+		std::printf("%-24s %8.2f M allocations/s\n", name, static_cast<double>(AllocationCount) / seconds / 1e6);
+	}
+}
+
+BAROQUE_BENCHMARK(RemoteFreeAllocator, ProducerConsumer)
+{
+	producerConsumerThroughput<MutexPoolAllocator>("Mutex PoolAllocator");
+	producerConsumerThroughput<ConcurrentPool>("ConcurrentPoolAllocator");
+	producerConsumerThroughput<Baroque::Memory::RemoteFreeAllocator<Pool>>("RemoteFreeAllocator");
+}
\ No newline at end of file
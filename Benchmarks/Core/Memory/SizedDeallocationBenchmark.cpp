@@ -0,0 +1,67 @@
+#include "Benchmarks/Core/Benchmark.h"
+
+#include "Core/Memory/MallocAllocator.h"
+#include "Core/Memory/PoolAllocator.h"
+#include "Core/Memory/SegregatorAllocator.h"
+#include "Core/Memory/ThreadCachingAllocator.h"
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+	constexpr std::size_t LiveCount = 64 * 1024;
+	constexpr std::size_t RoundCount = 20;
+
+	// The pool takes its blocks from another allocator than MallocAllocator, a base class can't appear twice
+	using SmallPool = Baroque::Memory::PoolAllocator<Baroque::Memory::ThreadCachingAllocator, 128, 256>;
+	using Segregator = Baroque::Memory::SegregatorAllocator<128, SmallPool, Baroque::Memory::MallocAllocator>;
+
+	std::size_t allocationSize(std::size_t index)
+	{
+		// One large block every 16 allocations
+		return index % 16 == 0 ? 1024 : 16 + (index * 8) % 112;
+	}
+
+	// Frees a full set of live blocks, the pool is spread over LiveCount / 256 blocks
+	template<bool Sized>
+	void freeCost(const char* name)
+	{
+		std::unique_ptr<Segregator> allocator(new Segregator);
+		std::vector<void*> blocks(LiveCount);
+
+		double totalNanoseconds = 0;
+
+		for (std::size_t round = 0; round < RoundCount; ++round)
+		{
+			for (std::size_t i = 0; i < LiveCount; ++i)
+			{
+				blocks[i] = allocator->Allocate(allocationSize(i));
+			}
+
+			std::size_t index = 0;
+
+			totalNanoseconds += Benchmark::NanosecondsPerOperation(LiveCount, [&]()
+			{
+				if constexpr (Sized)
+				{
+					allocator->Deallocate(blocks[index], allocationSize(index));
+				}
+				else
+				{
+					allocator->Deallocate(blocks[index]);
+				}
+
+				++index;
+			});
+		}
+
+		std::printf("%-24s %8.2f ns per free\n", name, totalNanoseconds / RoundCount);
+	}
+}
+
+BAROQUE_BENCHMARK(SizedDeallocation, SegregatorFree)
+{
+	freeCost<false>("Deallocate(ptr)");
+	freeCost<true>("Deallocate(ptr, size)");
+}
\ No newline at end of file
@@ -0,0 +1,48 @@
+#include "Benchmarks/Core/Benchmark.h"
+
+#include "Core/Memory/StatsAllocator.h"
+#include "Core/Memory/ThreadCachingAllocator.h"
+
+namespace
+{
+	constexpr std::size_t AllocationCountPerThread = 4000000;
+	constexpr std::size_t BatchSize = 64;
+
+	using CountedAllocator = Baroque::Memory::StatsAllocator<Baroque::Memory::ThreadCachingAllocator>;
+
+	// Cost of the counters on top of the allocator they decorate
+	template<typename Allocator>
+	void sameThreadThroughput(const char* name)
+	{
+		Allocator allocator;
+
+		for (auto threadCount : Benchmark::ThreadCounts)
+		{
+			auto seconds = Benchmark::RunOnThreads(threadCount, [&](std::size_t threadIndex)
+			{
+				void* blocks[BatchSize];
+
+				for (std::size_t i = 0; i < AllocationCountPerThread / threadCount; i += BatchSize)
+				{
+					for (std::size_t j = 0; j < BatchSize; ++j)
+					{
+						blocks[j] = allocator.Allocate(16 + ((i + j + threadIndex) * 37 & 255));
+					}
+
+					for (std::size_t j = 0; j < BatchSize; ++j)
+					{
+						allocator.Deallocate(blocks[j]);
+					}
+				}
+			});
+
+			std::printf("%-24s threads: %2zu %8.2f M allocations/s\n", name, threadCount, static_cast<double>(AllocationCountPerThread) / seconds / 1e6);
+		}
+	}
+}
+
+BAROQUE_BENCHMARK(StatsAllocator, Overhead)
+{
+	sameThreadThroughput<Baroque::Memory::ThreadCachingAllocator>("ThreadCachingAllocator");
+	sameThreadThroughput<CountedAllocator>("StatsAllocator");
+}
\ No newline at end of file
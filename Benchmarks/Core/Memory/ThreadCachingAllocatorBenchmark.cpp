@@ -0,0 +1,114 @@
+#include "Benchmarks/Core/Benchmark.h"
+
+#include "Core/Memory/MallocAllocator.h"
+#include "Core/Memory/ThreadCachingAllocator.h"
+
+#include <memory>
+
+namespace
+{
+	constexpr std::size_t AllocationCountPerThread = 2000000;
+	constexpr std::size_t BatchSize = 64;
+
+	constexpr std::size_t ProducerConsumerAllocationCount = 4000000;
+	constexpr std::size_t ProducerConsumerPairCounts[] = { 1, 2, 4, 8, 16 };
+	constexpr std::size_t QueueCapacity = 1024;
+
+	constexpr double Megabyte = 1024.0 * 1024.0;
+
+	std::size_t allocationSize(std::size_t index)
+	{
+		return 16 + ((index * 37) & 1023);
+	}
+
+	// Allocates batches of mixed size blocks and frees them on the same thread
+	template<typename Allocator>
+	void sameThreadThroughput(const char* name)
+	{
+		Allocator allocator;
+
+		for (auto threadCount : Benchmark::ThreadCounts)
+		{
+			auto seconds = Benchmark::RunOnThreads(threadCount, [&](std::size_t threadIndex)
+			{
+				void* blocks[BatchSize];
+
+				for (std::size_t i = 0; i < AllocationCountPerThread / threadCount; i += BatchSize)
+				{
+					for (std::size_t j = 0; j < BatchSize; ++j)
+					{
+						blocks[j] = allocator.Allocate(allocationSize(i + j + threadIndex));
+					}
+
+					for (std::size_t j = 0; j < BatchSize; ++j)
+					{
+						allocator.Deallocate(blocks[j]);
+					}
+				}
+			});
+
+			std::printf("%-24s threads: %2zu %8.2f M allocations/s\n", name, threadCount, static_cast<double>(AllocationCountPerThread) / seconds / 1e6);
+		}
+	}
+
+	// Producer threads allocate and consumer threads free, every block is freed by another thread
+	template<typename Allocator>
+	void producerConsumerThroughput(const char* name)
+	{
+		Allocator allocator;
+
+		for (auto pairCount : ProducerConsumerPairCounts)
+		{
+			std::unique_ptr<Benchmark::AllocationQueue<QueueCapacity>[]> queues(new Benchmark::AllocationQueue<QueueCapacity>[pairCount]);
+
+			const std::size_t allocationCountPerPair = ProducerConsumerAllocationCount / pairCount;
+
+			auto seconds = Benchmark::RunOnThreads(pairCount * 2, [&](std::size_t threadIndex)
+			{
+				auto& queue = queues[threadIndex / 2];
+
+				if (threadIndex % 2 == 0)
+				{
+					for (std::size_t i = 0; i < allocationCountPerPair; ++i)
+					{
+						void* allocation = allocator.Allocate(allocationSize(i + threadIndex));
+						*static_cast<std::size_t*>(allocation) = i;
+
+						while (!queue.TryPush(allocation))
+						{
+							std::this_thread::yield();
+						}
+					}
+				}
+				else
+				{
+					for (std::size_t i = 0; i < allocationCountPerPair; ++i)
+					{
+						void* allocation = nullptr;
+
+						while (!(allocation = queue.TryPop()))
+						{
+							std::this_thread::yield();
+						}
+
+						allocator.Deallocate(allocation);
+					}
+				}
+			});
+
+			std::printf("%-24s pairs: %2zu %8.2f M allocations/s RSS: %8.2f MB\n", name, pairCount, static_cast<double>(ProducerConsumerAllocationCount) / seconds / 1e6, static_cast<double>(Benchmark::ResidentMemoryBytes()) / Megabyte);
+		}
+	}
+}
+
+BAROQUE_BENCHMARK(ThreadCachingAllocator, SameThread)
+{
+	sameThreadThroughput<Baroque::Memory::MallocAllocator>("MallocAllocator");
+	sameThreadThroughput<Baroque::Memory::ThreadCachingAllocator>("ThreadCachingAllocator");
+}
+
+BAROQUE_BENCHMARK(ThreadCachingAllocator, ProducerConsumer)
+{
+	producerConsumerThroughput<Baroque::Memory::MallocAllocator>("MallocAllocator");
+	producerConsumerThroughput<Baroque::Memory::ThreadCachingAllocator>("ThreadCachingAllocator");
+}
\ No newline at end of file
@@ -0,0 +1,164 @@
+#include "Benchmarks/Core/Benchmark.h"
+
+#include "Core/Memory/MallocAllocator.h"
+#include "Core/Memory/TracingAllocator.h"
+
+#include <algorithm>
+
+namespace
+{
+	constexpr std::size_t AllocationCountPerThread = 2000000;
+	constexpr std::size_t BatchSize = 64;
+
+	constexpr std::size_t LargeLiveSetCount = 10000000;
+	constexpr std::size_t LargeLiveSetOperationCount = 2000000;
+
+#if defined(BAROQUE_TRACING_ALLOCATOR)
+	Baroque::Memory::TraceMemoryCategory BenchmarkCategory("Benchmark");
+#endif
+
+#if defined(BAROQUE_TRACE_MEMORY)
+	const void* fakeAllocation(std::size_t index)
+	{
+		return reinterpret_cast<const void*>(std::uintptr_t(0x100000000) + index * 32);
+	}
+
+	void printPercentiles(const char* name, std::vector<std::uint32_t>& latencies)
+	{
+		std::sort(latencies.begin(), latencies.end());
+
+		auto percentile = [&latencies](double value)
+		{
+			return latencies[static_cast<std::size_t>(value * static_cast<double>(latencies.size() - 1))];
+		};
+
+		std::printf("%-12s p50: %6u ns p99: %6u ns p99.9: %6u ns p99.99: %7u ns max: %8u ns\n", name, percentile(0.5), percentile(0.99), percentile(0.999), percentile(0.9999), latencies.back());
+	}
+
+	template<typename Function>
+	std::uint32_t measureNanoseconds(Function&& function)
+	{
+		auto start = Benchmark::Clock::now();
+		function();
+		return static_cast<std::uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Benchmark::Clock::now() - start).count());
+	}
+#endif
+
+	// Allocates batches of mixed size blocks and frees them, the usual pattern of short-lived Array and String
+	template<typename AllocateFunction, typename DeallocateFunction>
+	void allocationThroughput(const char* name, AllocateFunction&& allocate, DeallocateFunction&& deallocate)
+	{
+		for (auto threadCount : Benchmark::ThreadCounts)
+		{
+			auto seconds = Benchmark::RunOnThreads(threadCount, [&](std::size_t threadIndex)
+			{
+				void* blocks[BatchSize];
+
+				for (std::size_t i = 0; i < AllocationCountPerThread / threadCount; i += BatchSize)
+				{
+					for (std::size_t j = 0; j < BatchSize; ++j)
+					{
+						blocks[j] = allocate(16 + (((i + j + threadIndex) * 37) & 1023));
+					}
+
+					for (std::size_t j = 0; j < BatchSize; ++j)
+					{
+						deallocate(blocks[j]);
+					}
+				}
+			});
+
+			std::printf("%-24s threads: %2zu %8.2f M allocations/s\n", name, threadCount, static_cast<double>(AllocationCountPerThread) / seconds / 1e6);
+		}
+	}
+}
+
+BAROQUE_BENCHMARK(TracingAllocator, AllocationThroughput)
+{
+	Baroque::Memory::MallocAllocator mallocAllocator;
+
+	allocationThroughput("Tracing off",
+		[&](std::size_t size) { return mallocAllocator.Allocate(size); },
+		[&](void* ptr) { mallocAllocator.Deallocate(ptr); }
+	);
+
+#if defined(BAROQUE_TRACE_MEMORY)
+	Baroque::Memory::TracingAllocator<Baroque::Memory::MallocAllocator> tracingAllocator;
+
+	allocationThroughput("Tracing on",
+		[&](std::size_t size) { return tracingAllocator.Allocate(size, BenchmarkCategory, BAROQUE_SOURCE_LOCATION); },
+		[&](void* ptr) { tracingAllocator.Deallocate(ptr); }
+	);
+#elif defined(BAROQUE_SAMPLE_MEMORY)
+	Baroque::Memory::TracingAllocator<Baroque::Memory::MallocAllocator> samplingAllocator;
+
+	allocationThroughput("Sampling on",
+		[&](std::size_t size) { return samplingAllocator.Allocate(size, BenchmarkCategory, BAROQUE_SOURCE_LOCATION); },
+		[&](void* ptr) { samplingAllocator.Deallocate(ptr); }
+	);
+#else
+	std::printf("Tracing on: BAROQUE_TRACE_MEMORY or BAROQUE_SAMPLE_MEMORY is not defined in this configuration\n");
+#endif
+}
+
+#if defined(BAROQUE_TRACE_MEMORY)
+// Per operation latency with a very large live set, growing the table must not produce rehash spikes
+BAROQUE_BENCHMARK(TracingAllocator, LargeLiveSet)
+{
+	std::vector<std::uint32_t> latencies;
+	latencies.reserve(LargeLiveSetCount);
+
+	for (std::size_t i = 0; i < LargeLiveSetCount; ++i)
+	{
+		latencies.push_back(measureNanoseconds([i]()
+		{
+			Baroque::Memory::RegisterAllocation(fakeAllocation(i), 64, BenchmarkCategory, BAROQUE_SOURCE_LOCATION);
+		}));
+	}
+
+	printPercentiles("Register", latencies);
+
+	latencies.clear();
+
+	std::uint64_t random = 0x9E3779B97F4A7C15ull;
+	auto nextIndex = [&random]()
+	{
+		random ^= random << 13;
+		random ^= random >> 7;
+		random ^= random << 17;
+		return static_cast<std::size_t>(random % LargeLiveSetCount);
+	};
+
+	for (std::size_t i = 0; i < LargeLiveSetOperationCount; ++i)
+	{
+		auto index = nextIndex();
+
+		latencies.push_back(measureNanoseconds([index]()
+		{
+			Benchmark::DoNotOptimize(Baroque::Memory::GetAllocationInfo(fakeAllocation(index)));
+		}));
+	}
+
+	printPercentiles("Lookup", latencies);
+
+	latencies.clear();
+
+	for (std::size_t i = 0; i < LargeLiveSetOperationCount; ++i)
+	{
+		auto index = nextIndex();
+
+		latencies.push_back(measureNanoseconds([index]()
+		{
+			Baroque::Memory::UnregisterAllocation(fakeAllocation(index));
+			Baroque::Memory::RegisterAllocation(fakeAllocation(index), 64, BenchmarkCategory, BAROQUE_SOURCE_LOCATION);
+		}));
+	}
+
+	printPercentiles("Free+Alloc", latencies);
+
+	for (std::size_t i = 0; i < LargeLiveSetCount; ++i)
+	{
+		Baroque::Memory::UnregisterAllocation(fakeAllocation(i));
+	}
+}
+#endif
\ No newline at end of file
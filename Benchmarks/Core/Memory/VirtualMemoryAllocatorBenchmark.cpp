@@ -0,0 +1,89 @@
+#include "Benchmarks/Core/Benchmark.h"
+
+#include "Core/Memory/VirtualMemoryAllocator.h"
+
+#include <cstring>
+
+namespace
+{
+	constexpr std::size_t RandomAccessBufferSize = 1024 * 1024 * 1024;
+	constexpr std::size_t RandomAccessCount = 20000000;
+
+	// Dependent random reads over a big buffer, mostly TLB misses with normal pages
+	template<typename Allocator>
+	void randomAccess(const char* name)
+	{
+		Allocator allocator;
+
+		auto* buffer = static_cast<std::uint64_t*>(allocator.Allocate(RandomAccessBufferSize));
+		if (!buffer)
+		{
+			std::printf("%-24s allocation failed\n", name);
+			return;
+		}
+
+		const std::size_t entryCount = RandomAccessBufferSize / sizeof(std::uint64_t);
+
+		std::memset(buffer, 0, RandomAccessBufferSize);
+
+		std::uint64_t random = 0x9E3779B97F4A7C15ull;
+		std::uint64_t index = 0;
+
+		auto nanoseconds = Benchmark::NanosecondsPerOperation(RandomAccessCount, [&]()
+		{
+			random ^= random << 13;
+			random ^= random >> 7;
+			random ^= random << 17;
+
+			index = (random + buffer[index]) % entryCount;
+		});
+
+		Benchmark::DoNotOptimize(index);
+
+		std::printf("%-24s random read: %6.2f ns RSS: %8.2f MB\n", name, nanoseconds, static_cast<double>(Benchmark::ResidentMemoryBytes()) / (1024.0 * 1024.0));
+
+		allocator.Deallocate(buffer);
+	}
+}
+
+BAROQUE_BENCHMARK(VirtualMemoryAllocator, RandomAccess)
+{
+	randomAccess<Baroque::Memory::VirtualMemoryAllocator>("VirtualMemoryAllocator");
+	randomAccess<Baroque::Memory::HugePageAllocator>("HugePageAllocator");
+}
+
+BAROQUE_BENCHMARK(VirtualMemoryAllocator, LazyCommit)
+{
+	using Baroque::Memory::VirtualMemoryAllocator;
+
+	const std::size_t reserveSize = std::size_t(64) * 1024 * 1024 * 1024;
+	const std::size_t commitSize = 64 * 1024 * 1024;
+
+	auto residentBefore = Benchmark::ResidentMemoryBytes();
+
+	auto* reserved = static_cast<std::uint8_t*>(VirtualMemoryAllocator::Reserve(reserveSize));
+	if (!reserved)
+	{
+		std::printf("Reserve of 64 GB failed\n");
+		return;
+	}
+
+	auto residentReserved = Benchmark::ResidentMemoryBytes();
+
+	VirtualMemoryAllocator::Commit(reserved, commitSize);
+	std::memset(reserved, 1, commitSize);
+
+	auto residentCommitted = Benchmark::ResidentMemoryBytes();
+
+	VirtualMemoryAllocator::Decommit(reserved, commitSize);
+
+	auto residentDecommitted = Benchmark::ResidentMemoryBytes();
+
+	VirtualMemoryAllocator::Release(reserved, reserveSize);
+
+	constexpr double Megabyte = 1024.0 * 1024.0;
+
+	std::printf("RSS delta after reserve 64 GB: %8.2f MB\n", (static_cast<double>(residentReserved) - static_cast<double>(residentBefore)) / Megabyte);
+	std::printf("RSS delta after commit 64 MB:  %8.2f MB\n", (static_cast<double>(residentCommitted) - static_cast<double>(residentBefore)) / Megabyte);
+	std::printf("RSS delta after decommit:      %8.2f MB\n", (static_cast<double>(residentDecommitted) - static_cast<double>(residentBefore)) / Megabyte);
+}
\ No newline at end of file
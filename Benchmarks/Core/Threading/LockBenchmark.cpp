@@ -0,0 +1,162 @@
+#include "Benchmarks/Core/Benchmark.h"
+
+#include "Core/Threading/Mutex.h"
+#include "Core/Threading/ReaderWriterLock.h"
+
+#include <mutex>
+#include <shared_mutex>
+
+namespace
+{
+	constexpr std::size_t UncontendedIterationCount = 10000000;
+	constexpr std::size_t ContendedOperationCount = 4000000;
+
+	// One write every WriteRatio operations
+	constexpr std::size_t WriteRatio = 16;
+
+	struct StdSharedMutexAdapter
+	{
+		void LockRead() { _mutex.lock_shared(); }
+		void UnlockRead() { _mutex.unlock_shared(); }
+		void LockWrite() { _mutex.lock(); }
+		void UnlockWrite() { _mutex.unlock(); }
+
+		std::shared_mutex _mutex;
+	};
+
+	struct StdMutexAdapter
+	{
+		void Lock() { _mutex.lock(); }
+		void Unlock() { _mutex.unlock(); }
+
+		std::mutex _mutex;
+	};
+
+	template<typename Lock>
+	void uncontendedMutex(const char* name)
+	{
+		Lock lock;
+
+		auto nanoseconds = Benchmark::NanosecondsPerOperation(UncontendedIterationCount, [&lock]()
+		{
+			lock.Lock();
+			lock.Unlock();
+		});
+
+		std::printf("%-24s lock/unlock: %6.2f ns\n", name, nanoseconds);
+	}
+
+	template<typename Lock>
+	void uncontendedReaderWriter(const char* name)
+	{
+		Lock lock;
+
+		auto readNanoseconds = Benchmark::NanosecondsPerOperation(UncontendedIterationCount, [&lock]()
+		{
+			lock.LockRead();
+			lock.UnlockRead();
+		});
+
+		auto writeNanoseconds = Benchmark::NanosecondsPerOperation(UncontendedIterationCount, [&lock]()
+		{
+			lock.LockWrite();
+			lock.UnlockWrite();
+		});
+
+		std::printf("%-24s read: %6.2f ns write: %6.2f ns\n", name, readNanoseconds, writeNanoseconds);
+	}
+
+	template<typename Lock>
+	void contendedMutex(const char* name)
+	{
+		for (auto threadCount : Benchmark::ThreadCounts)
+		{
+			Lock lock;
+			std::uint64_t counter = 0;
+
+			auto operationPerThread = ContendedOperationCount / threadCount;
+
+			auto seconds = Benchmark::RunOnThreads(threadCount, [&](std::size_t)
+			{
+				for (std::size_t i = 0; i < operationPerThread; ++i)
+				{
+					lock.Lock();
+					++counter;
+					lock.Unlock();
+				}
+			});
+
+			Benchmark::DoNotOptimize(counter);
+
+			std::printf("%-24s threads: %2zu %8.2f Mops/s\n", name, threadCount, static_cast<double>(operationPerThread * threadCount) / seconds / 1e6);
+		}
+	}
+
+	template<typename Lock>
+	void contendedReaderWriter(const char* name)
+	{
+		for (auto threadCount : Benchmark::ThreadCounts)
+		{
+			Lock lock;
+			std::uint64_t sharedValues[2] = {};
+
+			auto operationPerThread = ContendedOperationCount / threadCount;
+
+			auto seconds = Benchmark::RunOnThreads(threadCount, [&](std::size_t threadIndex)
+			{
+				for (std::size_t i = 0; i < operationPerThread; ++i)
+				{
+					if (((i + threadIndex) % WriteRatio) == 0)
+					{
+						lock.LockWrite();
+						++sharedValues[0];
+						++sharedValues[1];
+						lock.UnlockWrite();
+					}
+					else
+					{
+						lock.LockRead();
+						Benchmark::DoNotOptimize(sharedValues[0] + sharedValues[1]);
+						lock.UnlockRead();
+					}
+				}
+			});
+
+			std::printf("%-24s threads: %2zu %8.2f Mops/s\n", name, threadCount, static_cast<double>(operationPerThread * threadCount) / seconds / 1e6);
+		}
+	}
+
+#if defined(BAROQUE_PLATFORM_LINUX)
+	using ReaderPreferringLock = Baroque::ReaderWriterLockImplementation<Baroque::ReaderWriterLockMode::ReaderPreferring>;
+#endif
+}
+
+BAROQUE_BENCHMARK(Mutex, Uncontended)
+{
+	uncontendedMutex<Baroque::Mutex>("Baroque::Mutex");
+	uncontendedMutex<StdMutexAdapter>("std::mutex");
+}
+
+BAROQUE_BENCHMARK(Mutex, Contended)
+{
+	contendedMutex<Baroque::Mutex>("Baroque::Mutex");
+	contendedMutex<StdMutexAdapter>("std::mutex");
+}
+
+BAROQUE_BENCHMARK(ReaderWriterLock, Uncontended)
+{
+	uncontendedReaderWriter<Baroque::ReaderWriterLock>("Baroque::ReaderWriterLock");
+#if defined(BAROQUE_PLATFORM_LINUX)
+	uncontendedReaderWriter<ReaderPreferringLock>("ReaderPreferring");
+#endif
+	uncontendedReaderWriter<StdSharedMutexAdapter>("std::shared_mutex");
+}
+
+BAROQUE_BENCHMARK(ReaderWriterLock, ReadHeavy)
+{
+	contendedReaderWriter<Baroque::ReaderWriterLock>("Baroque::ReaderWriterLock");
+#if defined(BAROQUE_PLATFORM_LINUX)
+	contendedReaderWriter<ReaderPreferringLock>("ReaderPreferring");
+#endif
+	contendedReaderWriter<StdSharedMutexAdapter>("std::shared_mutex");
+}
\ No newline at end of file
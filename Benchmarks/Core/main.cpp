@@ -0,0 +1,23 @@
+#include "Benchmark.h"
+
+#include <cstring>
+
+int main(int argc, char** argv)
+{
+	const char* filter = argc > 1 ? argv[1] : nullptr;
+
+	for (auto* entry = Benchmark::Registry(); entry; entry = entry->Next)
+	{
+		if (filter && !std::strstr(entry->Name, filter))
+		{
+			continue;
+		}
+
+		std::printf("[ %s ]\n", entry->Name);
+		entry->Function();
+		std::printf("\n");
+		std::fflush(stdout);
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -5,10 +5,14 @@
 #include "Core/Algorithms/MinMax.h"
 #include "Core/Containers/ArrayView.h"
 #include "Core/Containers/ArraySpan.h"
+#include "Core/Containers/ContainerHelpers.h"
+#include "Core/Containers/GrowthPolicy.h"
 #include "Core/Memory/Memory.h"
 #include "Core/Utilities/TypeTraits.h"
 
 #include <cstdlib>
+#include <cstring>
+#include <utility>
 
 namespace Baroque
 {
@@ -46,12 +50,11 @@ namespace Baroque
 	template<typename T>
 	class ArrayView;
 
-	template<typename T, typename Allocator>
+	// GrowthPolicy picks the capacity when the array is full, see GrowthPolicy.h
+	template<typename T, typename Allocator, typename GrowthPolicy = DefaultGrowthPolicy>
 	class ArrayImplementation : public BaseArray, private Allocator
 	{
 	private:
-		static constexpr const auto GrowFactor = 2.0;
-		static constexpr const auto DefaultCapacity = 4;
 		static constexpr const auto InitialCapacity = Allocator::StackCapacity / sizeof(T);
 
 	public:
@@ -115,8 +118,8 @@ namespace Baroque
 			this->copy(copy.Data(), Data(), _size);
 		}
 
-		template<typename OtherAllocator>
-		constexpr ArrayImplementation(const ArrayImplementation<T, OtherAllocator>& copy)
+		template<typename OtherAllocator, typename OtherGrowthPolicy>
+		constexpr ArrayImplementation(const ArrayImplementation<T, OtherAllocator, OtherGrowthPolicy>& copy)
 		{
 			_size = copy.Size();
 			_capacity = copy.Capacity();
@@ -126,16 +129,10 @@ namespace Baroque
 			this->copy(copy.Data(), Data(), _size);
 		}
 
-		template<typename = std::enable_if_t<InitialCapacity == 0>>
+		// Items in the inline storage of the allocator are moved, a heap block is taken over
 		constexpr ArrayImplementation(ArrayImplementation&& move)
 		{
-			_size = move._size;
-			_capacity = move._capacity;
-			_data = move._data;
-
-			move._size = 0;
-			move._capacity = 0;
-			move._data = nullptr;
+			takeFrom(move);
 		}
 
 		~ArrayImplementation()
@@ -160,8 +157,8 @@ namespace Baroque
 			return *this;
 		}
 
-		template<typename OtherAllocator>
-		ArrayImplementation& operator=(const ArrayImplementation<T, OtherAllocator>& copy)
+		template<typename OtherAllocator, typename OtherGrowthPolicy>
+		ArrayImplementation& operator=(const ArrayImplementation<T, OtherAllocator, OtherGrowthPolicy>& copy)
 		{
 			internalDestructor();
 
@@ -175,18 +172,14 @@ namespace Baroque
 			return *this;
 		}
 
-		template<typename = std::enable_if_t<InitialCapacity == 0>>
 		ArrayImplementation& operator=(ArrayImplementation&& move)
 		{
-			internalDestructor();
-
-			_size = move._size;
-			_capacity = move._capacity;
-			_data = move._data;
+			if (this != &move)
+			{
+				internalDestructor();
 
-			move._size = 0;
-			move._capacity = 0;
-			move._data = nullptr;
+				takeFrom(move);
+			}
 
 			return *this;
 		}
@@ -217,8 +210,7 @@ namespace Baroque
 		{
 			auto initListSize = initList.size();
 
-			auto newCapacity = Algorithm::Max(_size + initListSize, static_cast<SizeType>(static_cast<double>(_capacity) * GrowFactor));
-			Reserve(newCapacity);
+			ensureCapacity(_size + initListSize);
 
 			copy(initList.begin(), Data() + _size, initListSize);
 
@@ -229,8 +221,7 @@ namespace Baroque
 		{
 			auto viewSize = view.Size();
 
-			auto newCapacity = Algorithm::Max(_size + viewSize, static_cast<SizeType>(static_cast<double>(_capacity) * GrowFactor));
-			Reserve(newCapacity);
+			ensureCapacity(_size + viewSize);
 
 			copy(view.begin(), Data() + _size, viewSize);
 
@@ -241,8 +232,7 @@ namespace Baroque
 		{
 			auto viewSize = view.Size();
 
-			auto newCapacity = Algorithm::Max(_size + viewSize, static_cast<SizeType>(static_cast<double>(_capacity) * GrowFactor));
-			Reserve(newCapacity);
+			ensureCapacity(_size + viewSize);
 
 			copy(view.begin(), Data() + _size, viewSize);
 
@@ -494,8 +484,7 @@ namespace Baroque
 		{
 			auto initListSize = initList.size();
 
-			auto newCapacity = Algorithm::Max(_size + initListSize, static_cast<SizeType>(static_cast<double>(_capacity) * GrowFactor));
-			Reserve(newCapacity);
+			ensureCapacity(_size + initListSize);
 
 			moveRight(Data(), index, _size, initListSize);
 
@@ -508,8 +497,7 @@ namespace Baroque
 		{
 			auto viewSize = view.Size();
 
-			auto newCapacity = Algorithm::Max(_size + viewSize, static_cast<SizeType>(static_cast<double>(_capacity) * GrowFactor));
-			Reserve(newCapacity);
+			ensureCapacity(_size + viewSize);
 
 			moveRight(Data(), index, _size, viewSize);
 
@@ -522,8 +510,7 @@ namespace Baroque
 		{
 			auto spanSize = span.Size();
 
-			auto newCapacity = Algorithm::Max(_size + spanSize, static_cast<SizeType>(static_cast<double>(_capacity) * GrowFactor));
-			Reserve(newCapacity);
+			ensureCapacity(_size + spanSize);
 
 			moveRight(Data(), index, _size, spanSize);
 
@@ -561,57 +548,105 @@ namespace Baroque
 			return returnValue;
 		}
 
+		// Keeps the order of the other items, moves each of them at most once
 		SizeType Remove(ConstReference value)
 		{
-			SizeType removed = 0;
+			return RemoveByPredicate([&value](ConstReference item)
+			{
+				return item == value;
+			});
+		}
 
+		// Keeps the order of the other items, moves each of them at most once
+		template<typename Predicate>
+		SizeType RemoveByPredicate(const Predicate& predicate)
+		{
 			auto* data = Data();
+			SizeType kept = 0;
+			SizeType index = 0;
 
-			for (SizeType index = _size - 1; index >= 0 && index < _size; --index)
+			while (index < _size)
 			{
-				if (data[index] == value)
+				const auto runStart = index;
+
+				while (index < _size && !predicate(data[index]))
 				{
-					if constexpr (!std::is_trivially_destructible_v<Value>)
-					{
-						data[index].~Value();
-					}
+					++index;
+				}
 
-					moveLeft(data, index, _size);
+				const auto runSize = index - runStart;
 
-					--_size;
-					++removed;
+				if (runSize > 0 && kept != runStart)
+				{
+					relocateLeft(data + runStart, data + kept, runSize);
+				}
+
+				kept += runSize;
+
+				if (index < _size)
+				{
+					destroyItems(data + index, data + index + 1);
+					++index;
 				}
 			}
 
+			const auto removed = _size - kept;
+
+			_size = kept;
+
 			return removed;
 		}
 
+		// Fills the holes with the last items, the order is not kept
+		SizeType RemoveUnordered(ConstReference value)
+		{
+			return RemoveByPredicateUnordered([&value](ConstReference item)
+			{
+				return item == value;
+			});
+		}
+
+		// Fills the holes with the last items, the order is not kept
 		template<typename Predicate>
-		SizeType RemoveByPredicate(const Predicate& predicate)
+		SizeType RemoveByPredicateUnordered(const Predicate& predicate)
 		{
 			SizeType removed = 0;
+			SizeType index = 0;
 
-			auto* data = Data();
-
-			for (SizeType index = _size - 1; index >= 0 && index < _size; --index)
+			while (index < _size)
 			{
-				if (predicate(data[index]))
+				if (predicate(Data()[index]))
 				{
-					if constexpr (!std::is_trivially_destructible_v<Value>)
-					{
-						data[index].~Value();
-					}
-
-					moveLeft(data, index, _size);
-
-					--_size;
+					RemoveAtSwap(index);
 					++removed;
 				}
+				else
+				{
+					++index;
+				}
 			}
 
 			return removed;
 		}
 
+		// Moves the last item in place of the removed one, the order is not kept
+		void RemoveAtSwap(SizeType index)
+		{
+			if (index < _size)
+			{
+				auto* data = Data();
+
+				destroyItems(data + index, data + index + 1);
+
+				--_size;
+
+				if (index != _size)
+				{
+					Detail::RelocateItems(data + _size, data + index, 1);
+				}
+			}
+		}
+
 		void RemoveAt(SizeType index)
 		{
 			if (index < _size)
@@ -633,11 +668,16 @@ namespace Baroque
 		{
 			if (newCapacity > _capacity)
 			{
+				if (reallocate(newCapacity))
+				{
+					return;
+				}
+
 				auto* newData = allocate(newCapacity);
 
 				if (_data)
 				{
-					relocate(reinterpret_cast<Pointer>(_data), reinterpret_cast<Pointer>(newData), _size);
+					Detail::RelocateItems(reinterpret_cast<Pointer>(_data), reinterpret_cast<Pointer>(newData), _size);
 
 					deallocateData();
 				}
@@ -667,6 +707,27 @@ namespace Baroque
 			}
 		}
 
+		// Heap blocks are exchanged, items in inline storage are moved
+		void Swap(ArrayImplementation& other)
+		{
+			if (this == &other)
+			{
+				return;
+			}
+
+			if (!isInline() && !other.isInline())
+			{
+				std::swap(_data, other._data);
+				std::swap(_size, other._size);
+				std::swap(_capacity, other._capacity);
+				return;
+			}
+
+			ArrayImplementation temporary(std::move(other));
+			other = std::move(*this);
+			*this = std::move(temporary);
+		}
+
 		constexpr ArraySpan<T> Slice(SizeType start, SizeType end)
 		{
 			return ArraySpan<T>(Data() + start, Data() + ((end - start) + 1));
@@ -750,7 +811,37 @@ namespace Baroque
 	private:
 		Pointer allocate(SizeType itemCount)
 		{
-			return static_cast<Pointer>(BAROQUE_ALLOC((*this), itemCount * sizeof(Value), Array));
+			if constexpr (alignof(Value) > Memory::DefaultAlignment)
+			{
+				return static_cast<Pointer>(BAROQUE_ALLOC_ALIGNED((*this), itemCount * sizeof(Value), alignof(Value), Array));
+			}
+			else
+			{
+				return static_cast<Pointer>(BAROQUE_ALLOC((*this), itemCount * sizeof(Value), Array));
+			}
+		}
+
+		// Items that can be moved with memcpy let the allocator grow the block in place
+		bool reallocate(SizeType newCapacity)
+		{
+			if constexpr (Traits::IsTriviallyRelocatable_v<Value> && alignof(Value) <= Memory::DefaultAlignment && Memory::CanReallocate_v<Allocator>)
+			{
+				if (_data)
+				{
+					if (auto* newData = BAROQUE_REALLOC((*this), _data, _capacity * sizeof(Value), newCapacity * sizeof(Value), Array))
+					{
+						_data = newData;
+						_capacity = newCapacity;
+						return true;
+					}
+				}
+			}
+			else
+			{
+				BAROQUE_UNUSED(newCapacity);
+			}
+
+			return false;
 		}
 
 		void copy(ConstPointer source, Pointer destination, SizeType count)
@@ -771,6 +862,35 @@ namespace Baroque
 			}
 		}
 
+		bool isInline() const
+		{
+			return Detail::IsInline<Allocator>(*this, _data);
+		}
+
+		// Leaves move empty, with its inline storage when it had items in it
+		void takeFrom(ArrayImplementation& move)
+		{
+			if (move.isInline())
+			{
+				_size = move._size;
+				_capacity = InitialCapacity;
+				_data = allocate(_capacity);
+
+				Detail::RelocateItems(move.Data(), Data(), _size);
+
+				move._size = 0;
+				return;
+			}
+
+			_size = move._size;
+			_capacity = move._capacity;
+			_data = move._data;
+
+			move._size = 0;
+			move._capacity = 0;
+			move._data = nullptr;
+		}
+
 		void internalDestructor()
 		{
 			destroyItems();
@@ -805,15 +925,20 @@ namespace Baroque
 		{
 			if (_data)
 			{
-				this->Deallocate(_data);
+				Memory::DeallocateSized(static_cast<Allocator&>(*this), _data, _capacity * sizeof(Value));
 			}
 		}
 
 		void ensureCapacity()
 		{
-			if (_size == _capacity)
+			ensureCapacity(_size + 1);
+		}
+
+		void ensureCapacity(SizeType requiredCapacity)
+		{
+			if (requiredCapacity > _capacity)
 			{
-				Reserve(_capacity ? static_cast<SizeType>(static_cast<double>(_capacity) * GrowFactor) : DefaultCapacity);
+				Reserve(GrowthPolicy::template NextCapacity<Allocator>(_capacity, requiredCapacity, sizeof(Value)));
 			}
 		}
 
@@ -844,21 +969,16 @@ namespace Baroque
 			}
 		}
 
-		void relocate(Pointer oldData, Pointer newData, SizeType itemCount)
+		// Same as Detail::RelocateItems() for a destination before the source, the ranges can overlap
+		void relocateLeft(Pointer source, Pointer destination, SizeType itemCount)
 		{
 			if constexpr (Traits::IsTriviallyRelocatable_v<Value>)
 			{
-				std::memcpy(newData, oldData, sizeof(Value) * itemCount);
+				std::memmove(destination, source, sizeof(Value) * itemCount);
 			}
 			else
 			{
-				auto sourceIt = oldData;
-				auto destinationIt = newData;
-
-				for (SizeType i = 0; i < itemCount; ++i, ++sourceIt, ++destinationIt)
-				{
-					new (destinationIt) Value(std::move(*sourceIt));
-				}
+				Detail::RelocateItems(source, destination, itemCount);
 			}
 		}
 
@@ -902,8 +1022,8 @@ namespace Baroque
 		}
 	};
 
-	template<typename T, typename Allocator>
-	inline bool operator==(const ArrayImplementation<T, Allocator>& left, const ArrayImplementation<T, Allocator>& right)
+	template<typename T, typename Allocator, typename GrowthPolicy>
+	inline bool operator==(const ArrayImplementation<T, Allocator, GrowthPolicy>& left, const ArrayImplementation<T, Allocator, GrowthPolicy>& right)
 	{
 		if (left.Size() == right.Size())
 		{
@@ -921,8 +1041,8 @@ namespace Baroque
 		return false;
 	}
 
-	template<typename T, typename Allocator>
-	inline bool operator!=(const ArrayImplementation<T, Allocator>& left, const ArrayImplementation<T, Allocator>& right)
+	template<typename T, typename Allocator, typename GrowthPolicy>
+	inline bool operator!=(const ArrayImplementation<T, Allocator, GrowthPolicy>& left, const ArrayImplementation<T, Allocator, GrowthPolicy>& right)
 	{
 		if (left.Size() == right.Size())
 		{
@@ -940,9 +1060,9 @@ namespace Baroque
 		return true;
 	}
 
-	template<typename T, typename Allocator = Baroque::Memory::DefaultAllocator>
-	using Array = ArrayImplementation<T, Allocator>;
+	template<typename T, typename Allocator = Baroque::Memory::DefaultAllocator, typename GrowthPolicy = DefaultGrowthPolicy>
+	using Array = ArrayImplementation<T, Allocator, GrowthPolicy>;
 
-	template<typename T, std::size_t Size>
-	using SmallArray = ArrayImplementation<T, Baroque::Memory::SmallAllocator<Size * sizeof(T)>>;
+	template<typename T, std::size_t Size, typename GrowthPolicy = DefaultGrowthPolicy>
+	using SmallArray = ArrayImplementation<T, Baroque::Memory::SmallAllocator<Size * sizeof(T)>, GrowthPolicy>;
 }
\ No newline at end of file
@@ -7,7 +7,7 @@
 
 namespace Baroque
 {
-	template<typename T, typename Allocator>
+	template<typename T, typename Allocator, typename GrowthPolicy>
 	class ArrayImplementation;
 
 	template<typename T>
@@ -37,8 +37,8 @@ namespace Baroque
 		, _end(begin + size)
 		{}
 
-		template<typename Allocator>
-		constexpr ArraySpan(const ArrayImplementation<T, Allocator>& array)
+		template<typename Allocator, typename GrowthPolicy>
+		constexpr ArraySpan(const ArrayImplementation<T, Allocator, GrowthPolicy>& array)
 		: _begin(array.begin())
 		, _end(array.end())
 		{}
@@ -7,7 +7,7 @@
 
 namespace Baroque
 {
-	template<typename T, typename Allocator>
+	template<typename T, typename Allocator, typename GrowthPolicy>
 	class ArrayImplementation;
 
 	template<typename T>
@@ -40,8 +40,8 @@ namespace Baroque
 		, _end(span.end())
 		{}
 
-		template<typename Allocator>
-		constexpr ArrayView(const ArrayImplementation<T, Allocator>& array)
+		template<typename Allocator, typename GrowthPolicy>
+		constexpr ArrayView(const ArrayImplementation<T, Allocator, GrowthPolicy>& array)
 		: _begin(array.begin())
 		, _end(array.end())
 		{}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Core/CoreDefines.h"
+
+#include "Core/Utilities/TypeTraits.h"
+
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Baroque
+{
+	namespace Detail
+	{
+		// The inline storage of a container is the stack of its allocator, a base of the container.
+		// Items at data are inline when they are inside the container object.
+		template<typename Allocator, typename Container>
+		bool IsInline(const Container& container, const void* data)
+		{
+			if constexpr (Allocator::StackCapacity > 0)
+			{
+				const auto address = reinterpret_cast<std::uintptr_t>(data);
+				const auto object = reinterpret_cast<std::uintptr_t>(&container);
+
+				return address >= object && address < object + sizeof(Container);
+			}
+			else
+			{
+				BAROQUE_UNUSED(container);
+				BAROQUE_UNUSED(data);
+				return false;
+			}
+		}
+
+		// The source items are gone afterwards, like after a memcpy. The ranges must not overlap.
+		template<typename T>
+		void RelocateItems(T* source, T* destination, std::size_t count)
+		{
+			if constexpr (Traits::IsTriviallyRelocatable_v<T>)
+			{
+				if (count)
+				{
+					std::memcpy(static_cast<void*>(destination), source, sizeof(T) * count);
+				}
+			}
+			else
+			{
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					new (destination + i) T(std::move(source[i]));
+
+					if constexpr (!std::is_trivially_destructible_v<T>)
+					{
+						source[i].~T();
+					}
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Core/CoreDefines.h"
+
+#include "Core/Algorithms/MinMax.h"
+#include "Core/Memory/Alignment.h"
+#include "Core/Memory/AllocatorTraits.h"
+#include "Core/Memory/VirtualMemoryAllocator.h"
+
+#include <limits>
+
+namespace Baroque
+{
+	// A growth policy gives the new capacity of a full container of capacity items that needs room for
+	// requiredCapacity items of itemSize bytes, allocated from Allocator:
+	// template<typename Allocator> static std::size_t NextCapacity(std::size_t capacity, std::size_t requiredCapacity, std::size_t itemSize)
+
+	// Multiplies the capacity by Numerator / Denominator in integer arithmetic
+	template<std::size_t Numerator, std::size_t Denominator, std::size_t MinimumCapacity = 4>
+	struct GeometricGrowth
+	{
+		static_assert(Numerator > Denominator && Denominator > 0, "The capacity must grow");
+
+		template<typename Allocator>
+		static constexpr std::size_t NextCapacity(const std::size_t capacity, const std::size_t requiredCapacity, const std::size_t itemSize)
+		{
+			BAROQUE_UNUSED(itemSize);
+
+			if (capacity > std::numeric_limits<std::size_t>::max() / Numerator)
+			{
+				return requiredCapacity;
+			}
+
+			return Algorithm::Max(Algorithm::Max(requiredCapacity, MinimumCapacity), capacity * Numerator / Denominator);
+		}
+	};
+
+	using DoublingGrowth = GeometricGrowth<2, 1>;
+
+	// Wastes at most a third of the block instead of half, and freed blocks can be reused by later growths
+	using OneAndHalfGrowth = GeometricGrowth<3, 2>;
+
+	// Rounds the capacity of BaseGrowth up to the usable size of the allocator blocks, see Memory::GetAllocationSize().
+	// The allocation lands exactly on a size class or on whole pages, the slack the allocator would waste holds items.
+	template<typename BaseGrowth = DoublingGrowth>
+	struct SizeClassGrowth
+	{
+		template<typename Allocator>
+		static std::size_t NextCapacity(const std::size_t capacity, const std::size_t requiredCapacity, const std::size_t itemSize)
+		{
+			const auto newCapacity = BaseGrowth::template NextCapacity<Allocator>(capacity, requiredCapacity, itemSize);
+
+			if (newCapacity > std::numeric_limits<std::size_t>::max() / itemSize)
+			{
+				return newCapacity;
+			}
+
+			return Memory::GetAllocationSize<Allocator>(newCapacity * itemSize) / itemSize;
+		}
+	};
+
+	// Rounds the capacity of BaseGrowth up to whole pages once the block is LargeSize bytes or more,
+	// for allocators that give large blocks in pages without telling their usable size
+	template<typename BaseGrowth = OneAndHalfGrowth, std::size_t LargeSize = 64 * 1024>
+	struct PageGrowth
+	{
+		template<typename Allocator>
+		static std::size_t NextCapacity(const std::size_t capacity, const std::size_t requiredCapacity, const std::size_t itemSize)
+		{
+			const auto newCapacity = BaseGrowth::template NextCapacity<Allocator>(capacity, requiredCapacity, itemSize);
+
+			if (newCapacity > std::numeric_limits<std::size_t>::max() / itemSize / 2 || newCapacity * itemSize < LargeSize)
+			{
+				return newCapacity;
+			}
+
+			return Memory::AlignUp(newCapacity * itemSize, Memory::VirtualMemoryAllocator::GetPageSize()) / itemSize;
+		}
+	};
+
+	using DefaultGrowthPolicy = SizeClassGrowth<DoublingGrowth>;
+}
\ No newline at end of file
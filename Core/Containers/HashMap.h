@@ -0,0 +1,151 @@
+#pragma once
+
+#include "Core/CoreDefines.h"
+
+#include "Core/Containers/HashTable.h"
+
+#include <initializer_list>
+
+namespace Baroque
+{
+	template<typename KeyType, typename ValueType>
+	struct KeyValuePair
+	{
+		KeyType Key;
+		ValueType Value;
+	};
+
+	namespace Detail
+	{
+		template<typename KeyType, typename ValueType>
+		struct HashMapPolicy
+		{
+			static const KeyType& GetKey(const KeyValuePair<KeyType, ValueType>& entry)
+			{
+				return entry.Key;
+			}
+		};
+	}
+
+	// Open addressing hash map, see Detail::HashTable. The entries are stored in place and move when the map grows.
+	// Lookups take any type that Hasher accepts and that compares equal to the keys, like a StringView for String keys.
+	// The keys of the entries must not be changed while iterating.
+	template<typename KeyType, typename ValueType, typename Hasher = Hash<KeyType>, typename Allocator = Memory::DefaultAllocator>
+	class HashMap : public Detail::HashTable<KeyValuePair<KeyType, ValueType>, Detail::HashMapPolicy<KeyType, ValueType>, Hasher, Allocator>
+	{
+	private:
+		using Base = Detail::HashTable<KeyValuePair<KeyType, ValueType>, Detail::HashMapPolicy<KeyType, ValueType>, Hasher, Allocator>;
+
+	public:
+		using Entry = KeyValuePair<KeyType, ValueType>;
+
+		HashMap() = default;
+
+		HashMap(std::initializer_list<Entry> initList)
+		{
+			this->Reserve(initList.size());
+
+			for (auto& entry : initList)
+			{
+				Set(entry.Key, entry.Value);
+			}
+		}
+
+		// Adds the entry when the key is not in the map, the current value is kept otherwise. Returns true when added.
+		template<typename LookupKey, typename... Args>
+		bool Add(LookupKey&& key, Args&&... args)
+		{
+			const auto [index, found] = this->findOrPrepareInsert(key);
+
+			if (!found)
+			{
+				new (this->slots() + index) Entry{ KeyType(std::forward<LookupKey>(key)), ValueType(std::forward<Args>(args)...) };
+			}
+
+			return !found;
+		}
+
+		// Adds the entry or replaces the value of the key
+		template<typename LookupKey, typename V>
+		ValueType& Set(LookupKey&& key, V&& value)
+		{
+			const auto [index, found] = this->findOrPrepareInsert(key);
+			auto* entry = this->slots() + index;
+
+			if (found)
+			{
+				entry->Value = std::forward<V>(value);
+			}
+			else
+			{
+				new (entry) Entry{ KeyType(std::forward<LookupKey>(key)), ValueType(std::forward<V>(value)) };
+			}
+
+			return entry->Value;
+		}
+
+		// Value of the key, added default constructed when the key is not in the map
+		template<typename LookupKey>
+		ValueType& FindOrAdd(LookupKey&& key)
+		{
+			const auto [index, found] = this->findOrPrepareInsert(key);
+			auto* entry = this->slots() + index;
+
+			if (!found)
+			{
+				new (entry) Entry{ KeyType(std::forward<LookupKey>(key)), ValueType() };
+			}
+
+			return entry->Value;
+		}
+
+		template<typename LookupKey>
+		ValueType* Find(const LookupKey& key)
+		{
+			const auto index = this->find(key, Hasher()(key));
+
+			return index != Base::NotFound ? &this->slots()[index].Value : nullptr;
+		}
+
+		template<typename LookupKey>
+		const ValueType* Find(const LookupKey& key) const
+		{
+			const auto index = this->find(key, Hasher()(key));
+
+			return index != Base::NotFound ? &this->slots()[index].Value : nullptr;
+		}
+
+		template<typename LookupKey>
+		ValueType& operator[](LookupKey&& key)
+		{
+			return FindOrAdd(std::forward<LookupKey>(key));
+		}
+	};
+
+	template<typename KeyType, typename ValueType, typename Hasher, typename Allocator>
+	inline bool operator==(const HashMap<KeyType, ValueType, Hasher, Allocator>& left, const HashMap<KeyType, ValueType, Hasher, Allocator>& right)
+	{
+		if (left.Size() != right.Size())
+		{
+			return false;
+		}
+
+		for (auto& entry : left)
+		{
+			auto* value = right.Find(entry.Key);
+
+			if (!value || !(*value == entry.Value))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	template<typename KeyType, typename ValueType, typename Hasher, typename Allocator>
+	inline bool operator!=(const HashMap<KeyType, ValueType, Hasher, Allocator>& left, const HashMap<KeyType, ValueType, Hasher, Allocator>& right)
+	{
+		return !(left == right);
+	}
+}
\ No newline at end of file
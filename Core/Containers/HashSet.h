@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Core/CoreDefines.h"
+
+#include "Core/Containers/HashTable.h"
+
+#include <initializer_list>
+
+namespace Baroque
+{
+	namespace Detail
+	{
+		template<typename ValueType>
+		struct HashSetPolicy
+		{
+			static const ValueType& GetKey(const ValueType& entry)
+			{
+				return entry;
+			}
+		};
+	}
+
+	// Open addressing hash set, see Detail::HashTable. The values are stored in place and move when the set grows.
+	// Lookups take any type that Hasher accepts and that compares equal to the values, like a StringView for String values.
+	template<typename ValueType, typename Hasher = Hash<ValueType>, typename Allocator = Memory::DefaultAllocator>
+	class HashSet : public Detail::HashTable<ValueType, Detail::HashSetPolicy<ValueType>, Hasher, Allocator>
+	{
+	private:
+		using Base = Detail::HashTable<ValueType, Detail::HashSetPolicy<ValueType>, Hasher, Allocator>;
+
+	public:
+		using ConstIterator = typename Base::ConstIterator;
+
+		HashSet() = default;
+
+		HashSet(std::initializer_list<ValueType> initList)
+		{
+			this->Reserve(initList.size());
+
+			for (auto& value : initList)
+			{
+				Add(value);
+			}
+		}
+
+		// Returns false when the value was already in the set
+		template<typename LookupValue>
+		bool Add(LookupValue&& value)
+		{
+			const auto [index, found] = this->findOrPrepareInsert(value);
+
+			if (!found)
+			{
+				new (this->slots() + index) ValueType(std::forward<LookupValue>(value));
+			}
+
+			return !found;
+		}
+
+		template<typename LookupValue>
+		const ValueType* Find(const LookupValue& value) const
+		{
+			const auto index = this->find(value, Hasher()(value));
+
+			return index != Base::NotFound ? this->slots() + index : nullptr;
+		}
+
+		// The values can't be changed in place
+		ConstIterator begin() const
+		{
+			return Base::begin();
+		}
+
+		ConstIterator end() const
+		{
+			return Base::end();
+		}
+	};
+
+	template<typename ValueType, typename Hasher, typename Allocator>
+	inline bool operator==(const HashSet<ValueType, Hasher, Allocator>& left, const HashSet<ValueType, Hasher, Allocator>& right)
+	{
+		if (left.Size() != right.Size())
+		{
+			return false;
+		}
+
+		for (auto& value : left)
+		{
+			if (!right.Contains(value))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	template<typename ValueType, typename Hasher, typename Allocator>
+	inline bool operator!=(const HashSet<ValueType, Hasher, Allocator>& left, const HashSet<ValueType, Hasher, Allocator>& right)
+	{
+		return !(left == right);
+	}
+}
\ No newline at end of file
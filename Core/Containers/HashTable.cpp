@@ -0,0 +1,6 @@
+#include "HashTable.h"
+
+namespace Baroque
+{
+	BAROQUE_REGISTER_MEMORY_CATEGORY(HashTable)
+}
\ No newline at end of file
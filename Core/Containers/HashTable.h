@@ -0,0 +1,809 @@
+#pragma once
+
+#include "Core/CoreDefines.h"
+
+#include "Core/Algorithms/MinMax.h"
+#include "Core/Containers/ContainerHelpers.h"
+#include "Core/Hashing/Hash.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Utilities/TypeTraits.h"
+
+#include <cstring>
+#include <utility>
+
+#if defined(BAROQUE_ARCHITECTURE_X64)
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Baroque
+{
+	BAROQUE_EXTERN_MEMORY_CATEGORY(HashTable)
+
+	namespace Detail
+	{
+		// Every slot of a hash table has a control byte. Full slots keep the 7 low bits of the hash of
+		// their entry, the high bit is set for free slots.
+		using ControlByte = std::int8_t;
+
+		// Free slot, stops the lookups
+		constexpr ControlByte EmptyControl = -128;
+		// Removed entry, the lookups go on after it
+		constexpr ControlByte DeletedControl = -2;
+
+		inline std::uint32_t CountTrailingZeros(std::uint64_t value)
+		{
+#if defined(_MSC_VER)
+			unsigned long index;
+			_BitScanForward64(&index, value);
+			return index;
+#else
+			return static_cast<std::uint32_t>(__builtin_ctzll(value));
+#endif
+		}
+
+		inline std::uint32_t CountLeadingZeros(std::uint64_t value)
+		{
+#if defined(_MSC_VER)
+			unsigned long index;
+			_BitScanReverse64(&index, value);
+			return 63 - index;
+#else
+			return static_cast<std::uint32_t>(__builtin_clzll(value));
+#endif
+		}
+
+		// Slots of a group matching a lookup, one bit per slot or one byte per slot when Shift is 3.
+		// Iterating gives the slot indices in the group.
+		template<std::uint32_t Width, std::uint32_t Shift>
+		class BitMask
+		{
+		public:
+			explicit BitMask(std::uint64_t mask)
+			: _mask(mask)
+			{}
+
+			explicit operator bool() const
+			{
+				return _mask != 0;
+			}
+
+			// The mask can't be empty
+			std::uint32_t TrailingZeros() const
+			{
+				return CountTrailingZeros(_mask) >> Shift;
+			}
+
+			// The mask can't be empty
+			std::uint32_t LeadingZeros() const
+			{
+				return (CountLeadingZeros(_mask) - (64 - (Width << Shift))) >> Shift;
+			}
+
+			std::uint32_t operator*() const
+			{
+				return TrailingZeros();
+			}
+
+			BitMask& operator++()
+			{
+				_mask &= _mask - 1;
+				return *this;
+			}
+
+			bool operator!=(const BitMask& other) const
+			{
+				return _mask != other._mask;
+			}
+
+			BitMask begin() const
+			{
+				return *this;
+			}
+
+			BitMask end() const
+			{
+				return BitMask(0);
+			}
+
+		private:
+			std::uint64_t _mask;
+		};
+
+#if defined(BAROQUE_ARCHITECTURE_X64)
+		// 16 control bytes compared at once with SSE2
+		class Group
+		{
+		public:
+			static constexpr std::size_t Width = 16;
+
+			using Mask = BitMask<Width, 0>;
+
+			explicit Group(const ControlByte* control)
+			: _control(_mm_loadu_si128(reinterpret_cast<const __m128i*>(control)))
+			{}
+
+			Mask Match(ControlByte hash) const
+			{
+				return matching(_mm_set1_epi8(hash));
+			}
+
+			Mask MatchEmpty() const
+			{
+				return matching(_mm_set1_epi8(EmptyControl));
+			}
+
+			Mask MatchEmptyOrDeleted() const
+			{
+				return Mask(static_cast<std::uint32_t>(_mm_movemask_epi8(_control)));
+			}
+
+		private:
+			Mask matching(__m128i value) const
+			{
+				return Mask(static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(value, _control))));
+			}
+
+			__m128i _control;
+		};
+#else
+		// 8 control bytes compared at once in a 64-bit integer
+		class Group
+		{
+		public:
+			static constexpr std::size_t Width = 8;
+
+			using Mask = BitMask<Width, 3>;
+
+			explicit Group(const ControlByte* control)
+			{
+				std::memcpy(&_control, control, sizeof(_control));
+			}
+
+			// Can also match a full slot right after a matching one, the keys are compared anyway
+			Mask Match(ControlByte hash) const
+			{
+				const auto value = _control ^ (LowBits * static_cast<std::uint8_t>(hash));
+				return Mask((value - LowBits) & ~value & HighBits);
+			}
+
+			Mask MatchEmpty() const
+			{
+				return Mask(_control & (~_control << 6) & HighBits);
+			}
+
+			Mask MatchEmptyOrDeleted() const
+			{
+				return Mask(_control & HighBits);
+			}
+
+		private:
+			static constexpr std::uint64_t LowBits = 0x0101010101010101ull;
+			static constexpr std::uint64_t HighBits = 0x8080808080808080ull;
+
+			std::uint64_t _control;
+		};
+#endif
+
+		// Visits the groups starting at every slot offset + Width * n * (n + 1) / 2, with a power of two
+		// capacity it goes through the whole table
+		class ProbeSequence
+		{
+		public:
+			ProbeSequence(std::uint64_t hash, std::size_t mask)
+			: _mask(mask)
+			, _offset(static_cast<std::size_t>(hash) & mask)
+			{}
+
+			std::size_t Offset() const
+			{
+				return _offset;
+			}
+
+			std::size_t Offset(std::size_t slot) const
+			{
+				return (_offset + slot) & _mask;
+			}
+
+			void Next()
+			{
+				_index += Group::Width;
+				_offset = (_offset + _index) & _mask;
+			}
+
+		private:
+			std::size_t _mask;
+			std::size_t _offset;
+			std::size_t _index = 0;
+		};
+
+		// Open addressing hash table of Entry, with the control bytes and the entries in one allocation.
+		// Lookups compare a group of control bytes at once and only look at the entries whose 7 hash bits match.
+		// The tables hold at most 7/8 of their capacity, removed entries leave no tombstone when no lookup
+		// can have gone past them. Policy::GetKey(entry) gives the key of an entry.
+		// Entries don't move while the table isn't growing.
+		template<typename Entry, typename Policy, typename Hasher, typename Allocator>
+		class HashTable : private Allocator
+		{
+		public:
+			using SizeType = std::size_t;
+
+			template<bool IsConst>
+			class IteratorBase
+			{
+			public:
+				using EntryType = std::conditional_t<IsConst, const Entry, Entry>;
+
+				IteratorBase(const ControlByte* control, EntryType* slot, const ControlByte* controlEnd)
+				: _control(control)
+				, _slot(slot)
+				, _controlEnd(controlEnd)
+				{
+					skipFreeSlots();
+				}
+
+				EntryType& operator*() const
+				{
+					return *_slot;
+				}
+
+				EntryType* operator->() const
+				{
+					return _slot;
+				}
+
+				IteratorBase& operator++()
+				{
+					++_control;
+					++_slot;
+
+					skipFreeSlots();
+
+					return *this;
+				}
+
+				bool operator==(const IteratorBase& other) const
+				{
+					return _slot == other._slot;
+				}
+
+				bool operator!=(const IteratorBase& other) const
+				{
+					return _slot != other._slot;
+				}
+
+			private:
+				void skipFreeSlots()
+				{
+					while (_control != _controlEnd && *_control < 0)
+					{
+						++_control;
+						++_slot;
+					}
+				}
+
+				const ControlByte* _control;
+				EntryType* _slot;
+				const ControlByte* _controlEnd;
+			};
+
+			using Iterator = IteratorBase<false>;
+			using ConstIterator = IteratorBase<true>;
+
+			HashTable() = default;
+
+			HashTable(const HashTable& copy)
+			{
+				copyFrom(copy);
+			}
+
+			// Entries in the inline storage of the allocator are moved, a heap block is taken over
+			HashTable(HashTable&& move)
+			{
+				takeFrom(move);
+			}
+
+			~HashTable()
+			{
+				destroyEntries();
+				deallocateStorage(_control, _capacity);
+			}
+
+			HashTable& operator=(const HashTable& copy)
+			{
+				if (this != &copy)
+				{
+					Clear();
+					copyFrom(copy);
+				}
+
+				return *this;
+			}
+
+			HashTable& operator=(HashTable&& move)
+			{
+				if (this != &move)
+				{
+					destroyEntries();
+					deallocateStorage(_control, _capacity);
+
+					_control = nullptr;
+					_slots = nullptr;
+					_size = 0;
+					_capacity = 0;
+					_growthLeft = 0;
+
+					takeFrom(move);
+				}
+
+				return *this;
+			}
+
+			SizeType Capacity() const
+			{
+				return _capacity;
+			}
+
+			bool IsEmpty() const
+			{
+				return _size == 0;
+			}
+
+			SizeType Size() const
+			{
+				return _size;
+			}
+
+			// Keeps the memory
+			void Clear()
+			{
+				if (_capacity == 0)
+				{
+					return;
+				}
+
+				destroyEntries();
+
+				std::memset(_control, EmptyControl, _capacity + Group::Width);
+
+				_size = 0;
+				_growthLeft = maxSize(_capacity);
+			}
+
+			template<typename LookupKey>
+			bool Contains(const LookupKey& key) const
+			{
+				return find(key, Hasher()(key)) != NotFound;
+			}
+
+			// Makes room for count entries without growing
+			void Reserve(SizeType count)
+			{
+				if (count > _size + _growthLeft)
+				{
+					resize(capacityFor(count));
+				}
+			}
+
+			template<typename LookupKey>
+			bool Remove(const LookupKey& key)
+			{
+				const auto index = find(key, Hasher()(key));
+
+				if (index == NotFound)
+				{
+					return false;
+				}
+
+				removeAt(index);
+
+				return true;
+			}
+
+			template<typename Predicate>
+			SizeType RemoveByPredicate(const Predicate& predicate)
+			{
+				SizeType removed = 0;
+
+				for (SizeType index = 0; index < _capacity; ++index)
+				{
+					if (isFull(_control[index]) && predicate(static_cast<const Entry&>(_slots[index])))
+					{
+						removeAt(index);
+						++removed;
+					}
+				}
+
+				return removed;
+			}
+
+			// Storage blocks are exchanged, entries in inline storage are moved
+			void Swap(HashTable& other)
+			{
+				if (this == &other)
+				{
+					return;
+				}
+
+				if (!isInline() && !other.isInline())
+				{
+					std::swap(_control, other._control);
+					std::swap(_slots, other._slots);
+					std::swap(_size, other._size);
+					std::swap(_capacity, other._capacity);
+					std::swap(_growthLeft, other._growthLeft);
+					return;
+				}
+
+				HashTable temporary(std::move(other));
+				other = std::move(*this);
+				*this = std::move(temporary);
+			}
+
+			Iterator begin()
+			{
+				return Iterator(_control, _slots, _control + _capacity);
+			}
+
+			ConstIterator begin() const
+			{
+				return ConstIterator(_control, _slots, _control + _capacity);
+			}
+
+			Iterator end()
+			{
+				return Iterator(_control + _capacity, _slots + _capacity, _control + _capacity);
+			}
+
+			ConstIterator end() const
+			{
+				return ConstIterator(_control + _capacity, _slots + _capacity, _control + _capacity);
+			}
+
+		protected:
+			static constexpr SizeType NotFound = ~SizeType(0);
+
+			template<typename LookupKey>
+			SizeType find(const LookupKey& key, std::uint64_t hash) const
+			{
+				if (_capacity == 0)
+				{
+					return NotFound;
+				}
+
+				ProbeSequence sequence(h1(hash), _capacity - 1);
+
+				for (;;)
+				{
+					Group group(_control + sequence.Offset());
+
+					for (auto slot : group.Match(h2(hash)))
+					{
+						const auto index = sequence.Offset(slot);
+
+						if (Policy::GetKey(_slots[index]) == key)
+						{
+							return index;
+						}
+					}
+
+					if (group.MatchEmpty())
+					{
+						return NotFound;
+					}
+
+					sequence.Next();
+				}
+			}
+
+			// Index of the entry with key, or of a free slot marked full where the caller constructs the entry
+			template<typename LookupKey>
+			std::pair<SizeType, bool> findOrPrepareInsert(const LookupKey& key)
+			{
+				const auto hash = Hasher()(key);
+				const auto index = find(key, hash);
+
+				if (index != NotFound)
+				{
+					return { index, true };
+				}
+
+				return { prepareInsert(hash), false };
+			}
+
+			SizeType prepareInsert(std::uint64_t hash)
+			{
+				if (_capacity == 0)
+				{
+					resize(Group::Width);
+				}
+
+				auto index = findFirstFree(hash);
+
+				// A tombstone can be reused without growing
+				if (_growthLeft == 0 && _control[index] != DeletedControl)
+				{
+					rehashAndGrow();
+					index = findFirstFree(hash);
+				}
+
+				if (_control[index] == EmptyControl)
+				{
+					--_growthLeft;
+				}
+
+				setControl(index, h2(hash));
+				++_size;
+
+				return index;
+			}
+
+			void removeAt(SizeType index)
+			{
+				destroyEntry(_slots[index]);
+				--_size;
+
+				// No lookup went past a slot that every group around it could still end with an empty slot
+				const auto emptyAfter = Group(_control + index).MatchEmpty();
+				const auto emptyBefore = Group(_control + ((index - Group::Width) & (_capacity - 1))).MatchEmpty();
+				const bool wasNeverFull = emptyBefore && emptyAfter && emptyAfter.TrailingZeros() + emptyBefore.LeadingZeros() < Group::Width;
+
+				if (wasNeverFull)
+				{
+					setControl(index, EmptyControl);
+					++_growthLeft;
+				}
+				else
+				{
+					setControl(index, DeletedControl);
+				}
+			}
+
+			Entry* slots()
+			{
+				return _slots;
+			}
+
+			const Entry* slots() const
+			{
+				return _slots;
+			}
+
+		private:
+			static bool isFull(ControlByte control)
+			{
+				return control >= 0;
+			}
+
+			static std::uint64_t h1(std::uint64_t hash)
+			{
+				return hash >> 7;
+			}
+
+			static ControlByte h2(std::uint64_t hash)
+			{
+				return static_cast<ControlByte>(hash & 0x7F);
+			}
+
+			static constexpr SizeType maxSize(SizeType capacity)
+			{
+				return capacity - capacity / 8;
+			}
+
+			static SizeType capacityFor(SizeType count)
+			{
+				SizeType capacity = Group::Width;
+
+				while (maxSize(capacity) < count)
+				{
+					capacity *= 2;
+				}
+
+				return capacity;
+			}
+
+			static constexpr SizeType slotsOffset(SizeType capacity)
+			{
+				return Memory::AlignUp(capacity + Group::Width, alignof(Entry));
+			}
+
+			static constexpr SizeType storageSize(SizeType capacity)
+			{
+				return slotsOffset(capacity) + capacity * sizeof(Entry);
+			}
+
+			// Largest capacity whose storage fits in the stack of the allocator. The first storage takes it: a stack only
+			// gives its memory back from the top, the storage would be freed under a bigger one allocated after it.
+			static constexpr SizeType initialCapacity()
+			{
+				constexpr SizeType alignmentPadding = alignof(Entry) > Memory::DefaultAlignment ? alignof(Entry) - Memory::DefaultAlignment : 0;
+
+				SizeType capacity = 0;
+
+				for (SizeType candidate = Group::Width; storageSize(candidate) + alignmentPadding <= Allocator::StackCapacity; candidate *= 2)
+				{
+					capacity = candidate;
+				}
+
+				return capacity;
+			}
+
+			static constexpr SizeType InitialCapacity = initialCapacity();
+
+			// The control bytes of the first group are repeated after the last slot,
+			// a group can be loaded from any slot
+			void setControl(SizeType index, ControlByte control)
+			{
+				_control[index] = control;
+
+				if (index < Group::Width)
+				{
+					_control[_capacity + index] = control;
+				}
+			}
+
+			SizeType findFirstFree(std::uint64_t hash) const
+			{
+				ProbeSequence sequence(h1(hash), _capacity - 1);
+
+				for (;;)
+				{
+					if (auto free = Group(_control + sequence.Offset()).MatchEmptyOrDeleted())
+					{
+						return sequence.Offset(free.TrailingZeros());
+					}
+
+					sequence.Next();
+				}
+			}
+
+			// Grows, or only drops the tombstones when they take half the room
+			void rehashAndGrow()
+			{
+				resize(_size <= maxSize(_capacity) / 2 ? _capacity : _capacity * 2);
+			}
+
+			void resize(SizeType newCapacity)
+			{
+				newCapacity = Algorithm::Max(newCapacity, InitialCapacity);
+
+				auto* oldControl = _control;
+				auto* oldSlots = _slots;
+				const auto oldCapacity = _capacity;
+
+				auto* storage = allocateStorage(newCapacity);
+
+				_control = reinterpret_cast<ControlByte*>(storage);
+				_slots = reinterpret_cast<Entry*>(storage + slotsOffset(newCapacity));
+				_capacity = newCapacity;
+				_growthLeft = maxSize(newCapacity) - _size;
+
+				std::memset(_control, EmptyControl, newCapacity + Group::Width);
+
+				for (SizeType index = 0; index < oldCapacity; ++index)
+				{
+					if (isFull(oldControl[index]))
+					{
+						const auto hash = Hasher()(Policy::GetKey(oldSlots[index]));
+						const auto newIndex = findFirstFree(hash);
+
+						setControl(newIndex, h2(hash));
+						Detail::RelocateItems(&oldSlots[index], &_slots[newIndex], 1);
+					}
+				}
+
+				deallocateStorage(oldControl, oldCapacity);
+			}
+
+			std::uint8_t* allocateStorage(SizeType capacity)
+			{
+				if constexpr (alignof(Entry) > Memory::DefaultAlignment)
+				{
+					return static_cast<std::uint8_t*>(BAROQUE_ALLOC_ALIGNED((*this), storageSize(capacity), alignof(Entry), HashTable));
+				}
+				else
+				{
+					return static_cast<std::uint8_t*>(BAROQUE_ALLOC((*this), storageSize(capacity), HashTable));
+				}
+			}
+
+			void deallocateStorage(ControlByte* control, SizeType capacity)
+			{
+				if (control)
+				{
+					Memory::DeallocateSized(static_cast<Allocator&>(*this), control, storageSize(capacity));
+				}
+			}
+
+			static void destroyEntry(Entry& entry)
+			{
+				if constexpr (!std::is_trivially_destructible_v<Entry>)
+				{
+					entry.~Entry();
+				}
+				else
+				{
+					BAROQUE_UNUSED(entry);
+				}
+			}
+
+			void destroyEntries()
+			{
+				if constexpr (!std::is_trivially_destructible_v<Entry>)
+				{
+					for (SizeType index = 0; index < _capacity; ++index)
+					{
+						if (isFull(_control[index]))
+						{
+							destroyEntry(_slots[index]);
+						}
+					}
+				}
+			}
+
+			bool isInline() const
+			{
+				return Detail::IsInline<Allocator>(*this, _control);
+			}
+
+			void copyFrom(const HashTable& copy)
+			{
+				Reserve(copy._size);
+
+				for (SizeType index = 0; index < copy._capacity; ++index)
+				{
+					if (isFull(copy._control[index]))
+					{
+						new (&_slots[prepareInsert(Hasher()(Policy::GetKey(copy._slots[index])))]) Entry(copy._slots[index]);
+					}
+				}
+			}
+
+			// Leaves move empty
+			void takeFrom(HashTable& move)
+			{
+				if (move.isInline())
+				{
+					Reserve(move._size);
+
+					for (SizeType index = 0; index < move._capacity; ++index)
+					{
+						if (isFull(move._control[index]))
+						{
+							Detail::RelocateItems(&move._slots[index], &_slots[prepareInsert(Hasher()(Policy::GetKey(move._slots[index])))], 1);
+						}
+					}
+
+					std::memset(move._control, EmptyControl, move._capacity + Group::Width);
+
+					move._size = 0;
+					move._growthLeft = maxSize(move._capacity);
+					return;
+				}
+
+				_control = move._control;
+				_slots = move._slots;
+				_size = move._size;
+				_capacity = move._capacity;
+				_growthLeft = move._growthLeft;
+
+				move._control = nullptr;
+				move._slots = nullptr;
+				move._size = 0;
+				move._capacity = 0;
+				move._growthLeft = 0;
+			}
+
+		private:
+			ControlByte* _control = nullptr;
+			Entry* _slots = nullptr;
+			SizeType _size = 0;
+			SizeType _capacity = 0;
+			// Empty slots that can still be filled before growing
+			SizeType _growthLeft = 0;
+		};
+	}
+}
\ No newline at end of file
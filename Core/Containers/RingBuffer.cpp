@@ -0,0 +1,6 @@
+#include "RingBuffer.h"
+
+namespace Baroque
+{
+	BAROQUE_REGISTER_MEMORY_CATEGORY(RingBuffer)
+}
\ No newline at end of file
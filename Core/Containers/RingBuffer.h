@@ -0,0 +1,701 @@
+#pragma once
+
+#include "Core/CoreDefines.h"
+
+#include "Core/Algorithms/MinMax.h"
+#include "Core/Containers/ArraySpan.h"
+#include "Core/Containers/ArrayView.h"
+#include "Core/Containers/ContainerHelpers.h"
+#include "Core/Memory/Alignment.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Utilities/TypeTraits.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace Baroque
+{
+	BAROQUE_EXTERN_MEMORY_CATEGORY(RingBuffer)
+
+	namespace Detail
+	{
+		// Items and operations shared by the ring buffers, the derived class owns the storage.
+		// The capacity is a power of two so positions wrap with a mask.
+		template<typename T>
+		class RingBufferBase
+		{
+		public:
+			using Value = T;
+			using Pointer = Value*;
+			using ConstPointer = Value const*;
+			using Reference = Value&;
+			using ConstReference = Value const&;
+			using SizeType = std::size_t;
+
+			template<bool IsConst>
+			class IteratorBase
+			{
+			public:
+				using OwnerType = std::conditional_t<IsConst, const RingBufferBase, RingBufferBase>;
+				using ItemType = std::conditional_t<IsConst, const Value, Value>;
+
+				IteratorBase(OwnerType* owner, SizeType index)
+				: _owner(owner)
+				, _index(index)
+				{}
+
+				ItemType& operator*() const
+				{
+					return (*_owner)[_index];
+				}
+
+				ItemType* operator->() const
+				{
+					return &(*_owner)[_index];
+				}
+
+				IteratorBase& operator++()
+				{
+					++_index;
+
+					return *this;
+				}
+
+				bool operator==(const IteratorBase& other) const
+				{
+					return _index == other._index;
+				}
+
+				bool operator!=(const IteratorBase& other) const
+				{
+					return _index != other._index;
+				}
+
+			private:
+				OwnerType* _owner;
+				SizeType _index;
+			};
+
+			using Iterator = IteratorBase<false>;
+			using ConstIterator = IteratorBase<true>;
+
+			Reference Back()
+			{
+				return _data[physicalIndex(_size - 1)];
+			}
+
+			ConstReference Back() const
+			{
+				return _data[physicalIndex(_size - 1)];
+			}
+
+			SizeType Capacity() const
+			{
+				return _capacity;
+			}
+
+			void Clear()
+			{
+				destroyItems();
+
+				_head = 0;
+				_size = 0;
+			}
+
+			// Items from the front up to the end of the storage, followed by SecondSpan()
+			ArraySpan<T> FirstSpan()
+			{
+				return ArraySpan<T>(_data + _head, firstSpanSize());
+			}
+
+			ArrayView<T> FirstSpan() const
+			{
+				return ArrayView<T>(_data + _head, firstSpanSize());
+			}
+
+			Reference Front()
+			{
+				return _data[_head];
+			}
+
+			ConstReference Front() const
+			{
+				return _data[_head];
+			}
+
+			bool IsEmpty() const
+			{
+				return _size == 0;
+			}
+
+			bool IsFull() const
+			{
+				return _size == _capacity;
+			}
+
+			void PopBack()
+			{
+				if (_size > 0)
+				{
+					--_size;
+
+					destroy(_data + physicalIndex(_size));
+				}
+			}
+
+			void PopFront()
+			{
+				if (_size > 0)
+				{
+					destroy(_data + _head);
+
+					_head = (_head + 1) & (_capacity - 1);
+					--_size;
+				}
+			}
+
+			// Moves up to destination.Size() items from the front into destination, returns how many were moved
+			SizeType PopFront(ArraySpan<T> destination)
+			{
+				const auto count = Algorithm::Min(destination.Size(), _size);
+				const auto firstCount = Algorithm::Min(count, firstSpanSize());
+
+				moveOut(_data + _head, destination.begin(), firstCount);
+				moveOut(_data, destination.begin() + firstCount, count - firstCount);
+
+				_head = (_head + count) & (_capacity - 1);
+				_size -= count;
+
+				return count;
+			}
+
+			// Items that wrapped around to the start of the storage, empty when the items are contiguous
+			ArraySpan<T> SecondSpan()
+			{
+				return ArraySpan<T>(_data, _size - firstSpanSize());
+			}
+
+			ArrayView<T> SecondSpan() const
+			{
+				return ArrayView<T>(_data, _size - firstSpanSize());
+			}
+
+			SizeType Size() const
+			{
+				return _size;
+			}
+
+			Iterator begin()
+			{
+				return Iterator(this, 0);
+			}
+
+			ConstIterator begin() const
+			{
+				return ConstIterator(this, 0);
+			}
+
+			Iterator end()
+			{
+				return Iterator(this, _size);
+			}
+
+			ConstIterator end() const
+			{
+				return ConstIterator(this, _size);
+			}
+
+			Reference operator[](SizeType index)
+			{
+				return _data[physicalIndex(index)];
+			}
+
+			ConstReference operator[](SizeType index) const
+			{
+				return _data[physicalIndex(index)];
+			}
+
+		protected:
+			SizeType physicalIndex(SizeType index) const
+			{
+				return (_head + index) & (_capacity - 1);
+			}
+
+			SizeType firstSpanSize() const
+			{
+				return Algorithm::Min(_size, _capacity - _head);
+			}
+
+			// The room for the item must be there
+			template<typename... Args>
+			void constructBack(Args&&... args)
+			{
+				new (_data + physicalIndex(_size)) Value(std::forward<Args>(args)...);
+
+				++_size;
+			}
+
+			template<typename... Args>
+			void constructFront(Args&&... args)
+			{
+				const auto head = (_head - 1) & (_capacity - 1);
+
+				new (_data + head) Value(std::forward<Args>(args)...);
+
+				_head = head;
+				++_size;
+			}
+
+			// Copies view after the back in at most two runs, the room for the items must be there
+			void copyBack(ArrayView<T> view)
+			{
+				const auto tail = physicalIndex(_size);
+				const auto firstCount = Algorithm::Min(view.Size(), _capacity - tail);
+
+				copyItems(view.begin(), _data + tail, firstCount);
+				copyItems(view.begin() + firstCount, _data, view.Size() - firstCount);
+
+				_size += view.Size();
+			}
+
+			void copyFrom(const RingBufferBase& copy)
+			{
+				copyBack(copy.FirstSpan());
+				copyBack(copy.SecondSpan());
+			}
+
+			// Relocates the items in order at the start of destination, the buffer is left without items
+			void relocateTo(Pointer destination)
+			{
+				const auto firstCount = firstSpanSize();
+
+				Detail::RelocateItems(_data + _head, destination, firstCount);
+				Detail::RelocateItems(_data, destination + firstCount, _size - firstCount);
+
+				_head = 0;
+				_size = 0;
+			}
+
+			void destroyItems()
+			{
+				if constexpr (!std::is_trivially_destructible_v<Value>)
+				{
+					for (SizeType i = 0; i < _size; ++i)
+					{
+						destroy(_data + physicalIndex(i));
+					}
+				}
+			}
+
+			static void destroy(Pointer item)
+			{
+				if constexpr (!std::is_trivially_destructible_v<Value>)
+				{
+					item->~Value();
+				}
+				else
+				{
+					BAROQUE_UNUSED(item);
+				}
+			}
+
+			static void copyItems(ConstPointer source, Pointer destination, SizeType count)
+			{
+				if constexpr (std::is_trivially_copyable_v<Value>)
+				{
+					if (count)
+					{
+						std::memcpy(destination, source, sizeof(Value) * count);
+					}
+				}
+				else
+				{
+					for (SizeType i = 0; i < count; ++i)
+					{
+						new (destination + i) Value(source[i]);
+					}
+				}
+			}
+
+			// Same as Detail::RelocateItems() into items that are already constructed
+			static void moveOut(Pointer source, Pointer destination, SizeType count)
+			{
+				if constexpr (std::is_trivially_copyable_v<Value>)
+				{
+					if (count)
+					{
+						std::memcpy(destination, source, sizeof(Value) * count);
+					}
+				}
+				else
+				{
+					for (SizeType i = 0; i < count; ++i)
+					{
+						destination[i] = std::move(source[i]);
+						destroy(source + i);
+					}
+				}
+			}
+
+		protected:
+			Pointer _data = nullptr;
+			SizeType _head = 0;
+			SizeType _size = 0;
+			SizeType _capacity = 0;
+		};
+	}
+
+	// Double-ended queue in a growable ring buffer, pushing and popping at either end is O(1).
+	// The items are in at most two contiguous runs, see FirstSpan() and SecondSpan().
+	template<typename T, typename Allocator = Memory::DefaultAllocator>
+	class RingBuffer : public Detail::RingBufferBase<T>, private Allocator
+	{
+	private:
+		using Base = Detail::RingBufferBase<T>;
+
+	public:
+		using typename Base::Value;
+		using typename Base::Pointer;
+		using typename Base::ConstReference;
+		using typename Base::SizeType;
+
+		RingBuffer() = default;
+
+		RingBuffer(const RingBuffer& copy)
+		{
+			Reserve(copy.Size());
+			this->copyFrom(copy);
+		}
+
+		RingBuffer(RingBuffer&& move)
+		{
+			takeFrom(move);
+		}
+
+		~RingBuffer()
+		{
+			internalDestructor();
+		}
+
+		RingBuffer& operator=(const RingBuffer& copy)
+		{
+			if (this != &copy)
+			{
+				this->Clear();
+
+				Reserve(copy.Size());
+				this->copyFrom(copy);
+			}
+
+			return *this;
+		}
+
+		RingBuffer& operator=(RingBuffer&& move)
+		{
+			if (this != &move)
+			{
+				internalDestructor();
+				takeFrom(move);
+			}
+
+			return *this;
+		}
+
+		template<typename... Args>
+		void EmplaceBack(Args&&... args)
+		{
+			ensureCapacity(this->_size + 1);
+			this->constructBack(std::forward<Args>(args)...);
+		}
+
+		template<typename... Args>
+		void EmplaceFront(Args&&... args)
+		{
+			ensureCapacity(this->_size + 1);
+			this->constructFront(std::forward<Args>(args)...);
+		}
+
+		void PushBack(ConstReference value)
+		{
+			EmplaceBack(value);
+		}
+
+		void PushBack(Value&& value)
+		{
+			EmplaceBack(std::move(value));
+		}
+
+		void PushBack(ArrayView<T> view)
+		{
+			ensureCapacity(this->_size + view.Size());
+			this->copyBack(view);
+		}
+
+		void PushFront(ConstReference value)
+		{
+			EmplaceFront(value);
+		}
+
+		void PushFront(Value&& value)
+		{
+			EmplaceFront(std::move(value));
+		}
+
+		// The capacity is rounded up to a power of two. Over MaxCapacity the size of the items doesn't fit in
+		// std::size_t, the program is aborted instead of allocating a smaller buffer.
+		void Reserve(SizeType capacity)
+		{
+			if (capacity <= this->_capacity)
+			{
+				return;
+			}
+
+			if (capacity > MaxCapacity)
+			{
+				std::abort();
+			}
+
+			const auto newCapacity = Algorithm::Max(Memory::NextPowerOfTwo(capacity), InitialCapacity);
+
+			auto* newData = allocate(newCapacity);
+			const auto size = this->_size;
+
+			this->relocateTo(newData);
+
+			deallocateData();
+
+			this->_data = newData;
+			this->_size = size;
+			this->_capacity = newCapacity;
+		}
+
+		void Swap(RingBuffer& other)
+		{
+			if (!isInline() && !other.isInline())
+			{
+				std::swap(this->_data, other._data);
+				std::swap(this->_head, other._head);
+				std::swap(this->_size, other._size);
+				std::swap(this->_capacity, other._capacity);
+				return;
+			}
+
+			RingBuffer temp(std::move(other));
+			other = std::move(*this);
+			*this = std::move(temp);
+		}
+
+	private:
+		// Smallest heap block, the inline storage can hold fewer items
+		static constexpr SizeType MinimumCapacity = 8;
+
+		// Largest power of two of items whose size fits in std::size_t
+		static constexpr SizeType MaxCapacity = Memory::NextPowerOfTwo(std::numeric_limits<SizeType>::max() / sizeof(Value) / 2 + 1);
+
+		// Most items that fit in the inline storage of the allocator, the first allocation takes all of it.
+		// A stack allocator only frees its last block, smaller blocks would pile up in it as the buffer grows.
+		static constexpr SizeType InitialCapacity = Allocator::StackCapacity >= sizeof(T) ? Memory::NextPowerOfTwo(Allocator::StackCapacity / sizeof(T) + 1) / 2 : 0;
+
+		Pointer allocate(SizeType capacity)
+		{
+			if constexpr (alignof(Value) > Memory::DefaultAlignment)
+			{
+				return static_cast<Pointer>(BAROQUE_ALLOC_ALIGNED((*this), capacity * sizeof(Value), alignof(Value), RingBuffer));
+			}
+			else
+			{
+				return static_cast<Pointer>(BAROQUE_ALLOC((*this), capacity * sizeof(Value), RingBuffer));
+			}
+		}
+
+		void deallocateData()
+		{
+			if (this->_data)
+			{
+				Memory::DeallocateSized(static_cast<Allocator&>(*this), this->_data, this->_capacity * sizeof(Value));
+			}
+		}
+
+		void ensureCapacity(SizeType requiredCapacity)
+		{
+			if (requiredCapacity > this->_capacity)
+			{
+				const auto newCapacity = Algorithm::Max(requiredCapacity, this->_capacity * 2);
+
+				// Reserve() takes the whole inline storage for the first growth, the minimum only applies to heap blocks
+				Reserve(newCapacity > InitialCapacity ? Algorithm::Max(newCapacity, MinimumCapacity) : newCapacity);
+			}
+		}
+
+		bool isInline() const
+		{
+			return Detail::IsInline<Allocator>(*this, this->_data);
+		}
+
+		// Leaves move empty, with its inline storage when it had items in it
+		void takeFrom(RingBuffer& move)
+		{
+			if (move.isInline())
+			{
+				const auto size = move._size;
+
+				Reserve(move._capacity);
+				move.relocateTo(this->_data);
+
+				this->_size = size;
+				return;
+			}
+
+			this->_data = move._data;
+			this->_head = move._head;
+			this->_size = move._size;
+			this->_capacity = move._capacity;
+
+			move._data = nullptr;
+			move._head = 0;
+			move._size = 0;
+			move._capacity = 0;
+		}
+
+		void internalDestructor()
+		{
+			this->Clear();
+			deallocateData();
+
+			this->_data = nullptr;
+			this->_capacity = 0;
+		}
+	};
+
+	// Ring buffer of Capacity items stored inside the object, pushes fail when it is full
+	template<typename T, std::size_t Capacity>
+	class FixedRingBuffer : public Detail::RingBufferBase<T>
+	{
+	private:
+		using Base = Detail::RingBufferBase<T>;
+
+		static_assert(Memory::IsPowerOfTwo(Capacity), "The capacity of a FixedRingBuffer must be a power of two");
+
+	public:
+		using typename Base::Value;
+		using typename Base::Pointer;
+		using typename Base::ConstReference;
+		using typename Base::SizeType;
+
+		FixedRingBuffer()
+		{
+			this->_data = reinterpret_cast<Pointer>(_storage);
+			this->_capacity = Capacity;
+		}
+
+		FixedRingBuffer(const FixedRingBuffer& copy)
+		: FixedRingBuffer()
+		{
+			this->copyFrom(copy);
+		}
+
+		FixedRingBuffer(FixedRingBuffer&& move)
+		: FixedRingBuffer()
+		{
+			takeFrom(move);
+		}
+
+		~FixedRingBuffer()
+		{
+			this->Clear();
+		}
+
+		FixedRingBuffer& operator=(const FixedRingBuffer& copy)
+		{
+			if (this != &copy)
+			{
+				this->Clear();
+				this->copyFrom(copy);
+			}
+
+			return *this;
+		}
+
+		FixedRingBuffer& operator=(FixedRingBuffer&& move)
+		{
+			if (this != &move)
+			{
+				this->Clear();
+				takeFrom(move);
+			}
+
+			return *this;
+		}
+
+		template<typename... Args>
+		bool EmplaceBack(Args&&... args)
+		{
+			if (this->IsFull())
+			{
+				return false;
+			}
+
+			this->constructBack(std::forward<Args>(args)...);
+			return true;
+		}
+
+		template<typename... Args>
+		bool EmplaceFront(Args&&... args)
+		{
+			if (this->IsFull())
+			{
+				return false;
+			}
+
+			this->constructFront(std::forward<Args>(args)...);
+			return true;
+		}
+
+		bool PushBack(ConstReference value)
+		{
+			return EmplaceBack(value);
+		}
+
+		bool PushBack(Value&& value)
+		{
+			return EmplaceBack(std::move(value));
+		}
+
+		// Pushes the items that fit, returns how many were pushed
+		SizeType PushBack(ArrayView<T> view)
+		{
+			const auto count = Algorithm::Min(view.Size(), Capacity - this->_size);
+
+			this->copyBack(ArrayView<T>(view.begin(), count));
+
+			return count;
+		}
+
+		bool PushFront(ConstReference value)
+		{
+			return EmplaceFront(value);
+		}
+
+		bool PushFront(Value&& value)
+		{
+			return EmplaceFront(std::move(value));
+		}
+
+	private:
+		void takeFrom(FixedRingBuffer& move)
+		{
+			const auto size = move._size;
+
+			move.relocateTo(this->_data);
+
+			this->_head = 0;
+			this->_size = size;
+		}
+
+	private:
+		alignas(T) std::uint8_t _storage[sizeof(T) * Capacity];
+	};
+}
\ No newline at end of file
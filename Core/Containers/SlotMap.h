@@ -0,0 +1,323 @@
+#pragma once
+
+#include "Core/CoreDefines.h"
+
+#include "Core/Containers/Array.h"
+#include "Core/Hashing/Hash.h"
+
+#include <type_traits>
+
+namespace Baroque
+{
+	// Index of a slot and generation of the value in it, packed in StorageType. Handles of different Tag can't be mixed.
+	// Generation 0 is never given to a value, the default handle is never valid.
+	template<typename Tag, typename StorageType = std::uint32_t, std::uint32_t IndexBitCount = 20>
+	struct SlotMapHandle
+	{
+		static_assert(std::is_unsigned_v<StorageType>, "The handle storage must be an unsigned integer");
+		static_assert(IndexBitCount > 0 && IndexBitCount < sizeof(StorageType) * 8, "The handle needs index and generation bits");
+
+		using Storage = StorageType;
+
+		static constexpr std::uint32_t GenerationBitCount = sizeof(StorageType) * 8 - IndexBitCount;
+		static constexpr StorageType IndexMask = (StorageType(1) << IndexBitCount) - 1;
+		static constexpr StorageType GenerationMask = StorageType(~StorageType(0)) >> IndexBitCount;
+
+		static constexpr SlotMapHandle Make(StorageType index, StorageType generation)
+		{
+			return SlotMapHandle{ static_cast<StorageType>((generation << IndexBitCount) | index) };
+		}
+
+		constexpr StorageType Index() const
+		{
+			return Value & IndexMask;
+		}
+
+		constexpr StorageType Generation() const
+		{
+			return Value >> IndexBitCount;
+		}
+
+		// The value may have been removed since, see SlotMap::Contains()
+		constexpr bool IsValid() const
+		{
+			return Generation() != 0;
+		}
+
+		StorageType Value = 0;
+	};
+
+	template<typename Tag, typename StorageType, std::uint32_t IndexBitCount>
+	inline constexpr bool operator==(SlotMapHandle<Tag, StorageType, IndexBitCount> left, SlotMapHandle<Tag, StorageType, IndexBitCount> right)
+	{
+		return left.Value == right.Value;
+	}
+
+	template<typename Tag, typename StorageType, std::uint32_t IndexBitCount>
+	inline constexpr bool operator!=(SlotMapHandle<Tag, StorageType, IndexBitCount> left, SlotMapHandle<Tag, StorageType, IndexBitCount> right)
+	{
+		return left.Value != right.Value;
+	}
+
+	template<typename Tag, typename StorageType, std::uint32_t IndexBitCount>
+	struct Hash<SlotMapHandle<Tag, StorageType, IndexBitCount>>
+	{
+		std::uint64_t operator()(SlotMapHandle<Tag, StorageType, IndexBitCount> handle) const
+		{
+			return Hashing::MixHash(handle.Value);
+		}
+	};
+
+	// 1M slots, a slot is retired after 4095 values
+	template<typename Tag>
+	using SlotMapHandle32 = SlotMapHandle<Tag, std::uint32_t, 20>;
+
+	// 4G slots and generations
+	template<typename Tag>
+	using SlotMapHandle64 = SlotMapHandle<Tag, std::uint64_t, 32>;
+
+	// Values packed in an Array, found in O(1) from the handles given when they are added.
+	// Removing a value moves the last one in its place, iteration goes over the values in no given order.
+	// Handles of removed values are detected by the generation of their slot. Freed slots are reused oldest first,
+	// a slot whose generation would wrap around is never used again.
+	template<typename T, typename Handle = SlotMapHandle32<T>, typename Allocator = Memory::DefaultAllocator>
+	class SlotMap
+	{
+	private:
+		using Storage = typename Handle::Storage;
+
+	public:
+		using Value = T;
+		using Pointer = Value*;
+		using ConstPointer = Value const*;
+		using Reference = Value&;
+		using ConstReference = Value const&;
+		using SizeType = std::size_t;
+
+		Handle Add(ConstReference value)
+		{
+			return Emplace(value);
+		}
+
+		Handle Add(Value&& value)
+		{
+			return Emplace(std::move(value));
+		}
+
+		// Returns an invalid handle when all the slots are used
+		template<typename... Args>
+		Handle Emplace(Args&&... args)
+		{
+			const auto slotIndex = acquireSlot();
+
+			if (slotIndex == NoSlot)
+			{
+				return Handle();
+			}
+
+			auto& slot = _slots[slotIndex];
+			slot.ValueIndex = static_cast<Storage>(_values.Size());
+
+			_values.Emplace(std::forward<Args>(args)...);
+			_valueSlots.Add(slotIndex);
+
+			return Handle::Make(slotIndex, slot.Generation);
+		}
+
+		void Clear()
+		{
+			for (auto slotIndex : _valueSlots)
+			{
+				releaseSlot(slotIndex);
+			}
+
+			_values.Clear();
+			_valueSlots.Clear();
+		}
+
+		bool Contains(Handle handle) const
+		{
+			return findSlot(handle) != nullptr;
+		}
+
+		// Values of removed handles are not found
+		Pointer Find(Handle handle)
+		{
+			auto* slot = findSlot(handle);
+
+			return slot ? _values.Data() + slot->ValueIndex : nullptr;
+		}
+
+		ConstPointer Find(Handle handle) const
+		{
+			auto* slot = findSlot(handle);
+
+			return slot ? _values.Data() + slot->ValueIndex : nullptr;
+		}
+
+		// Handle of the value at index in the iteration order
+		Handle GetHandle(SizeType index) const
+		{
+			const auto slotIndex = _valueSlots[index];
+
+			return Handle::Make(slotIndex, _slots[slotIndex].Generation);
+		}
+
+		bool IsEmpty() const
+		{
+			return _values.IsEmpty();
+		}
+
+		bool Remove(Handle handle)
+		{
+			auto* slot = findSlot(handle);
+
+			if (!slot)
+			{
+				return false;
+			}
+
+			const auto valueIndex = slot->ValueIndex;
+			const auto lastValueSlot = _valueSlots.Last();
+
+			_values.RemoveAtSwap(valueIndex);
+			_valueSlots.RemoveAtSwap(valueIndex);
+
+			if (valueIndex != _values.Size())
+			{
+				_slots[lastValueSlot].ValueIndex = valueIndex;
+			}
+
+			releaseSlot(handle.Index());
+
+			return true;
+		}
+
+		void Reserve(SizeType count)
+		{
+			_values.Reserve(count);
+			_valueSlots.Reserve(count);
+			_slots.Reserve(count);
+		}
+
+		SizeType Size() const
+		{
+			return _values.Size();
+		}
+
+		ArrayView<T> ToArrayView() const
+		{
+			return _values.ToArrayView();
+		}
+
+		ArraySpan<T> ToArraySpan()
+		{
+			return _values.ToArraySpan();
+		}
+
+		Pointer begin()
+		{
+			return _values.begin();
+		}
+
+		ConstPointer begin() const
+		{
+			return _values.begin();
+		}
+
+		Pointer end()
+		{
+			return _values.end();
+		}
+
+		ConstPointer end() const
+		{
+			return _values.end();
+		}
+
+	private:
+		static constexpr Storage NoSlot = Storage(~Storage(0));
+
+		struct Slot
+		{
+			// Index in _values, or next free slot
+			Storage ValueIndex;
+			Storage Generation;
+		};
+
+		const Slot* findSlot(Handle handle) const
+		{
+			const auto index = handle.Index();
+
+			if (handle.IsValid() && index < _slots.Size() && _slots[index].Generation == handle.Generation())
+			{
+				return &_slots[index];
+			}
+
+			return nullptr;
+		}
+
+		Slot* findSlot(Handle handle)
+		{
+			return const_cast<Slot*>(static_cast<const SlotMap&>(*this).findSlot(handle));
+		}
+
+		Storage acquireSlot()
+		{
+			if (_freeHead != NoSlot)
+			{
+				const auto slotIndex = _freeHead;
+
+				_freeHead = _slots[slotIndex].ValueIndex;
+
+				if (_freeHead == NoSlot)
+				{
+					_freeTail = NoSlot;
+				}
+
+				return slotIndex;
+			}
+
+			if (_slots.Size() > Handle::IndexMask)
+			{
+				return NoSlot;
+			}
+
+			_slots.Add(Slot{ NoSlot, 1 });
+
+			return static_cast<Storage>(_slots.Size() - 1);
+		}
+
+		void releaseSlot(Storage slotIndex)
+		{
+			auto& slot = _slots[slotIndex];
+
+			slot.Generation = (slot.Generation + 1) & Handle::GenerationMask;
+			slot.ValueIndex = NoSlot;
+
+			if (slot.Generation == 0)
+			{
+				return;
+			}
+
+			if (_freeTail == NoSlot)
+			{
+				_freeHead = slotIndex;
+			}
+			else
+			{
+				_slots[_freeTail].ValueIndex = slotIndex;
+			}
+
+			_freeTail = slotIndex;
+		}
+
+	private:
+		Array<T, Allocator> _values;
+		// Slot of each value
+		Array<Storage, Allocator> _valueSlots;
+		Array<Slot, Allocator> _slots;
+		Storage _freeHead = NoSlot;
+		Storage _freeTail = NoSlot;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,6 @@
+#include "SoAArray.h"
+
+namespace Baroque
+{
+	BAROQUE_REGISTER_MEMORY_CATEGORY(SoAArray)
+}
\ No newline at end of file
@@ -0,0 +1,405 @@
+#pragma once
+
+#include "Core/CoreDefines.h"
+
+#include "Core/Algorithms/MinMax.h"
+#include "Core/Containers/ArrayView.h"
+#include "Core/Containers/ArraySpan.h"
+#include "Core/Containers/ContainerHelpers.h"
+#include "Core/Containers/GrowthPolicy.h"
+#include "Core/Memory/Alignment.h"
+#include "Core/Memory/AllocatorTraits.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Utilities/TypeTraits.h"
+
+#include <cstring>
+#include <tuple>
+#include <utility>
+
+namespace Baroque
+{
+	BAROQUE_EXTERN_MEMORY_CATEGORY(SoAArray)
+
+	// Items of Ts... stored as one column per field, loops touching a few fields only load those.
+	// The columns share a single allocation and each starts on a cache line, so loops over a column can be vectorized.
+	template<typename Allocator, typename GrowthPolicy, typename... Ts>
+	class SoAArrayImplementation : private Allocator
+	{
+		static_assert(sizeof...(Ts) > 0, "A SoAArray needs at least one column");
+
+	public:
+		using SizeType = std::size_t;
+
+		template<SizeType Index>
+		using Column = std::tuple_element_t<Index, std::tuple<Ts...>>;
+
+		static constexpr SizeType ColumnCount = sizeof...(Ts);
+
+		SoAArrayImplementation() = default;
+
+		SoAArrayImplementation(const SoAArrayImplementation& copy)
+		{
+			copyFrom(copy);
+		}
+
+		SoAArrayImplementation(SoAArrayImplementation&& move)
+		{
+			takeFrom(move);
+		}
+
+		~SoAArrayImplementation()
+		{
+			internalDestructor();
+		}
+
+		SoAArrayImplementation& operator=(const SoAArrayImplementation& copy)
+		{
+			if (this != &copy)
+			{
+				Clear();
+				copyFrom(copy);
+			}
+
+			return *this;
+		}
+
+		SoAArrayImplementation& operator=(SoAArrayImplementation&& move)
+		{
+			if (this != &move)
+			{
+				internalDestructor();
+				takeFrom(move);
+			}
+
+			return *this;
+		}
+
+		// Takes one value per column
+		template<typename... Args>
+		void Add(Args&&... values)
+		{
+			static_assert(sizeof...(Args) == ColumnCount, "Add() takes a value for each column");
+
+			ensureCapacity(_size + 1);
+			construct(std::index_sequence_for<Ts...>(), std::forward<Args>(values)...);
+
+			++_size;
+		}
+
+		constexpr SizeType Capacity() const
+		{
+			return _capacity;
+		}
+
+		void Clear()
+		{
+			destroyItems(std::index_sequence_for<Ts...>());
+
+			_size = 0;
+		}
+
+		template<SizeType Index>
+		Column<Index>& Get(SizeType index)
+		{
+			return column<Index>()[index];
+		}
+
+		template<SizeType Index>
+		const Column<Index>& Get(SizeType index) const
+		{
+			return column<Index>()[index];
+		}
+
+		template<SizeType Index>
+		ArraySpan<Column<Index>> GetColumn()
+		{
+			return ArraySpan<Column<Index>>(column<Index>(), _size);
+		}
+
+		template<SizeType Index>
+		ArrayView<Column<Index>> GetColumn() const
+		{
+			return ArrayView<Column<Index>>(column<Index>(), _size);
+		}
+
+		bool IsEmpty() const
+		{
+			return _size == 0;
+		}
+
+		// Moves the last item in place of the removed one, the order is not kept
+		void RemoveAtSwap(SizeType index)
+		{
+			if (index < _size)
+			{
+				--_size;
+
+				removeAtSwap(std::index_sequence_for<Ts...>(), index);
+			}
+		}
+
+		void Reserve(SizeType newCapacity)
+		{
+			if (newCapacity <= _capacity)
+			{
+				return;
+			}
+
+			newCapacity = Algorithm::Max(newCapacity, InitialCapacity);
+
+			void* newColumns[ColumnCount];
+
+			allocateColumns(newColumns, newCapacity);
+			relocateColumns(std::index_sequence_for<Ts...>(), _columns, newColumns, _size);
+
+			deallocateData();
+
+			std::memcpy(_columns, newColumns, sizeof(_columns));
+			_capacity = newCapacity;
+		}
+
+		constexpr SizeType Size() const
+		{
+			return _size;
+		}
+
+		void Swap(SoAArrayImplementation& other)
+		{
+			if (!isInline() && !other.isInline())
+			{
+				std::swap(_columns, other._columns);
+				std::swap(_size, other._size);
+				std::swap(_capacity, other._capacity);
+				return;
+			}
+
+			SoAArrayImplementation temp(std::move(other));
+			other = std::move(*this);
+			*this = std::move(temp);
+		}
+
+	private:
+		static constexpr SizeType ItemSize = (sizeof(Ts) + ...);
+
+		static constexpr SizeType columnAlignment()
+		{
+			SizeType alignment = 64;
+			((alignment = Algorithm::Max<SizeType>(alignment, alignof(Ts))), ...);
+			return alignment;
+		}
+
+		static constexpr SizeType ColumnAlignment = columnAlignment();
+
+		static constexpr SizeType allocationSize(SizeType capacity)
+		{
+			return (Memory::AlignUp(capacity * sizeof(Ts), ColumnAlignment) + ...);
+		}
+
+		// Most items whose padded columns fit in size bytes, a binary search between the capacity that fits
+		// even with the most padding and the one that overflows even without padding
+		static constexpr SizeType capacityForSize(SizeType size)
+		{
+			constexpr SizeType maxPadding = ColumnCount * (ColumnAlignment - 1);
+
+			SizeType low = size > maxPadding ? (size - maxPadding) / ItemSize : 0;
+			SizeType high = size / ItemSize + 1;
+
+			while (high - low > 1)
+			{
+				const SizeType middle = low + (high - low) / 2;
+
+				if (allocationSize(middle) <= size)
+				{
+					low = middle;
+				}
+				else
+				{
+					high = middle;
+				}
+			}
+
+			return low;
+		}
+
+		// Most items that fit in the inline storage of the allocator, the first allocation takes all of it.
+		// A stack allocator only frees its last block, smaller blocks would pile up in it as the array grows.
+		static constexpr SizeType initialCapacity()
+		{
+			constexpr SizeType alignmentPadding = ColumnAlignment - Memory::DefaultAlignment;
+
+			return Allocator::StackCapacity > alignmentPadding ? capacityForSize(Allocator::StackCapacity - alignmentPadding) : 0;
+		}
+
+		static constexpr SizeType InitialCapacity = initialCapacity();
+
+		template<SizeType Index>
+		Column<Index>* column()
+		{
+			return static_cast<Column<Index>*>(_columns[Index]);
+		}
+
+		template<SizeType Index>
+		const Column<Index>* column() const
+		{
+			return static_cast<const Column<Index>*>(_columns[Index]);
+		}
+
+		void allocateColumns(void* (&columns)[ColumnCount], SizeType capacity)
+		{
+			auto* data = static_cast<std::uint8_t*>(BAROQUE_ALLOC_ALIGNED((*this), allocationSize(capacity), ColumnAlignment, SoAArray));
+			SizeType columnIndex = 0;
+
+			((columns[columnIndex++] = data, data += Memory::AlignUp(capacity * sizeof(Ts), ColumnAlignment)), ...);
+		}
+
+		void deallocateData()
+		{
+			if (_columns[0])
+			{
+				Memory::DeallocateSized(static_cast<Allocator&>(*this), _columns[0], allocationSize(_capacity));
+			}
+		}
+
+		void ensureCapacity(SizeType requiredCapacity)
+		{
+			if (requiredCapacity > _capacity)
+			{
+				// The policy counts ItemSize bytes per item, the block also holds the padding of the columns.
+				// The capacity fills the usable size of the padded block so the padding holds items instead of spilling into a larger block.
+				const auto newCapacity = GrowthPolicy::template NextCapacity<Allocator>(_capacity, requiredCapacity, ItemSize);
+
+				Reserve(capacityForSize(Memory::GetAllocationSize<Allocator>(allocationSize(newCapacity))));
+			}
+		}
+
+		template<SizeType... Indices, typename... Args>
+		void construct(std::index_sequence<Indices...>, Args&&... values)
+		{
+			(new (column<Indices>() + _size) Column<Indices>(std::forward<Args>(values)), ...);
+		}
+
+		template<SizeType... Indices>
+		void copyColumns(std::index_sequence<Indices...>, const SoAArrayImplementation& copy)
+		{
+			(copyColumn(copy.column<Indices>(), column<Indices>(), copy._size), ...);
+		}
+
+		template<typename T>
+		static void copyColumn(const T* source, T* destination, SizeType count)
+		{
+			if constexpr (std::is_trivially_copyable_v<T>)
+			{
+				if (count)
+				{
+					std::memcpy(destination, source, sizeof(T) * count);
+				}
+			}
+			else
+			{
+				for (SizeType i = 0; i < count; ++i)
+				{
+					new (destination + i) T(source[i]);
+				}
+			}
+		}
+
+		template<SizeType... Indices>
+		void destroyItems(std::index_sequence<Indices...>)
+		{
+			(destroyColumn(column<Indices>(), 0, _size), ...);
+		}
+
+		template<typename T>
+		static void destroyColumn(T* items, SizeType start, SizeType end)
+		{
+			if constexpr (!std::is_trivially_destructible_v<T>)
+			{
+				for (SizeType i = start; i < end; ++i)
+				{
+					items[i].~T();
+				}
+			}
+			else
+			{
+				BAROQUE_UNUSED(items);
+				BAROQUE_UNUSED(start);
+				BAROQUE_UNUSED(end);
+			}
+		}
+
+		template<SizeType... Indices>
+		void removeAtSwap(std::index_sequence<Indices...>, SizeType index)
+		{
+			(removeAtSwap(column<Indices>(), index), ...);
+		}
+
+		template<typename T>
+		void removeAtSwap(T* items, SizeType index)
+		{
+			destroyColumn(items, index, index + 1);
+
+			if (index != _size)
+			{
+				Detail::RelocateItems(items + _size, items + index, 1);
+			}
+		}
+
+		template<SizeType... Indices>
+		static void relocateColumns(std::index_sequence<Indices...>, void* (&source)[ColumnCount], void* (&destination)[ColumnCount], SizeType count)
+		{
+			(Detail::RelocateItems(static_cast<Column<Indices>*>(source[Indices]), static_cast<Column<Indices>*>(destination[Indices]), count), ...);
+		}
+
+		void copyFrom(const SoAArrayImplementation& copy)
+		{
+			Reserve(copy._size);
+			copyColumns(std::index_sequence_for<Ts...>(), copy);
+
+			_size = copy._size;
+		}
+
+		bool isInline() const
+		{
+			return Detail::IsInline<Allocator>(*this, _columns[0]);
+		}
+
+		// Leaves move empty, with its inline storage when it had items in it
+		void takeFrom(SoAArrayImplementation& move)
+		{
+			if (move.isInline())
+			{
+				Reserve(move._capacity);
+				relocateColumns(std::index_sequence_for<Ts...>(), move._columns, _columns, move._size);
+
+				_size = move._size;
+				move._size = 0;
+				return;
+			}
+
+			std::memcpy(_columns, move._columns, sizeof(_columns));
+			_size = move._size;
+			_capacity = move._capacity;
+
+			std::memset(move._columns, 0, sizeof(move._columns));
+			move._size = 0;
+			move._capacity = 0;
+		}
+
+		void internalDestructor()
+		{
+			Clear();
+			deallocateData();
+
+			std::memset(_columns, 0, sizeof(_columns));
+			_capacity = 0;
+		}
+
+	private:
+		void* _columns[ColumnCount] = {};
+		SizeType _size = 0;
+		SizeType _capacity = 0;
+	};
+
+	template<typename... Ts>
+	using SoAArray = SoAArrayImplementation<Baroque::Memory::DefaultAllocator, DefaultGrowthPolicy, Ts...>;
+}
\ No newline at end of file
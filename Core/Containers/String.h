@@ -1164,8 +1164,8 @@ namespace Baroque
 			return result;
 		}
 
-		template<typename Allocator>
-		constexpr void Split(Value value, ArrayImplementation<StringView, Allocator>& outResult) const
+		template<typename Allocator, typename GrowthPolicy>
+		constexpr void Split(Value value, ArrayImplementation<StringView, Allocator, GrowthPolicy>& outResult) const
 		{
 			outResult.Clear();
 
@@ -1197,8 +1197,8 @@ namespace Baroque
 			return result;
 		}
 
-		template<typename Allocator>
-		constexpr void Split(Unicode::Codepoint codepoint, ArrayImplementation<StringView, Allocator>& outResult) const
+		template<typename Allocator, typename GrowthPolicy>
+		constexpr void Split(Unicode::Codepoint codepoint, ArrayImplementation<StringView, Allocator, GrowthPolicy>& outResult) const
 		{
 			outResult.Clear();
 
@@ -1486,7 +1486,7 @@ namespace Baroque
 		{
 			if (isHeap() && Heap.Data)
 			{
-				allocator().Deallocate(Heap.Data);
+				Memory::DeallocateSized(allocator(), Heap.Data, Capacity() + 1);
 			}
 		}
 
@@ -1554,6 +1554,22 @@ namespace Baroque
 		{
 			auto* oldData = Data();
 
+			if constexpr (Memory::CanReallocate_v<Allocator>)
+			{
+				if (oldData && oldData != Short.Data && newCapacity > Capacity())
+				{
+					if (auto* newData = static_cast<Pointer>(BAROQUE_REALLOC(allocator(), oldData, Capacity() + 1, newCapacity + 1, String)))
+					{
+						std::memset(newData + Size(), 0, newCapacity + 1 - Size());
+
+						setCapacity(newCapacity);
+
+						Heap.Data = newData;
+						return;
+					}
+				}
+			}
+
 			auto* newData = allocate(newCapacity + 1);
 			std::memset(newData, 0, newCapacity + 1);
 
@@ -1563,7 +1579,7 @@ namespace Baroque
 
 				if (oldData != Short.Data)
 				{
-					allocator().Deallocate(oldData);
+					Memory::DeallocateSized(allocator(), oldData, Capacity() + 1);
 				}
 			}
 
@@ -1679,6 +1695,12 @@ namespace Baroque
 	template<std::size_t Size>
 	using SmallString = StringImplementation<Baroque::Memory::SmallAllocator<Size>>;
 
+	// Hashes the characters like a StringView, hash containers with String keys can be searched with StringView
+	template<typename Allocator>
+	struct Hash<StringImplementation<Allocator>> : Hash<StringView>
+	{
+	};
+
 	namespace Literals
 	{
 		inline String operator""_s(const char* value, std::size_t size)
@@ -4,6 +4,7 @@
 
 #include "Core/Algorithms/MinMax.h"
 #include "Core/Containers/StringSpan.h"
+#include "Core/Hashing/Hash.h"
 #include "Core/Memory/Memory.h"
 #include "Core/Unicode/Codepoint.h"
 #include "Core/Unicode/StringFunctions.h"
@@ -716,4 +717,13 @@ namespace Baroque
 
 		return std::strncmp(left.Data(), right.Data(), maxSize) >= 0;
 	}
+
+	template<>
+	struct Hash<StringView>
+	{
+		std::uint64_t operator()(StringView value) const
+		{
+			return Hashing::HashBytes(value.Data(), value.Size());
+		}
+	};
 }
\ No newline at end of file
@@ -0,0 +1,48 @@
+#include "Hash.h"
+
+namespace Baroque
+{
+	namespace Hashing
+	{
+		namespace
+		{
+			constexpr std::uint64_t Multiplier1 = 0x9E3779B97F4A7C15ull;
+			constexpr std::uint64_t Multiplier2 = 0x87C37B91114253D5ull;
+
+			std::uint64_t rotateLeft(std::uint64_t value, int bits)
+			{
+				return (value << bits) | (value >> (64 - bits));
+			}
+
+			std::uint64_t mixWord(std::uint64_t hash, std::uint64_t word)
+			{
+				return rotateLeft(hash ^ (word * Multiplier1), 31) * Multiplier2;
+			}
+		}
+
+		std::uint64_t HashBytes(const void* data, std::size_t size, std::uint64_t seed)
+		{
+			const auto* bytes = static_cast<const std::uint8_t*>(data);
+
+			std::uint64_t hash = seed ^ (size * Multiplier2);
+
+			for (; size >= 8; size -= 8, bytes += 8)
+			{
+				std::uint64_t word;
+				std::memcpy(&word, bytes, sizeof(word));
+
+				hash = mixWord(hash, word);
+			}
+
+			if (size > 0)
+			{
+				std::uint64_t word = 0;
+				std::memcpy(&word, bytes, size);
+
+				hash = mixWord(hash, word);
+			}
+
+			return MixHash(hash);
+		}
+	}
+}
\ No newline at end of file
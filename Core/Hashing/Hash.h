@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Core/CoreDefines.h"
+
+#include "Core/Hashing/PointerHash.h"
+
+#include <cstring>
+#include <type_traits>
+
+namespace Baroque
+{
+	namespace Hashing
+	{
+		// Hash of size bytes, every bit of the input changes about half the bits of the result
+		BAROQUE_CORE_API std::uint64_t HashBytes(const void* data, std::size_t size, std::uint64_t seed = 0);
+
+		// Spreads every bit of value over the whole result, for keys whose low bits are not random
+		constexpr std::uint64_t MixHash(std::uint64_t value)
+		{
+			value ^= value >> 33;
+			value *= 0xFF51AFD7ED558CCDull;
+			value ^= value >> 33;
+			value *= 0xC4CEB9FE1A85EC53ull;
+			value ^= value >> 33;
+
+			return value;
+		}
+	}
+
+	// Hash function object of the hash containers, to specialize for other key types.
+	// Lookups can use any type the operator() accepts and that compares equal to the keys.
+	template<typename T, typename = void>
+	struct Hash;
+
+	template<typename T>
+	struct Hash<T, std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>>>
+	{
+		std::uint64_t operator()(T value) const
+		{
+			return Hashing::MixHash(static_cast<std::uint64_t>(value));
+		}
+	};
+
+	template<typename T>
+	struct Hash<T, std::enable_if_t<std::is_floating_point_v<T>>>
+	{
+		std::uint64_t operator()(T value) const
+		{
+			// -0.0 and 0.0 are equal
+			if (value == T(0))
+			{
+				return Hashing::MixHash(0);
+			}
+
+			return Hashing::HashBytes(&value, sizeof(value));
+		}
+	};
+
+	template<typename T>
+	struct Hash<T*>
+	{
+		std::uint64_t operator()(const T* value) const
+		{
+			return Hashing::PointerHash(value);
+		}
+	};
+}
\ No newline at end of file
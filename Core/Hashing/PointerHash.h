@@ -6,6 +6,6 @@ namespace Baroque
 {
 	namespace Hashing
 	{
-		std::uint64_t PointerHash(const void* ptr);
+		BAROQUE_CORE_API std::uint64_t PointerHash(const void* ptr);
 	}
 }
\ No newline at end of file
@@ -0,0 +1,32 @@
+#include "AffixAllocator.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+
+namespace Baroque
+{
+	namespace Memory
+	{
+		namespace
+		{
+			void abortOnGuardBandViolation(const void* allocation, std::size_t size)
+			{
+				std::fprintf(stderr, "Guard band overwritten around allocation %p of %zu bytes\n", allocation, size);
+				std::abort();
+			}
+
+			std::atomic<GuardBandViolationCallback> GuardBandViolation{ &abortOnGuardBandViolation };
+		}
+
+		void SetGuardBandViolationCallback(GuardBandViolationCallback callback)
+		{
+			GuardBandViolation.store(callback ? callback : &abortOnGuardBandViolation, std::memory_order_relaxed);
+		}
+
+		void ReportGuardBandViolation(const void* allocation, std::size_t size)
+		{
+			GuardBandViolation.load(std::memory_order_relaxed)(allocation, size);
+		}
+	}
+}
\ No newline at end of file
@@ -2,35 +2,370 @@
 
 #include "Core/CoreDefines.h"
 
+#include "Core/Algorithms/MinMax.h"
+#include "Core/Memory/Alignment.h"
+#include "Core/Memory/AllocatorTraits.h"
+
+#include <cstring>
+#include <limits>
+#include <new>
+#include <type_traits>
+
 namespace Baroque
 {
 	namespace Memory
 	{
+		using GuardBandViolationCallback = void(*)(const void* allocation, std::size_t size);
+
+		// The default callback prints the allocation and aborts
+		BAROQUE_CORE_API void SetGuardBandViolationCallback(GuardBandViolationCallback callback);
+		BAROQUE_CORE_API void ReportGuardBandViolation(const void* allocation, std::size_t size);
+
+		// Prefix that keeps the requested size of the block
+		struct SizePrefix
+		{
+			void OnAllocate(std::size_t size)
+			{
+				Size = size;
+			}
+
+			std::size_t Size;
+		};
+
+		// Canary bytes checked when the block is freed
+		template<std::size_t ByteCount = 16>
+		struct GuardBand
+		{
+			static constexpr std::uint8_t Pattern = 0xFD;
+
+			void OnAllocate(std::size_t)
+			{
+				std::memset(Bytes, Pattern, ByteCount);
+			}
+
+			bool IsIntact() const
+			{
+				for (auto byte : Bytes)
+				{
+					if (byte != Pattern)
+					{
+						return false;
+					}
+				}
+
+				return true;
+			}
+
+			std::uint8_t Bytes[ByteCount];
+		};
+
+		// Size followed by a guard band that ends right before the block
+		template<std::size_t ByteCount = 16>
+		struct GuardedSizePrefix
+		{
+			void OnAllocate(std::size_t size)
+			{
+				Size = size;
+				Guard.OnAllocate(size);
+			}
+
+			bool IsIntact() const
+			{
+				return Guard.IsIntact();
+			}
+
+			std::size_t Size;
+			GuardBand<ByteCount> Guard;
+		};
+
+		namespace Detail
+		{
+			template<typename Affix, typename = void>
+			struct HasAffixSize : std::false_type
+			{
+			};
+
+			template<typename Affix>
+			struct HasAffixSize<Affix, std::void_t<decltype(std::declval<Affix&>().Size)>> : std::true_type
+			{
+			};
+
+			template<typename Affix, typename = void>
+			struct HasAffixOnAllocate : std::false_type
+			{
+			};
+
+			template<typename Affix>
+			struct HasAffixOnAllocate<Affix, std::void_t<decltype(std::declval<Affix&>().OnAllocate(std::size_t()))>> : std::true_type
+			{
+			};
+
+			template<typename Affix, typename = void>
+			struct HasAffixCheck : std::false_type
+			{
+			};
+
+			template<typename Affix>
+			struct HasAffixCheck<Affix, std::void_t<decltype(std::declval<const Affix&>().IsIntact())>> : std::true_type
+			{
+			};
+
+			template<typename Affix>
+			constexpr std::size_t AffixSize()
+			{
+				if constexpr (std::is_void_v<Affix>)
+				{
+					return 0;
+				}
+				else
+				{
+					return sizeof(Affix);
+				}
+			}
+
+			template<typename Affix>
+			constexpr std::size_t AffixAlignment()
+			{
+				if constexpr (std::is_void_v<Affix>)
+				{
+					return 1;
+				}
+				else
+				{
+					return alignof(Affix);
+				}
+			}
+		}
+
+		// Puts a Prefix object right before every block and a Suffix object right after it. Affix types
+		// are trivially destructible, their OnAllocate(size) is called on allocation and IsIntact() is
+		// checked on deallocation when they have them. A Suffix needs a Prefix with a Size member to be found.
+		// Blocks keep the alignment of the Allocator up to DefaultAlignment, higher alignments are
+		// supported when they divide the space reserved for the prefix.
 		template<typename Allocator, typename Prefix, typename Suffix = void>
-		class AffixAllocator : private Allocator, private Prefix, private Suffix
+		class AffixAllocator : private Allocator
 		{
 		public:
-			static constexpr std::size_t StackCapacity = Allocator::StackCapacity;
+			static_assert(std::is_void_v<Prefix> || std::is_trivially_destructible_v<Prefix>, "Prefix must be trivially destructible");
+			static_assert(std::is_void_v<Suffix> || std::is_trivially_destructible_v<Suffix>, "Suffix must be trivially destructible");
+			static_assert(std::is_void_v<Suffix> || Detail::HasAffixSize<Prefix>::value, "The Prefix must keep the size to find the Suffix");
+			static_assert(Detail::AffixAlignment<Prefix>() <= DefaultAlignment && Detail::AffixAlignment<Suffix>() <= DefaultAlignment, "Affixes can't be over-aligned");
+			static_assert(!HasFixedEntrySize_v<Allocator>, "The affixes would overflow the fixed size entries of Allocator");
+
+			static constexpr std::size_t PrefixSize = AlignUp(Detail::AffixSize<Prefix>(), DefaultAlignment);
+			static constexpr std::size_t SuffixSize = Detail::AffixSize<Suffix>();
+			// Worst case padding of the suffix included
+			static constexpr std::size_t Overhead = PrefixSize + SuffixSize + Detail::AffixAlignment<Suffix>() - 1;
+			static constexpr std::size_t StackCapacity = Allocator::StackCapacity > Overhead ? Allocator::StackCapacity - Overhead : 0;
 
 			void* Allocate(const std::size_t size)
 			{
-				Prefix::Allocate(size);
-				void* result = Allocator::Allocate(size);
-				Suffix::Alocate(size);
-				return result;
+				if (size > std::numeric_limits<std::size_t>::max() - Overhead)
+				{
+					return nullptr;
+				}
+
+				return finishAllocation(Allocator::Allocate(totalSize(size)), size);
+			}
+
+			void* Allocate(const std::size_t size, const std::size_t alignment)
+			{
+				if (alignment <= DefaultAlignment)
+				{
+					return Allocate(size);
+				}
+
+				if (PrefixSize % alignment != 0 || size > std::numeric_limits<std::size_t>::max() - Overhead)
+				{
+					return nullptr;
+				}
+
+				return finishAllocation(Allocator::Allocate(totalSize(size), alignment), size);
 			}
 
 			void Deallocate(void* ptr)
 			{
-				Prefix::Deallocate(ptr);
-				Allocator::Deallocate(ptr);
-				Suffix::Deallocate(ptr);
+				if (!ptr)
+				{
+					return;
+				}
+
+				checkGuards(ptr);
+
+				if constexpr (Detail::HasAffixSize<Prefix>::value)
+				{
+					DeallocateSized(static_cast<Allocator&>(*this), static_cast<std::uint8_t*>(ptr) - PrefixSize, totalSize(GetSize(ptr)));
+				}
+				else
+				{
+					Allocator::Deallocate(static_cast<std::uint8_t*>(ptr) - PrefixSize);
+				}
+			}
+
+			void Deallocate(void* ptr, const std::size_t size)
+			{
+				if (!ptr)
+				{
+					return;
+				}
+
+				checkGuards(ptr);
+
+				DeallocateSized(static_cast<Allocator&>(*this), static_cast<std::uint8_t*>(ptr) - PrefixSize, totalSize(requestedSize(ptr, size)));
+			}
+
+			// The affixes are written again around the resized block
+			void* Reallocate(void* ptr, const std::size_t oldSize, const std::size_t newSize)
+			{
+				if constexpr (CanReallocate_v<Allocator>)
+				{
+					if (!ptr || newSize > std::numeric_limits<std::size_t>::max() - Overhead)
+					{
+						return nullptr;
+					}
+
+					checkGuards(ptr);
+
+					const auto previousSize = requestedSize(ptr, oldSize);
+
+					auto* block = static_cast<std::uint8_t*>(Allocator::Reallocate(static_cast<std::uint8_t*>(ptr) - PrefixSize, totalSize(previousSize), totalSize(newSize)));
+					if (!block)
+					{
+						return nullptr;
+					}
+
+					return finishAllocation(block, newSize);
+				}
+				else
+				{
+					BAROQUE_UNUSED(ptr);
+					BAROQUE_UNUSED(oldSize);
+					BAROQUE_UNUSED(newSize);
+					return nullptr;
+				}
 			}
 
-			bool Owns(void* ptr) const
+			bool Owns(const void* ptr) const
 			{
 				return Allocator::Owns(ptr);
 			}
+
+			template<typename P = Prefix, typename = std::enable_if_t<!std::is_void_v<P>>>
+			static P& GetPrefix(void* ptr)
+			{
+				return *reinterpret_cast<P*>(static_cast<std::uint8_t*>(ptr) - sizeof(P));
+			}
+
+			template<typename P = Prefix, typename = std::enable_if_t<!std::is_void_v<P>>>
+			static const P& GetPrefix(const void* ptr)
+			{
+				return *reinterpret_cast<const P*>(static_cast<const std::uint8_t*>(ptr) - sizeof(P));
+			}
+
+			template<typename S = Suffix, typename = std::enable_if_t<!std::is_void_v<S>>>
+			static S& GetSuffix(void* ptr)
+			{
+				return *reinterpret_cast<S*>(suffixAddress(ptr, GetPrefix(ptr).Size));
+			}
+
+			// Requested size of the block, read from the prefix without any lookup
+			template<typename P = Prefix, typename = std::enable_if_t<Detail::HasAffixSize<P>::value>>
+			static std::size_t GetSize(const void* ptr)
+			{
+				return GetPrefix(ptr).Size;
+			}
+
+		private:
+			static constexpr std::size_t totalSize(std::size_t size)
+			{
+				return PrefixSize + AlignUp(size, Detail::AffixAlignment<Suffix>()) + SuffixSize;
+			}
+
+			static std::uint8_t* suffixAddress(void* ptr, std::size_t size)
+			{
+				return static_cast<std::uint8_t*>(ptr) + AlignUp(size, Detail::AffixAlignment<Suffix>());
+			}
+
+			static std::size_t requestedSize(const void* ptr, std::size_t fallbackSize)
+			{
+				if constexpr (Detail::HasAffixSize<Prefix>::value)
+				{
+					BAROQUE_UNUSED(fallbackSize);
+					return GetPrefix(ptr).Size;
+				}
+				else
+				{
+					BAROQUE_UNUSED(ptr);
+					return fallbackSize;
+				}
+			}
+
+			static void* finishAllocation(void* block, std::size_t size)
+			{
+				if (!block)
+				{
+					return nullptr;
+				}
+
+				auto* ptr = static_cast<std::uint8_t*>(block) + PrefixSize;
+
+				if constexpr (!std::is_void_v<Prefix>)
+				{
+					auto* prefix = new (ptr - sizeof(Prefix)) Prefix;
+					onAllocate(*prefix, size);
+				}
+
+				if constexpr (!std::is_void_v<Suffix>)
+				{
+					auto* suffix = new (suffixAddress(ptr, size)) Suffix;
+					onAllocate(*suffix, size);
+				}
+
+				return ptr;
+			}
+
+			template<typename Affix>
+			static void onAllocate(Affix& affix, std::size_t size)
+			{
+				if constexpr (Detail::HasAffixOnAllocate<Affix>::value)
+				{
+					affix.OnAllocate(size);
+				}
+				else
+				{
+					BAROQUE_UNUSED(affix);
+					BAROQUE_UNUSED(size);
+				}
+			}
+
+			static void checkGuards(void* ptr)
+			{
+				bool isIntact = true;
+
+				if constexpr (Detail::HasAffixCheck<Prefix>::value)
+				{
+					isIntact = GetPrefix(ptr).IsIntact();
+				}
+
+				if constexpr (Detail::HasAffixCheck<Suffix>::value)
+				{
+					isIntact = isIntact && GetSuffix(ptr).IsIntact();
+				}
+
+				if (!isIntact)
+				{
+					ReportGuardBandViolation(ptr, requestedSize(ptr, 0));
+				}
+			}
+		};
+
+		template<typename Allocator, typename Prefix, typename Suffix>
+		struct CanReallocate<AffixAllocator<Allocator, Prefix, Suffix>> : CanReallocate<Allocator>
+		{
 		};
+
+		// Guard bands on both sides of every block, checked when the block is freed
+		template<typename Allocator, std::size_t GuardSize = 16>
+		using GuardBandAllocator = AffixAllocator<Allocator, GuardedSizePrefix<GuardSize>, GuardBand<GuardSize>>;
 	}
 }
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Core/CoreDefines.h"
+
+#include <cstddef>
+
+namespace Baroque
+{
+	namespace Memory
+	{
+		// Alignment of the allocations done without an explicit alignment, the same guarantee as malloc.
+		// Allocate(size, alignment) overloads take a power of two alignment.
+		constexpr std::size_t DefaultAlignment = alignof(std::max_align_t);
+
+		constexpr bool IsPowerOfTwo(std::size_t value)
+		{
+			return value && (value & (value - 1)) == 0;
+		}
+
+		// Smallest power of two greater than or equal to value, 1 for 0.
+		// 0 for the values over the highest power of two of std::size_t, which have none.
+		constexpr std::size_t NextPowerOfTwo(std::size_t value)
+		{
+			// Copies the highest set bit of value - 1 into all the lower bits, the values that have no
+			// power of two become all ones and wrap to 0
+			std::size_t result = value ? value - 1 : 0;
+
+			for (std::size_t shift = 1; shift < sizeof(std::size_t) * 8; shift <<= 1)
+			{
+				result |= result >> shift;
+			}
+
+			return result + 1;
+		}
+
+		constexpr std::size_t AlignUp(std::size_t value, std::size_t alignment)
+		{
+			return (value + alignment - 1) & ~(alignment - 1);
+		}
+
+		// Largest alignment, up to DefaultAlignment, that all the elements of an array of elementSize bytes can have
+		constexpr std::size_t MaxElementAlignment(std::size_t elementSize)
+		{
+			const auto lowestBit = elementSize & (~elementSize + 1);
+			return lowestBit && lowestBit < DefaultAlignment ? lowestBit : DefaultAlignment;
+		}
+
+		template<typename T>
+		inline T* AlignUp(T* ptr, std::size_t alignment)
+		{
+			return reinterpret_cast<T*>(AlignUp(static_cast<std::size_t>(reinterpret_cast<std::uintptr_t>(ptr)), alignment));
+		}
+
+		template<typename T>
+		inline T* AlignDown(T* ptr, std::size_t alignment)
+		{
+			return reinterpret_cast<T*>(reinterpret_cast<std::uintptr_t>(ptr) & ~(static_cast<std::uintptr_t>(alignment) - 1));
+		}
+
+		inline bool IsAligned(const void* ptr, std::size_t alignment)
+		{
+			return (reinterpret_cast<std::uintptr_t>(ptr) & (alignment - 1)) == 0;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "Core/CoreDefines.h"
+
+#include <type_traits>
+#include <utility>
+
+namespace Baroque
+{
+	namespace Memory
+	{
+		// Allocators can optionally provide void* Reallocate(void* ptr, std::size_t oldSize, std::size_t newSize).
+		// It returns the block resized in place or moved with its content, or nullptr when it can't do better
+		// than Allocate, copy and Deallocate; ptr is still valid in that case.
+		template<typename Allocator, typename = void>
+		struct CanReallocate : std::false_type
+		{
+		};
+
+		template<typename Allocator>
+		struct CanReallocate<Allocator, std::void_t<decltype(std::declval<Allocator&>().Reallocate(std::declval<void*>(), std::size_t(), std::size_t()))>> : std::true_type
+		{
+		};
+
+		template<typename Allocator>
+		inline constexpr bool CanReallocate_v = CanReallocate<Allocator>::value;
+
+		// Allocators can optionally provide void Deallocate(void* ptr, std::size_t size), size being the size given to
+		// Allocate or to the last Reallocate of the block. Composite allocators route the block with it instead of Owns().
+		template<typename Allocator, typename = void>
+		struct CanDeallocateSized : std::false_type
+		{
+		};
+
+		template<typename Allocator>
+		struct CanDeallocateSized<Allocator, std::void_t<decltype(std::declval<Allocator&>().Deallocate(std::declval<void*>(), std::size_t()))>> : std::true_type
+		{
+		};
+
+		template<typename Allocator>
+		inline constexpr bool CanDeallocateSized_v = CanDeallocateSized<Allocator>::value;
+
+		// Allocators giving blocks of a single size can optionally provide void* FindBlock(const void* ptr) const, the start
+		// of their block holding ptr. PoolAllocator finds the block of a freed entry with it instead of searching its blocks.
+		template<typename Allocator, typename = void>
+		struct CanFindBlock : std::false_type
+		{
+		};
+
+		template<typename Allocator>
+		struct CanFindBlock<Allocator, std::void_t<decltype(std::declval<const Allocator&>().FindBlock(std::declval<const void*>()))>> : std::true_type
+		{
+		};
+
+		template<typename Allocator>
+		inline constexpr bool CanFindBlock_v = CanFindBlock<Allocator>::value;
+
+		// Allocators serving entries of a fixed size whatever the requested size, like the pools, specialize it.
+		// Wrappers adding bytes around the requested size can't be put on top of them.
+		template<typename Allocator>
+		struct HasFixedEntrySize : std::false_type
+		{
+		};
+
+		template<typename Allocator>
+		inline constexpr bool HasFixedEntrySize_v = HasFixedEntrySize<Allocator>::value;
+
+		// Allocators can optionally provide static std::size_t GetAllocationSize(std::size_t size), the usable size of
+		// the block they give for size bytes. Containers grow to it so no byte of their blocks is wasted.
+		template<typename Allocator, typename = void>
+		struct HasAllocationSize : std::false_type
+		{
+		};
+
+		template<typename Allocator>
+		struct HasAllocationSize<Allocator, std::void_t<decltype(Allocator::GetAllocationSize(std::size_t()))>> : std::true_type
+		{
+		};
+
+		template<typename Allocator>
+		std::size_t GetAllocationSize(const std::size_t size)
+		{
+			if constexpr (HasAllocationSize<Allocator>::value)
+			{
+				return Allocator::GetAllocationSize(size);
+			}
+			else
+			{
+				return size;
+			}
+		}
+
+		// Gives the size to the allocators that take it, the pointer type is kept for object allocators
+		template<typename Allocator, typename T>
+		void DeallocateSized(Allocator& allocator, T* ptr, const std::size_t size)
+		{
+			if constexpr (CanDeallocateSized_v<Allocator>)
+			{
+				allocator.Deallocate(ptr, size);
+			}
+			else
+			{
+				BAROQUE_UNUSED(size);
+				allocator.Deallocate(ptr);
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,6 @@
+#include "ArenaAllocator.h"
+
+namespace Baroque
+{
+	BAROQUE_REGISTER_MEMORY_CATEGORY(Arena)
+}
\ No newline at end of file
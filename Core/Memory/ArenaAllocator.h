@@ -0,0 +1,323 @@
+#pragma once
+
+#include "Core/CoreDefines.h"
+
+#include "Core/Algorithms/MinMax.h"
+#include "Core/Memory/Alignment.h"
+#include "Core/Memory/Memory.h"
+
+#include <cstddef>
+#include <limits>
+
+namespace Baroque
+{
+	BAROQUE_EXTERN_MEMORY_CATEGORY(Arena)
+
+	namespace Memory
+	{
+		struct ArenaPage;
+
+		// Position in an arena returned by GetMarker(), everything allocated after it is freed by Rewind()
+		struct ArenaMarker
+		{
+			ArenaPage* Page;
+			std::uint8_t* Top;
+		};
+
+		struct ArenaPage
+		{
+			ArenaPage* Next;
+			std::uint8_t* End;
+		};
+
+		// Bump allocator on pages chained from a BackendAllocator. Individual deallocations are ignored,
+		// except for the last allocation which is rolled back. Reset() and Rewind() free everything allocated
+		// since the start or a marker in O(1), the pages are kept and reused until the arena is destroyed.
+		// Use ScopedArenaAllocator to give an arena to containers.
+		template<typename BackendAllocator = Memory::DefaultAllocator, std::size_t PageSize = 64 * 1024>
+		class ArenaAllocator : private BackendAllocator
+		{
+		public:
+			static_assert(PageSize > sizeof(ArenaPage), "Page size must be greater than the page header");
+
+			static constexpr std::size_t StackCapacity = 0;
+
+			ArenaAllocator() = default;
+			ArenaAllocator(const ArenaAllocator&) = delete;
+			ArenaAllocator& operator=(const ArenaAllocator&) = delete;
+
+			~ArenaAllocator()
+			{
+				auto* page = _firstPage;
+
+				while (page)
+				{
+					auto* next = page->Next;
+
+					BackendAllocator::Deallocate(page);
+
+					page = next;
+				}
+			}
+
+			void* Allocate(const std::size_t size, const std::size_t alignment = DefaultAlignment)
+			{
+				if (_currentPage)
+				{
+					auto* allocation = AlignUp(_top, alignment);
+
+					if (allocation <= _currentPage->End && size <= static_cast<std::size_t>(_currentPage->End - allocation))
+					{
+						_top = allocation + size;
+						_last = allocation;
+						return allocation;
+					}
+				}
+
+				return allocateFromNextPage(size, alignment);
+			}
+
+			void Deallocate(void* ptr)
+			{
+				if (ptr && ptr == _last)
+				{
+					_top = _last;
+					_last = nullptr;
+				}
+			}
+
+			// Only the last allocation can grow or shrink, in place in the current page
+			void* Reallocate(void* ptr, const std::size_t oldSize, const std::size_t newSize)
+			{
+				BAROQUE_UNUSED(oldSize);
+
+				if (!ptr || ptr != _last || newSize > static_cast<std::size_t>(_currentPage->End - _last))
+				{
+					return nullptr;
+				}
+
+				_top = _last + newSize;
+				return ptr;
+			}
+
+			bool Owns(const void* ptr) const
+			{
+				for (auto* page = _firstPage; page; page = page->Next)
+				{
+					if (ptr >= pageStart(page) && ptr < page->End)
+					{
+						return page != _currentPage || ptr < _top;
+					}
+
+					if (page == _currentPage)
+					{
+						break;
+					}
+				}
+
+				return false;
+			}
+
+			// Frees every allocation, the pages are kept for the next allocations
+			void Reset()
+			{
+				_currentPage = _firstPage;
+				_top = _firstPage ? pageStart(_firstPage) : nullptr;
+				_last = nullptr;
+			}
+
+			ArenaMarker GetMarker() const
+			{
+				return ArenaMarker{ _currentPage, _top };
+			}
+
+			// Frees every allocation done after marker was taken
+			void Rewind(const ArenaMarker& marker)
+			{
+				if (!marker.Page)
+				{
+					Reset();
+					return;
+				}
+
+				_currentPage = marker.Page;
+				_top = marker.Top;
+				_last = nullptr;
+			}
+
+			// Bytes reserved from the BackendAllocator
+			std::size_t GetReservedBytes() const
+			{
+				std::size_t reservedBytes = 0;
+
+				for (auto* page = _firstPage; page; page = page->Next)
+				{
+					reservedBytes += static_cast<std::size_t>(page->End - reinterpret_cast<const std::uint8_t*>(page));
+				}
+
+				return reservedBytes;
+			}
+
+		private:
+			BackendAllocator& backend()
+			{
+				return *this;
+			}
+
+			static std::uint8_t* pageStart(ArenaPage* page)
+			{
+				return reinterpret_cast<std::uint8_t*>(page + 1);
+			}
+
+			static const std::uint8_t* pageStart(const ArenaPage* page)
+			{
+				return reinterpret_cast<const std::uint8_t*>(page + 1);
+			}
+
+			static bool fits(ArenaPage* page, std::size_t size, std::size_t alignment)
+			{
+				auto* allocation = AlignUp(pageStart(page), alignment);
+				return allocation <= page->End && size <= static_cast<std::size_t>(page->End - allocation);
+			}
+
+			void* allocateFromNextPage(std::size_t size, std::size_t alignment)
+			{
+				// Pages after the current one are free after a Reset() or a Rewind()
+				auto* next = _currentPage ? _currentPage->Next : _firstPage;
+
+				if (!next || !fits(next, size, alignment))
+				{
+					const auto maximumPadding = alignment - 1;
+
+					if (size > std::numeric_limits<std::size_t>::max() - sizeof(ArenaPage) - maximumPadding)
+					{
+						return nullptr;
+					}
+
+					const auto pageSize = Algorithm::Max(PageSize, sizeof(ArenaPage) + maximumPadding + size);
+
+					auto* page = static_cast<ArenaPage*>(BAROQUE_ALLOC(backend(), pageSize, Arena));
+					if (!page)
+					{
+						return nullptr;
+					}
+
+					page->End = reinterpret_cast<std::uint8_t*>(page) + pageSize;
+
+					// A new page goes before the free page that was too small, it stays available for later
+					page->Next = next;
+
+					if (_currentPage)
+					{
+						_currentPage->Next = page;
+					}
+					else
+					{
+						_firstPage = page;
+					}
+
+					next = page;
+				}
+
+				_currentPage = next;
+				_top = pageStart(next);
+
+				return Allocate(size, alignment);
+			}
+
+		private:
+			ArenaPage* _firstPage = nullptr;
+			ArenaPage* _currentPage = nullptr;
+			std::uint8_t* _top = nullptr;
+			std::uint8_t* _last = nullptr;
+		};
+
+		// Stateless allocator for containers, allocates from the arena of the innermost ArenaScope of the thread.
+		// The arena pages are traced by the arena BackendAllocator, the allocations themselves are not traced.
+		template<typename Arena = ArenaAllocator<>>
+		class ScopedArenaAllocator
+		{
+		public:
+			static constexpr std::size_t StackCapacity = 0;
+
+			void* Allocate(const std::size_t size)
+			{
+				auto* arena = Current();
+				return arena ? arena->Allocate(size) : nullptr;
+			}
+
+			void* Allocate(const std::size_t size, const std::size_t alignment)
+			{
+				auto* arena = Current();
+				return arena ? arena->Allocate(size, alignment) : nullptr;
+			}
+
+			void* Reallocate(void* ptr, const std::size_t oldSize, const std::size_t newSize)
+			{
+				auto* arena = Current();
+				return arena ? arena->Reallocate(ptr, oldSize, newSize) : nullptr;
+			}
+
+#if defined(BAROQUE_TRACING_ALLOCATOR)
+			void* Allocate(const std::size_t size, const TraceMemoryCategory&, const Baroque::SourceLocation&)
+			{
+				return Allocate(size);
+			}
+
+			void* Allocate(const std::size_t size, const std::size_t alignment, const TraceMemoryCategory&, const Baroque::SourceLocation&)
+			{
+				return Allocate(size, alignment);
+			}
+
+			void* Reallocate(void* ptr, const std::size_t oldSize, const std::size_t newSize, const TraceMemoryCategory&, const Baroque::SourceLocation&)
+			{
+				return Reallocate(ptr, oldSize, newSize);
+			}
+#endif
+
+			void Deallocate(void* ptr)
+			{
+				if (auto* arena = Current())
+				{
+					arena->Deallocate(ptr);
+				}
+			}
+
+			bool Owns(const void* ptr) const
+			{
+				auto* arena = Current();
+				return arena && arena->Owns(ptr);
+			}
+
+			static Arena*& Current()
+			{
+				static thread_local Arena* current = nullptr;
+				return current;
+			}
+		};
+
+		// Makes arena the current arena of ScopedArenaAllocator on this thread until the end of the scope.
+		// Containers using ScopedArenaAllocator must not outlive the arena.
+		template<typename Arena>
+		class ArenaScope
+		{
+		public:
+			explicit ArenaScope(Arena& arena)
+			: _previous(ScopedArenaAllocator<Arena>::Current())
+			{
+				ScopedArenaAllocator<Arena>::Current() = &arena;
+			}
+
+			~ArenaScope()
+			{
+				ScopedArenaAllocator<Arena>::Current() = _previous;
+			}
+
+			ArenaScope(const ArenaScope&) = delete;
+			ArenaScope& operator=(const ArenaScope&) = delete;
+
+		private:
+			Arena* _previous;
+		};
+	}
+}
\ No newline at end of file
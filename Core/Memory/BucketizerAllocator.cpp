@@ -0,0 +1,129 @@
+#include "BucketizerAllocator.h"
+
+#include "Core/Algorithms/MinMax.h"
+#include "Core/Memory/VirtualMemoryAllocator.h"
+
+namespace Baroque
+{
+	namespace Memory
+	{
+		// Commits are rounded up so small buckets don't make a system call for every block
+		constexpr std::size_t RegionCommitSize = 64 * 1024;
+
+		void*& RegionNextFreeBlock(void* ptr)
+		{
+			return *static_cast<void**>(ptr);
+		}
+
+		// Whole pages of a free block after its free list link
+		bool RegionFreePages(void* ptr, std::size_t blockSize, std::uint8_t*& begin, std::size_t& size)
+		{
+			const auto pageSize = VirtualMemoryAllocator::GetPageSize();
+
+			auto* block = static_cast<std::uint8_t*>(ptr);
+
+			begin = AlignUp(block + sizeof(void*), pageSize);
+			auto* end = AlignDown(block + blockSize, pageSize);
+
+			size = end > begin ? static_cast<std::size_t>(end - begin) : 0;
+			return size != 0;
+		}
+
+		BucketRegion::BucketRegion(void* begin, std::size_t size, std::size_t blockSize)
+		: _top(AlignUp(static_cast<std::uint8_t*>(begin), blockSize))
+		, _commitEnd(_top)
+		, _end(static_cast<std::uint8_t*>(begin) + size)
+		, _blockSize(blockSize)
+		{
+		}
+
+		void* BucketRegion::Allocate(std::size_t size)
+		{
+			if (size > _blockSize)
+			{
+				return nullptr;
+			}
+
+			if (_free)
+			{
+				void* block = _free;
+
+				std::uint8_t* pages = nullptr;
+				std::size_t pagesSize = 0;
+
+				if (RegionFreePages(block, _blockSize, pages, pagesSize) && !VirtualMemoryAllocator::Commit(pages, pagesSize))
+				{
+					return nullptr;
+				}
+
+				_free = RegionNextFreeBlock(block);
+				return block;
+			}
+
+			if (_top >= _end || static_cast<std::size_t>(_end - _top) < _blockSize)
+			{
+				return nullptr;
+			}
+
+			auto* block = _top;
+			auto* blockEnd = block + _blockSize;
+
+			if (blockEnd > _commitEnd)
+			{
+				auto* commitEnd = Algorithm::Min(AlignUp(blockEnd, RegionCommitSize), _end);
+
+				if (!VirtualMemoryAllocator::Commit(_commitEnd, static_cast<std::size_t>(commitEnd - _commitEnd)))
+				{
+					return nullptr;
+				}
+
+				_commitEnd = commitEnd;
+			}
+
+			_top = blockEnd;
+
+			return block;
+		}
+
+		void BucketRegion::Deallocate(void* ptr)
+		{
+			if (!ptr)
+			{
+				return;
+			}
+
+			auto* block = static_cast<std::uint8_t*>(ptr);
+
+			if (block + _blockSize == _top)
+			{
+				_top = block;
+				return;
+			}
+
+			std::uint8_t* pages = nullptr;
+			std::size_t pagesSize = 0;
+
+			if (RegionFreePages(ptr, _blockSize, pages, pagesSize))
+			{
+				VirtualMemoryAllocator::Decommit(pages, pagesSize);
+			}
+
+			RegionNextFreeBlock(ptr) = _free;
+			_free = ptr;
+		}
+
+		BucketReservation::BucketReservation(std::size_t size)
+		: _begin(static_cast<std::uint8_t*>(VirtualMemoryAllocator::Reserve(size)))
+		, _size(size)
+		{
+		}
+
+		BucketReservation::~BucketReservation()
+		{
+			if (_begin)
+			{
+				VirtualMemoryAllocator::Release(_begin, _size);
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,254 @@
+#pragma once
+
+#include "Core/CoreDefines.h"
+
+#include "Core/Memory/Alignment.h"
+#include "Core/Memory/PoolAllocator.h"
+
+#include <tuple>
+#include <utility>
+
+namespace Baroque
+{
+	namespace Memory
+	{
+		// Address range of one bucket, split in blocks of blockSize bytes aligned on blockSize, a power of two.
+		// Blocks are bumped from it and committed on demand, freed blocks are rolled back when they are at the top
+		// or recycled through a free list with their pages decommitted.
+		class BAROQUE_CORE_API BucketRegion
+		{
+		public:
+			BucketRegion() = default;
+			BucketRegion(void* begin, std::size_t size, std::size_t blockSize);
+
+			// Sizes over the block size are not served
+			void* Allocate(std::size_t size);
+			void Deallocate(void* ptr);
+
+			std::size_t GetBlockSize() const
+			{
+				return _blockSize;
+			}
+
+			void* FindBlock(const void* ptr) const
+			{
+				return AlignDown(static_cast<std::uint8_t*>(const_cast<void*>(ptr)), _blockSize);
+			}
+
+		private:
+			std::uint8_t* _top = nullptr;
+			std::uint8_t* _commitEnd = nullptr;
+			std::uint8_t* _end = nullptr;
+			void* _free = nullptr;
+			std::size_t _blockSize = 0;
+		};
+
+		// Backend of the pools of BucketizerAllocator, gives the blocks of its bucket region
+		class BucketRegionAllocator
+		{
+		public:
+			static constexpr std::size_t StackCapacity = 0;
+
+			explicit BucketRegionAllocator(BucketRegion* region)
+			: _region(region)
+			{
+			}
+
+			void* Allocate(const std::size_t size)
+			{
+				return _region->Allocate(size);
+			}
+
+			void* Allocate(const std::size_t size, const std::size_t alignment)
+			{
+				return alignment <= _region->GetBlockSize() ? _region->Allocate(size) : nullptr;
+			}
+
+			void Deallocate(void* ptr)
+			{
+				_region->Deallocate(ptr);
+			}
+
+			void* FindBlock(const void* ptr) const
+			{
+				return _region->FindBlock(ptr);
+			}
+
+		private:
+			BucketRegion* _region;
+		};
+
+		// Reserves the address space of every bucket at once, released when the allocator is destroyed
+		class BAROQUE_CORE_API BucketReservation
+		{
+		public:
+			explicit BucketReservation(std::size_t size);
+			~BucketReservation();
+
+			BucketReservation(const BucketReservation&) = delete;
+			BucketReservation& operator=(const BucketReservation&) = delete;
+
+			std::uint8_t* Begin() const
+			{
+				return _begin;
+			}
+
+		private:
+			std::uint8_t* _begin;
+			std::size_t _size;
+		};
+
+		// Small object allocator with one PoolAllocator per size class, from MinSize to MaxSize in StepSize steps.
+		// Every bucket takes its blocks from its own BucketRangeSize range of one reservation, so Owns() is a range
+		// check and Deallocate() finds the bucket from the address. Allocate() and Deallocate() dispatch in O(1)
+		// through tables of the buckets. Sizes over MaxSize return nullptr, compose with SegregatorAllocator or
+		// FallbackAllocator for them. Not thread-safe, like PoolAllocator.
+		template<std::size_t MinSize, std::size_t MaxSize, std::size_t StepSize, std::size_t PreAllocCount = 64, std::size_t BucketRangeSize = std::size_t(256) << 20>
+		class BucketizerAllocator
+		{
+		public:
+			static_assert(MinSize >= sizeof(void*) && StepSize % sizeof(void*) == 0, "Bucket sizes must hold a pointer");
+			static_assert(MaxSize >= MinSize && (MaxSize - MinSize) % StepSize == 0, "MaxSize must be MinSize plus a multiple of StepSize");
+
+			static constexpr std::size_t StackCapacity = 0;
+			static constexpr std::size_t BucketCount = (MaxSize - MinSize) / StepSize + 1;
+
+			BucketizerAllocator()
+			: BucketizerAllocator(std::make_index_sequence<BucketCount>{})
+			{
+			}
+
+			BucketizerAllocator(const BucketizerAllocator&) = delete;
+			BucketizerAllocator& operator=(const BucketizerAllocator&) = delete;
+
+			void* Allocate(const std::size_t size)
+			{
+				if (size > MaxSize)
+				{
+					return nullptr;
+				}
+
+				return Buckets::AllocateFunctions[bucketIndex(size)](_pools);
+			}
+
+			// A bucket is picked when its entries are aligned enough, alignments over DefaultAlignment are not supported
+			void* Allocate(const std::size_t size, const std::size_t alignment)
+			{
+				if (size > MaxSize)
+				{
+					return nullptr;
+				}
+
+				for (auto index = bucketIndex(size); index < BucketCount; ++index)
+				{
+					if (MaxElementAlignment(bucketSize(index)) >= alignment)
+					{
+						return Buckets::AllocateFunctions[index](_pools);
+					}
+				}
+
+				return nullptr;
+			}
+
+			void Deallocate(void* ptr)
+			{
+				if (Owns(ptr))
+				{
+					Buckets::DeallocateFunctions[bucketIndexFromAddress(ptr)](_pools, ptr);
+				}
+			}
+
+			// Stays in place while the size fits in the bucket
+			void* Reallocate(void* ptr, const std::size_t oldSize, const std::size_t newSize)
+			{
+				BAROQUE_UNUSED(oldSize);
+
+				return Owns(ptr) && newSize <= bucketSize(bucketIndexFromAddress(ptr)) ? ptr : nullptr;
+			}
+
+			// Trims every bucket, see PoolAllocator::Trim(). Returns the number of released blocks.
+			std::size_t Trim(std::size_t maxFreeEntriesPerBucket = 0)
+			{
+				return std::apply([maxFreeEntriesPerBucket](auto&... pools)
+				{
+					return (pools.Trim(maxFreeEntriesPerBucket) + ...);
+				}, _pools);
+			}
+
+			// Size of the bucket, sizes over MaxSize are not served
+			static std::size_t GetAllocationSize(const std::size_t size)
+			{
+				return size <= MaxSize ? bucketSize(bucketIndex(size)) : size;
+			}
+
+			bool Owns(const void* ptr) const
+			{
+				return _reservation.Begin() && reinterpret_cast<std::uintptr_t>(ptr) - reinterpret_cast<std::uintptr_t>(_reservation.Begin()) < BucketCount * BucketRangeSize;
+			}
+
+		private:
+			template<std::size_t Index>
+			using BucketPool = PoolAllocator<BucketRegionAllocator, MinSize + Index * StepSize, PreAllocCount>;
+
+			template<typename Indices>
+			struct BucketTables;
+
+			template<std::size_t... Indices>
+			struct BucketTables<std::index_sequence<Indices...>>
+			{
+				using Pools = std::tuple<BucketPool<Indices>...>;
+
+				template<std::size_t Index>
+				static void* allocate(Pools& pools)
+				{
+					return std::get<Index>(pools).Allocate();
+				}
+
+				template<std::size_t Index>
+				static void deallocate(Pools& pools, void* ptr)
+				{
+					std::get<Index>(pools).Deallocate(ptr);
+				}
+
+				static constexpr void* (*AllocateFunctions[])(Pools&) = { &allocate<Indices>... };
+				static constexpr void (*DeallocateFunctions[])(Pools&, void*) = { &deallocate<Indices>... };
+			};
+
+			using Buckets = BucketTables<std::make_index_sequence<BucketCount>>;
+
+			template<std::size_t... Indices>
+			explicit BucketizerAllocator(std::index_sequence<Indices...>)
+			: _reservation(BucketCount * BucketRangeSize)
+			, _regions{ makeRegion(Indices, BucketPool<Indices>::BlockSize)... }
+			, _pools(BucketRegionAllocator(&_regions[Indices])...)
+			{
+			}
+
+			BucketRegion makeRegion(std::size_t index, std::size_t blockSize) const
+			{
+				return _reservation.Begin() ? BucketRegion(_reservation.Begin() + index * BucketRangeSize, BucketRangeSize, blockSize) : BucketRegion();
+			}
+
+			static constexpr std::size_t bucketIndex(std::size_t size)
+			{
+				return size <= MinSize ? 0 : (size - MinSize + StepSize - 1) / StepSize;
+			}
+
+			static constexpr std::size_t bucketSize(std::size_t index)
+			{
+				return MinSize + index * StepSize;
+			}
+
+			std::size_t bucketIndexFromAddress(const void* ptr) const
+			{
+				return static_cast<std::size_t>(static_cast<const std::uint8_t*>(ptr) - _reservation.Begin()) / BucketRangeSize;
+			}
+
+		private:
+			// The pools give their blocks back to the regions when they are destroyed, the reservation is released last
+			BucketReservation _reservation;
+			BucketRegion _regions[BucketCount];
+			typename Buckets::Pools _pools;
+		};
+	}
+}
\ No newline at end of file
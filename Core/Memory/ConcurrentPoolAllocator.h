@@ -0,0 +1,306 @@
+#pragma once
+
+#include "Core/CoreDefines.h"
+
+#include "Core/Memory/Alignment.h"
+#include "Core/Memory/ObjectAllocator.h"
+#include "Core/Threading/ThreadIndex.h"
+
+#include <atomic>
+
+namespace Baroque
+{
+	namespace Memory
+	{
+		// Thread-safe PoolAllocator. Every thread keeps a magazine of free entries in the pool,
+		// magazines exchange batches of entries with a lock-free global stack of batches.
+		// Threads without a thread index use the global stack directly.
+		// Entries can be freed by any thread. BackendAllocator must be thread-safe.
+		template<typename BackendAllocator, std::size_t EntrySize, std::size_t PreAllocCount = 256, std::size_t EntryAlignment = MaxElementAlignment(EntrySize)>
+		class ConcurrentPoolAllocator : private BackendAllocator
+		{
+		public:
+			// A free batch head links to the next entry of its batch and to the next batch
+			static_assert(EntrySize >= 2 * sizeof(void*), "Entry size must be greater or equal than two pointers size");
+			static_assert(IsPowerOfTwo(EntryAlignment) && EntrySize % EntryAlignment == 0, "Entry size must be a multiple of the entry alignment");
+
+			static constexpr std::size_t StackCapacity = 0;
+
+			ConcurrentPoolAllocator() = default;
+			ConcurrentPoolAllocator(const ConcurrentPoolAllocator&) = delete;
+			ConcurrentPoolAllocator& operator=(const ConcurrentPoolAllocator&) = delete;
+
+			~ConcurrentPoolAllocator()
+			{
+				void* it = _blockAllocList.load(std::memory_order_acquire);
+
+				while (it)
+				{
+					void* next = *((void**)it);
+
+					BackendAllocator::Deallocate(it);
+
+					it = next;
+				}
+			}
+
+			void* Allocate(const std::size_t size = 0)
+			{
+				BAROQUE_UNUSED(size);
+
+				const auto threadIndex = GetThreadIndex();
+
+				if (threadIndex < MaxThreadIndexCount)
+				{
+					auto& magazine = _magazines[threadIndex];
+
+					if (magazine.Head)
+					{
+						void* result = magazine.Head;
+						magazine.Head = nextEntry(result);
+						--magazine.Count;
+						return result;
+					}
+				}
+
+				return allocateSlow(threadIndex);
+			}
+
+			void* Allocate(const std::size_t size, const std::size_t alignment)
+			{
+				return alignment <= EntryAlignment ? Allocate(size) : nullptr;
+			}
+
+			void Deallocate(void* ptr)
+			{
+				const auto threadIndex = GetThreadIndex();
+
+				if (threadIndex < MaxThreadIndexCount)
+				{
+					auto& magazine = _magazines[threadIndex];
+
+					nextEntry(ptr) = magazine.Head;
+					magazine.Head = ptr;
+
+					if (++magazine.Count == 2 * BatchSize)
+					{
+						releaseBatch(magazine);
+					}
+				}
+				else
+				{
+					nextEntry(ptr) = nullptr;
+					pushBatches(ptr, ptr);
+				}
+			}
+
+		private:
+			static constexpr std::size_t BatchSize = PreAllocCount < 32 ? PreAllocCount : 32;
+			static constexpr std::size_t HeaderSize = EntryAlignment > sizeof(void*) ? EntryAlignment : sizeof(void*);
+			static constexpr std::size_t BlockSize = EntrySize * PreAllocCount + HeaderSize;
+
+			// The tag changes on every push and pop so a stale head can't be swapped back in (ABA)
+			static constexpr std::size_t PointerBits = sizeof(void*) == 8 ? 48 : 32;
+			static constexpr std::uint64_t PointerMask = (std::uint64_t(1) << PointerBits) - 1;
+
+			struct alignas(64) Magazine
+			{
+				void* Head = nullptr;
+				std::size_t Count = 0;
+			};
+
+			static void*& nextEntry(void* entry)
+			{
+				return static_cast<void**>(entry)[0];
+			}
+
+			static void*& nextBatch(void* entry)
+			{
+				return static_cast<void**>(entry)[1];
+			}
+
+			static void* taggedPointer(std::uint64_t tagged)
+			{
+				return reinterpret_cast<void*>(static_cast<std::uintptr_t>(tagged & PointerMask));
+			}
+
+			static std::uint64_t makeTagged(void* pointer, std::uint64_t previous)
+			{
+				return ((previous & ~PointerMask) + (PointerMask + 1)) | static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(pointer));
+			}
+
+			// Pushes a chain of batches linked by nextBatch()
+			void pushBatches(void* first, void* last)
+			{
+				auto head = _freeBatches.load(std::memory_order_relaxed);
+
+				do
+				{
+					nextBatch(last) = taggedPointer(head);
+				}
+				while (!_freeBatches.compare_exchange_weak(head, makeTagged(first, head), std::memory_order_release, std::memory_order_relaxed));
+			}
+
+			void* popBatch()
+			{
+				auto head = _freeBatches.load(std::memory_order_acquire);
+
+				for (;;)
+				{
+					void* batch = taggedPointer(head);
+					if (!batch)
+					{
+						return nullptr;
+					}
+
+					// The batch may be taken and reused concurrently, the memory stays mapped
+					// until the pool is destroyed and the tag makes the exchange fail in that case.
+					void* next = nextBatch(batch);
+
+					if (_freeBatches.compare_exchange_weak(head, makeTagged(next, head), std::memory_order_acquire, std::memory_order_acquire))
+					{
+						return batch;
+					}
+				}
+			}
+
+			// Gives the oldest half of a full magazine back to the global stack,
+			// the most recently freed entries are more likely to be in cache
+			void releaseBatch(Magazine& magazine)
+			{
+				void* keptLast = magazine.Head;
+
+				for (std::size_t i = 1; i < BatchSize; ++i)
+				{
+					keptLast = nextEntry(keptLast);
+				}
+
+				void* released = nextEntry(keptLast);
+				nextEntry(keptLast) = nullptr;
+
+				magazine.Count -= BatchSize;
+
+				pushBatches(released, released);
+			}
+
+			void* allocateSlow(std::size_t threadIndex)
+			{
+				void* batch = popBatch();
+
+				if (!batch)
+				{
+					batch = allocateMemoryBlock();
+
+					if (!batch)
+					{
+						return nullptr;
+					}
+				}
+
+				void* result = batch;
+				void* rest = nextEntry(batch);
+
+				if (threadIndex < MaxThreadIndexCount)
+				{
+					auto& magazine = _magazines[threadIndex];
+
+					std::size_t count = 0;
+					for (void* it = rest; it; it = nextEntry(it))
+					{
+						++count;
+					}
+
+					magazine.Head = rest;
+					magazine.Count = count;
+				}
+				else if (rest)
+				{
+					pushBatches(rest, rest);
+				}
+
+				return result;
+			}
+
+			// Returns the first batch of the new block, the other batches go to the global stack
+			void* allocateMemoryBlock()
+			{
+				std::uint8_t* memoryBlock = nullptr;
+
+				if constexpr (EntryAlignment > DefaultAlignment)
+				{
+					memoryBlock = reinterpret_cast<std::uint8_t*>(BackendAllocator::Allocate(BlockSize, EntryAlignment));
+				}
+				else
+				{
+					memoryBlock = reinterpret_cast<std::uint8_t*>(BackendAllocator::Allocate(BlockSize));
+				}
+
+				if (!memoryBlock)
+				{
+					return nullptr;
+				}
+
+				auto* blockHead = _blockAllocList.load(std::memory_order_relaxed);
+
+				do
+				{
+					*(void**)memoryBlock = blockHead;
+				}
+				while (!_blockAllocList.compare_exchange_weak(blockHead, memoryBlock, std::memory_order_release, std::memory_order_relaxed));
+
+				memoryBlock += HeaderSize;
+
+				void* otherBatchesFirst = nullptr;
+				void* otherBatchesLast = nullptr;
+
+				for (std::size_t batchStart = 0; batchStart < PreAllocCount; batchStart += BatchSize)
+				{
+					const auto batchEnd = batchStart + BatchSize < PreAllocCount ? batchStart + BatchSize : PreAllocCount;
+
+					for (std::size_t i = batchStart; i < batchEnd; ++i)
+					{
+						nextEntry(memoryBlock + i * EntrySize) = i + 1 < batchEnd ? memoryBlock + (i + 1) * EntrySize : nullptr;
+					}
+
+					if (batchStart == 0)
+					{
+						continue;
+					}
+
+					void* batch = memoryBlock + batchStart * EntrySize;
+
+					if (otherBatchesLast)
+					{
+						nextBatch(otherBatchesLast) = batch;
+					}
+					else
+					{
+						otherBatchesFirst = batch;
+					}
+
+					otherBatchesLast = batch;
+				}
+
+				if (otherBatchesFirst)
+				{
+					pushBatches(otherBatchesFirst, otherBatchesLast);
+				}
+
+				return memoryBlock;
+			}
+
+		private:
+			Magazine _magazines[MaxThreadIndexCount];
+			alignas(64) std::atomic<std::uint64_t> _freeBatches{ 0 };
+			std::atomic<void*> _blockAllocList{ nullptr };
+		};
+
+		template<typename BackendAllocator, std::size_t EntrySize, std::size_t PreAllocCount, std::size_t EntryAlignment>
+		struct HasFixedEntrySize<ConcurrentPoolAllocator<BackendAllocator, EntrySize, PreAllocCount, EntryAlignment>> : std::true_type
+		{
+		};
+
+		template<typename T, typename BackendAllocator, std::size_t PreAllocCount = 128>
+		using ConcurrentPoolObjectAllocator = Baroque::Memory::ObjectAllocator<T, ConcurrentPoolAllocator<BackendAllocator, (sizeof(T) < 2 * sizeof(void*) ? 2 * sizeof(void*) : sizeof(T)), PreAllocCount, alignof(T)>>;
+	}
+}
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include "Core/CoreDefines.h"
 
+#include "Core/Memory/AllocatorTraits.h"
+
 namespace Baroque
 {
 	namespace Memory
@@ -22,6 +24,16 @@ namespace Baroque
 				return result;
 			}
 
+			void* Allocate(const std::size_t size, const std::size_t alignment)
+			{
+				void* result = Primary::Allocate(size, alignment);
+				if (!result)
+				{
+					result = Fallback::Allocate(size, alignment);
+				}
+				return result;
+			}
+
 			void Deallocate(void* ptr)
 			{
 				if (ptr)
@@ -37,6 +49,50 @@ namespace Baroque
 				}
 			}
 
+			void Deallocate(void* ptr, const std::size_t size)
+			{
+				if (ptr)
+				{
+					if (Primary::Owns(ptr))
+					{
+						DeallocateSized(static_cast<Primary&>(*this), ptr, size);
+					}
+					else
+					{
+						DeallocateSized(static_cast<Fallback&>(*this), ptr, size);
+					}
+				}
+			}
+
+			void* Reallocate(void* ptr, const std::size_t oldSize, const std::size_t newSize)
+			{
+				if (!ptr)
+				{
+					return nullptr;
+				}
+
+				if (Primary::Owns(ptr))
+				{
+					if constexpr (CanReallocate_v<Primary>)
+					{
+						return Primary::Reallocate(ptr, oldSize, newSize);
+					}
+					else
+					{
+						return nullptr;
+					}
+				}
+
+				if constexpr (CanReallocate_v<Fallback>)
+				{
+					return Fallback::Reallocate(ptr, oldSize, newSize);
+				}
+				else
+				{
+					return nullptr;
+				}
+			}
+
 			bool Owns(const void* ptr) const
 			{
 				return Primary::Owns(ptr) || Fallback::Owns(ptr);
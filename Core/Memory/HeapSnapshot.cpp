@@ -0,0 +1,257 @@
+#include "HeapSnapshot.h"
+
+#if defined(BAROQUE_TRACING_ALLOCATOR)
+#include "Core/Hashing/PointerHash.h"
+#include "Core/Memory/VirtualMemoryAllocator.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace Baroque
+{
+	namespace Memory
+	{
+		constexpr std::size_t InitialStringIdTableSize = 1024;
+
+		static_assert((InitialStringIdTableSize & (InitialStringIdTableSize - 1)) == 0, "The String Id Table must be a power of two");
+
+		// Category names and SourceLocation strings are literals, they are identified by their address
+		class StringIdTable
+		{
+		public:
+			~StringIdTable()
+			{
+				VirtualMemoryAllocator{}.Deallocate(_slots);
+			}
+
+			// Returns 0 when the string was never added
+			std::uint32_t Find(const char* string)
+			{
+				if (!_slots)
+				{
+					return 0;
+				}
+
+				const auto mask = _capacity - 1;
+
+				for (auto index = Hashing::PointerHash(string) & mask; _slots[index].String; index = (index + 1) & mask)
+				{
+					if (_slots[index].String == string)
+					{
+						return _slots[index].Id;
+					}
+				}
+
+				return 0;
+			}
+
+			std::uint32_t Add(const char* string)
+			{
+				if ((_count + 1) * 2 > _capacity)
+				{
+					grow();
+				}
+
+				insert(string, ++_count);
+
+				return _count;
+			}
+
+		private:
+			struct Slot
+			{
+				const char* String;
+				std::uint32_t Id;
+			};
+
+			void insert(const char* string, std::uint32_t id)
+			{
+				const auto mask = _capacity - 1;
+
+				auto index = Hashing::PointerHash(string) & mask;
+
+				while (_slots[index].String)
+				{
+					index = (index + 1) & mask;
+				}
+
+				_slots[index].String = string;
+				_slots[index].Id = id;
+			}
+
+			void grow()
+			{
+				auto* oldSlots = _slots;
+				auto oldCapacity = _capacity;
+
+				_capacity = _capacity ? _capacity * 2 : InitialStringIdTableSize;
+
+				// VirtualMemoryAllocator memory is zero-filled by the OS
+				_slots = static_cast<Slot*>(VirtualMemoryAllocator{}.Allocate(_capacity * sizeof(Slot)));
+
+				for (std::size_t index = 0; index < oldCapacity; ++index)
+				{
+					if (oldSlots[index].String)
+					{
+						insert(oldSlots[index].String, oldSlots[index].Id);
+					}
+				}
+
+				VirtualMemoryAllocator{}.Deallocate(oldSlots);
+			}
+
+			Slot* _slots = nullptr;
+			std::size_t _capacity = 0;
+			std::uint32_t _count = 0;
+		};
+
+		// Copy of the live allocations, filled while the shards are locked so the file is written without holding them
+		class AllocationRecordBuffer
+		{
+		public:
+			~AllocationRecordBuffer()
+			{
+				VirtualMemoryAllocator{}.Deallocate(_records);
+			}
+
+			void Add(const AllocationInfo& allocationInfo)
+			{
+				if (_size == _capacity)
+				{
+					grow();
+				}
+
+				_records[_size++] = allocationInfo;
+			}
+
+			const AllocationInfo* begin() const
+			{
+				return _records;
+			}
+
+			const AllocationInfo* end() const
+			{
+				return _records + _size;
+			}
+
+		private:
+			void grow()
+			{
+				const auto newCapacity = _capacity ? _capacity * 2 : VirtualMemoryAllocator::GetPageSize() / sizeof(AllocationInfo);
+
+				auto* newRecords = static_cast<AllocationInfo*>(VirtualMemoryAllocator{}.Allocate(newCapacity * sizeof(AllocationInfo)));
+
+				if (_records)
+				{
+					std::memcpy(newRecords, _records, _size * sizeof(AllocationInfo));
+					VirtualMemoryAllocator{}.Deallocate(_records);
+				}
+
+				_records = newRecords;
+				_capacity = newCapacity;
+			}
+
+			AllocationInfo* _records = nullptr;
+			std::size_t _size = 0;
+			std::size_t _capacity = 0;
+		};
+
+		struct HeapSnapshotWriter
+		{
+			std::FILE* File;
+			StringIdTable StringIds;
+			bool Failed = false;
+
+			void Write(const void* data, std::size_t size)
+			{
+				if (!Failed && size && std::fwrite(data, size, 1, File) != 1)
+				{
+					Failed = true;
+				}
+			}
+
+			void WriteRecordType(HeapSnapshotRecordType recordType)
+			{
+				Write(&recordType, sizeof(recordType));
+			}
+
+			std::uint32_t GetStringId(const char* string)
+			{
+				if (!string || !*string)
+				{
+					return 0;
+				}
+
+				if (auto id = StringIds.Find(string))
+				{
+					return id;
+				}
+
+				const auto id = StringIds.Add(string);
+				const auto length = static_cast<std::uint32_t>(std::strlen(string));
+
+				WriteRecordType(HeapSnapshotRecordType::String);
+				Write(&id, sizeof(id));
+				Write(&length, sizeof(length));
+				Write(string, length);
+
+				return id;
+			}
+
+			void WriteAllocation(const AllocationInfo& allocationInfo)
+			{
+				HeapSnapshotAllocation allocation;
+				allocation.Address = reinterpret_cast<std::uintptr_t>(allocationInfo.Allocation);
+				allocation.Size = allocationInfo.Size;
+				allocation.SampledBytes = allocationInfo.SampledBytes;
+				allocation.CategoryNameId = GetStringId(allocationInfo.Category ? allocationInfo.Category->Name : nullptr);
+				allocation.FileNameId = GetStringId(allocationInfo.SourceLocation.FileName);
+				allocation.FunctionId = GetStringId(allocationInfo.SourceLocation.Function);
+				allocation.Line = allocationInfo.SourceLocation.Line;
+
+				WriteRecordType(HeapSnapshotRecordType::Allocation);
+				Write(&allocation, sizeof(allocation));
+			}
+		};
+
+		bool WriteHeapSnapshot(const char* filename)
+		{
+			HeapSnapshotWriter writer;
+
+			writer.File = std::fopen(filename, "wb");
+			if (!writer.File)
+			{
+				return false;
+			}
+
+			HeapSnapshotHeader header;
+			header.Magic = HeapSnapshotMagic;
+			header.Version = HeapSnapshotVersion;
+
+			writer.Write(&header, sizeof(header));
+
+			// File writes can block for a long time, the allocations are copied first and written once every shard is unlocked
+			AllocationRecordBuffer records;
+
+			ForEachAllocation([&records](const AllocationInfo& allocationInfo)
+			{
+				records.Add(allocationInfo);
+			});
+
+			for (const auto& allocationInfo : records)
+			{
+				writer.WriteAllocation(allocationInfo);
+			}
+
+			writer.WriteRecordType(HeapSnapshotRecordType::End);
+
+			if (std::fclose(writer.File) != 0)
+			{
+				return false;
+			}
+
+			return !writer.Failed;
+		}
+	}
+}
+#endif
\ No newline at end of file
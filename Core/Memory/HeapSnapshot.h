@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Core/CoreDefines.h"
+#include "Core/Memory/TracingAllocator.h"
+
+namespace Baroque
+{
+	namespace Memory
+	{
+		// Heap snapshot file layout, written in the native byte order:
+		//   HeapSnapshotHeader
+		//   Records, each one starting with a HeapSnapshotRecordType byte:
+		//     String:     std::uint32_t id, std::uint32_t length, then length characters without null terminator
+		//     Allocation: HeapSnapshotAllocation
+		//     End:        nothing, last record of the file
+		// A string is always written before the first allocation that refers to it, id 0 is the empty string.
+		constexpr std::uint32_t HeapSnapshotMagic = 0x50414548; // "HEAP"
+		constexpr std::uint32_t HeapSnapshotVersion = 1;
+
+		enum class HeapSnapshotRecordType : std::uint8_t
+		{
+			String = 1,
+			Allocation = 2,
+			End = 3
+		};
+
+		struct HeapSnapshotHeader
+		{
+			std::uint32_t Magic;
+			std::uint32_t Version;
+		};
+
+		struct HeapSnapshotAllocation
+		{
+			std::uint64_t Address;
+			std::uint64_t Size;
+			std::uint64_t SampledBytes;
+			std::uint32_t CategoryNameId;
+			std::uint32_t FileNameId;
+			std::uint32_t FunctionId;
+			std::uint32_t Line;
+		};
+
+		static_assert(sizeof(HeapSnapshotHeader) == 8, "HeapSnapshotHeader must not have padding");
+		static_assert(sizeof(HeapSnapshotAllocation) == 40, "HeapSnapshotAllocation must not have padding");
+
+#if defined(BAROQUE_TRACING_ALLOCATOR)
+		// Streams every live traced allocation to filename, returns false if the file could not be written.
+		// Allocations done while the snapshot is written may or may not be part of it.
+		BAROQUE_CORE_API bool WriteHeapSnapshot(const char* filename);
+#endif
+	}
+}
\ No newline at end of file
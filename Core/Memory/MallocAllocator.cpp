@@ -1,19 +1,66 @@
 #include "MallocAllocator.h"
 
+#include "Core/Memory/Alignment.h"
+
 #include <cstdlib>
 
+#if defined(BAROQUE_PLATFORM_WINDOWS)
+#include <malloc.h>
+#endif
+
 namespace Baroque
 {
 	namespace Memory
 	{
+#if defined(BAROQUE_PLATFORM_WINDOWS)
+		// The CRT free() can't release over-aligned blocks, every block goes through the aligned functions
+		void* MallocAllocator::Allocate(const std::size_t size)
+		{
+			return ::_aligned_malloc(size, DefaultAlignment);
+		}
+
+		void* MallocAllocator::Allocate(const std::size_t size, const std::size_t alignment)
+		{
+			return ::_aligned_malloc(size, alignment > DefaultAlignment ? alignment : DefaultAlignment);
+		}
+
+		void MallocAllocator::Deallocate(void* ptr)
+		{
+			::_aligned_free(ptr);
+		}
+
+		void* MallocAllocator::Reallocate(void* ptr, const std::size_t oldSize, const std::size_t newSize)
+		{
+			BAROQUE_UNUSED(oldSize);
+			return ::_aligned_realloc(ptr, newSize, DefaultAlignment);
+		}
+#else
 		void* MallocAllocator::Allocate(const std::size_t size)
 		{
 			return std::malloc(size);
 		}
 
+		void* MallocAllocator::Allocate(const std::size_t size, const std::size_t alignment)
+		{
+			if (alignment <= DefaultAlignment)
+			{
+				return std::malloc(size);
+			}
+
+			void* result = nullptr;
+			return ::posix_memalign(&result, alignment, size) == 0 ? result : nullptr;
+		}
+
 		void MallocAllocator::Deallocate(void* ptr)
 		{
 			std::free(ptr);
 		}
+
+		void* MallocAllocator::Reallocate(void* ptr, const std::size_t oldSize, const std::size_t newSize)
+		{
+			BAROQUE_UNUSED(oldSize);
+			return std::realloc(ptr, newSize);
+		}
+#endif
 	}
 }
\ No newline at end of file
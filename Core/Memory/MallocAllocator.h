@@ -12,7 +12,10 @@ namespace Baroque
 			static constexpr std::size_t StackCapacity = 0;
 
 			void* Allocate(const std::size_t size);
+			void* Allocate(const std::size_t size, const std::size_t alignment);
 			void Deallocate(void* ptr);
+			// Blocks keep DefaultAlignment only, over-aligned blocks must not be reallocated
+			void* Reallocate(void* ptr, const std::size_t oldSize, const std::size_t newSize);
 		};
 	}
 }
@@ -2,27 +2,34 @@
 
 #include "Core/CoreDefines.h"
 
+#include "Core/Memory/Alignment.h"
+#include "Core/Memory/AllocatorTraits.h"
 #include "Core/Memory/FallbackAllocator.h"
 #include "Core/Memory/MallocAllocator.h"
 #include "Core/Memory/StackAllocator.h"
+#include "Core/Memory/ThreadCachingAllocator.h"
 #include "Core/Memory/TracingAllocator.h"
 
-#if defined(BAROQUE_TRACE_MEMORY)
+#if defined(BAROQUE_TRACING_ALLOCATOR)
 #define BAROQUE_DEFINE_ALLOCATOR(Name, ...) using Name = Baroque::Memory::TracingAllocator<__VA_ARGS__>
 #define BAROQUE_ALLOC(allocator, size, category) allocator.Allocate(size, BAROQUE_GET_MEMORY_CATEGORY(category), BAROQUE_SOURCE_LOCATION)
+#define BAROQUE_ALLOC_ALIGNED(allocator, size, alignment, category) allocator.Allocate(size, alignment, BAROQUE_GET_MEMORY_CATEGORY(category), BAROQUE_SOURCE_LOCATION)
+#define BAROQUE_REALLOC(allocator, ptr, oldSize, newSize, category) allocator.Reallocate(ptr, oldSize, newSize, BAROQUE_GET_MEMORY_CATEGORY(category), BAROQUE_SOURCE_LOCATION)
 #else
 #define BAROQUE_DEFINE_ALLOCATOR(Name, ...) using Name = __VA_ARGS__
 #define BAROQUE_ALLOC(allocator, size, category) allocator.Allocate(size)
+#define BAROQUE_ALLOC_ALIGNED(allocator, size, alignment, category) allocator.Allocate(size, alignment)
+#define BAROQUE_REALLOC(allocator, ptr, oldSize, newSize, category) allocator.Reallocate(ptr, oldSize, newSize)
 #endif
 
 namespace Baroque
 {
 	namespace Memory
 	{
-		BAROQUE_DEFINE_ALLOCATOR(DefaultAllocator, Baroque::Memory::MallocAllocator);
+		BAROQUE_DEFINE_ALLOCATOR(DefaultAllocator, Baroque::Memory::ThreadCachingAllocator);
 
 		template<std::size_t Size>
-		BAROQUE_DEFINE_ALLOCATOR(SmallAllocator, Baroque::Memory::FallbackAllocator<Baroque::Memory::StackAllocator<Size>, Baroque::Memory::MallocAllocator>);
+		BAROQUE_DEFINE_ALLOCATOR(SmallAllocator, Baroque::Memory::FallbackAllocator<Baroque::Memory::StackAllocator<Size>, Baroque::Memory::ThreadCachingAllocator>);
 
 		template<std::size_t Size>
 		BAROQUE_DEFINE_ALLOCATOR(DefaultStackAllocator, Baroque::Memory::StackAllocator<Size>);
@@ -29,19 +29,19 @@ namespace Baroque
 
 		namespace Literals
 		{
-			constexpr KB operator""_KB(const std::size_t size)
+			constexpr KB operator""_KB(const unsigned long long size)
 			{
-				return KB{ size };
+				return KB{ static_cast<std::size_t>(size) };
 			}
 
-			constexpr MB operator""_MB(const std::size_t size)
+			constexpr MB operator""_MB(const unsigned long long size)
 			{
-				return MB{ size };
+				return MB{ static_cast<std::size_t>(size) };
 			}
 
-			constexpr GB operator""_GB(const std::size_t size)
+			constexpr GB operator""_GB(const unsigned long long size)
 			{
-				return GB{ size };
+				return GB{ static_cast<std::size_t>(size) };
 			}
 		}
 	}
@@ -2,6 +2,12 @@
 
 #include "Core/CoreDefines.h"
 
+#include "Core/Memory/Alignment.h"
+#include "Core/Memory/AllocatorTraits.h"
+
+#include <new>
+#include <utility>
+
 namespace Baroque
 {
 	namespace Memory
@@ -15,7 +21,17 @@ namespace Baroque
 			template<typename... Args>
 			T* Allocate(Args&& ... args)
 			{
-				void* allocation = BackendAllocator::Allocate(sizeof(T));
+				void* allocation = nullptr;
+
+				if constexpr (alignof(T) > DefaultAlignment)
+				{
+					allocation = BackendAllocator::Allocate(sizeof(T), alignof(T));
+				}
+				else
+				{
+					allocation = BackendAllocator::Allocate(sizeof(T));
+				}
+
 				new (allocation) T(std::forward<Args>(args)...);
 				return static_cast<T*>(allocation);
 			}
@@ -23,7 +39,7 @@ namespace Baroque
 			void Deallocate(T* ptr)
 			{
 				ptr->~T();
-				BackendAllocator::Deallocate(ptr);
+				DeallocateSized(static_cast<BackendAllocator&>(*this), ptr, sizeof(T));
 			}
 		};
 	}
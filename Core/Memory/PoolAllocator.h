@@ -2,39 +2,81 @@
 
 #include "Core/CoreDefines.h"
 
+#include "Core/Memory/Alignment.h"
+#include "Core/Memory/AllocatorTraits.h"
 #include "Core/Memory/ObjectAllocator.h"
 
 #include <cstring>
+#include <limits>
 #include <utility>
 
 namespace Baroque
 {
 	namespace Memory
 	{
-		template<typename BackendAllocator, std::size_t EntrySize, std::size_t PreAllocCount = 256>
+		// Allocates fixed size entries from blocks of at least PreAllocCount entries, BlockSize bytes rounded up to a power of two.
+		// The block of a freed entry is found by the BackendAllocator when it provides FindBlock(), see CanFindBlock,
+		// or with a binary search in a sorted index of the blocks allocated from the BackendAllocator.
+		// Every block has its own free list and count of allocated entries, a block whose last entry is freed
+		// is given back to the BackendAllocator when the free entries are over the high water mark.
+		// Freed entries first go to a cache of up to EntriesPerBlock entries that Allocate() reuses, the cache
+		// is flushed to the blocks when it is full so alternating Allocate() and Deallocate() don't touch the blocks.
+		// Allocate() stays O(1) and Deallocate() amortized O(1), O(log blocks) with the index, and entries don't have any header.
+		// Entries are aligned on EntryAlignment.
+		template<typename BackendAllocator, std::size_t EntrySize, std::size_t PreAllocCount = 256, std::size_t EntryAlignment = MaxElementAlignment(EntrySize)>
 		class PoolAllocator : private BackendAllocator
 		{
+			struct BlockHeader
+			{
+				BlockHeader* Next;
+				BlockHeader* Previous;
+				// Blocks with at least one free entry
+				BlockHeader* NextAvailable;
+				BlockHeader* PreviousAvailable;
+				void* Free;
+				std::size_t LiveCount;
+			};
+
+			static constexpr std::size_t HeaderSize = AlignUp(sizeof(BlockHeader), EntryAlignment);
+			static constexpr std::size_t InitialBlockIndexCapacity = 16;
+
 		public:
 			static_assert(EntrySize >= sizeof(void*), "Entry size must be greater or equal than a pointer size");
+			static_assert(IsPowerOfTwo(EntryAlignment) && EntrySize % EntryAlignment == 0, "Entry size must be a multiple of the entry alignment");
 
 			static constexpr std::size_t StackCapacity = 0;
+			static constexpr std::size_t BlockSize = NextPowerOfTwo(HeaderSize + EntrySize * PreAllocCount);
+			// The whole block is used, this is PreAllocCount or more
+			static constexpr std::size_t EntriesPerBlock = (BlockSize - HeaderSize) / EntrySize;
 
 			PoolAllocator()
 			{
 				allocateMemoryBlock();
 			}
 
+			// For backends with a state, like the regions of BucketizerAllocator
+			explicit PoolAllocator(const BackendAllocator& backend)
+			: BackendAllocator(backend)
+			{
+				allocateMemoryBlock();
+			}
+
 			~PoolAllocator()
 			{
-				void* it = _blockAllocList;
+				BlockHeader* block = _blocks;
 
-				while (it)
+				while (block)
 				{
-					void* next = *((void**)it);
+					BlockHeader* next = block->Next;
 
-					BackendAllocator::Deallocate(it);
+					BackendAllocator::Deallocate(block);
 
-					it = next;
+					block = next;
+				}
+
+				if (_blockIndex)
+				{
+					BackendAllocator::Deallocate(_blockIndex);
 				}
 			}
 
@@ -42,45 +84,358 @@ namespace Baroque
 			{
 				BAROQUE_UNUSED(size);
 
-				if (!_free)
+				if (_cache)
 				{
-					allocateMemoryBlock();
+					void* result = _cache;
+					_cache = *((void**)_cache);
+					--_cacheCount;
+					--_freeCount;
+					return result;
+				}
+
+				if (!_available && !allocateMemoryBlock())
+				{
+					return nullptr;
+				}
+
+				BlockHeader* block = _available;
+
+				void* result = block->Free;
+				block->Free = *((void**)result);
+				--_freeCount;
+
+				if (++block->LiveCount == EntriesPerBlock)
+				{
+					unlinkAvailable(block);
 				}
 
-				void* result = _free;
-				_free = *((void**)_free);
 				return result;
 			}
 
+			void* Allocate(const std::size_t size, const std::size_t alignment)
+			{
+				return alignment <= EntryAlignment ? Allocate(size) : nullptr;
+			}
+
 			void Deallocate(void* ptr)
 			{
-				*(void**)ptr = _free;
-				_free = ptr;
+				*(void**)ptr = _cache;
+				_cache = ptr;
+				++_freeCount;
+
+				if (++_cacheCount > EntriesPerBlock)
+				{
+					flushCache();
+				}
+			}
+
+			// Walks the blocks, composite allocators should route their blocks with sized deallocation instead
+			bool Owns(const void* ptr) const
+			{
+				for (const BlockHeader* block = _blocks; block; block = block->Next)
+				{
+					const auto* entries = reinterpret_cast<const std::uint8_t*>(block) + HeaderSize;
+
+					if (ptr >= entries && ptr < entries + EntrySize * EntriesPerBlock)
+					{
+						return true;
+					}
+				}
+
+				return false;
+			}
+
+			// Gives the blocks without any allocated entry back to the BackendAllocator
+			// until at most maxFreeEntries free entries remain. Returns the number of released blocks.
+			// Cost is O(blocks with a free entry).
+			std::size_t Trim(std::size_t maxFreeEntries = 0)
+			{
+				flushCache();
+
+				std::size_t releasedCount = 0;
+
+				BlockHeader* block = _availableTail;
+
+				while (block && _freeCount > maxFreeEntries)
+				{
+					BlockHeader* previous = block->PreviousAvailable;
+
+					if (block->LiveCount == 0)
+					{
+						unlinkAvailable(block);
+						releaseMemoryBlock(block);
+						++releasedCount;
+					}
+
+					block = previous;
+				}
+
+				return releasedCount;
+			}
+
+			// Blocks that become empty when the cache is flushed are released while the free entries are over maxFreeEntries
+			void SetHighWaterMark(std::size_t maxFreeEntries)
+			{
+				_highWaterMark = maxFreeEntries;
+			}
+
+			std::size_t GetFreeCount() const
+			{
+				return _freeCount;
+			}
+
+			std::size_t GetBlockCount() const
+			{
+				return _blockCount;
 			}
 
 		private:
-			void allocateMemoryBlock()
+			BlockHeader* blockFromEntry(void* entry) const
+			{
+				if constexpr (CanFindBlock_v<BackendAllocator>)
+				{
+					return static_cast<BlockHeader*>(BackendAllocator::FindBlock(entry));
+				}
+				else
+				{
+					// Last block starting at or before the entry
+					return _blockIndex[indexPosition(entry) - 1];
+				}
+			}
+
+			// Position of the first block of the index starting after ptr
+			std::size_t indexPosition(const void* ptr) const
+			{
+				std::size_t low = 0;
+				std::size_t high = _blockCount;
+
+				while (low < high)
+				{
+					const std::size_t middle = low + (high - low) / 2;
+
+					if (static_cast<const void*>(_blockIndex[middle]) <= ptr)
+					{
+						low = middle + 1;
+					}
+					else
+					{
+						high = middle;
+					}
+				}
+
+				return low;
+			}
+
+			// Makes room in the index for one more block, doubling it from the BackendAllocator when it is full
+			bool growBlockIndex()
+			{
+				if (_blockCount < _blockIndexCapacity)
+				{
+					return true;
+				}
+
+				const std::size_t newCapacity = _blockIndexCapacity ? _blockIndexCapacity * 2 : InitialBlockIndexCapacity;
+				auto* newIndex = static_cast<BlockHeader**>(BackendAllocator::Allocate(newCapacity * sizeof(BlockHeader*)));
+
+				if (!newIndex)
+				{
+					return false;
+				}
+
+				if (_blockIndex)
+				{
+					std::memcpy(newIndex, _blockIndex, _blockCount * sizeof(BlockHeader*));
+					BackendAllocator::Deallocate(_blockIndex);
+				}
+
+				_blockIndex = newIndex;
+				_blockIndexCapacity = newCapacity;
+
+				return true;
+			}
+
+			// Gives the cached entries back to their blocks
+			void flushCache()
+			{
+				while (_cache)
+				{
+					void* entry = _cache;
+					_cache = *((void**)_cache);
+
+					BlockHeader* block = blockFromEntry(entry);
+
+					*(void**)entry = block->Free;
+					block->Free = entry;
+
+					// Blocks getting a free entry are filled first, empty blocks wait at the end to be released
+					if (block->LiveCount-- == EntriesPerBlock)
+					{
+						linkAvailableFront(block);
+					}
+
+					if (block->LiveCount == 0)
+					{
+						unlinkAvailable(block);
+
+						if (_freeCount > _highWaterMark)
+						{
+							releaseMemoryBlock(block);
+						}
+						else
+						{
+							linkAvailableBack(block);
+						}
+					}
+				}
+
+				_cacheCount = 0;
+			}
+
+			void linkAvailableFront(BlockHeader* block)
+			{
+				block->PreviousAvailable = nullptr;
+				block->NextAvailable = _available;
+
+				if (_available)
+				{
+					_available->PreviousAvailable = block;
+				}
+				else
+				{
+					_availableTail = block;
+				}
+
+				_available = block;
+			}
+
+			void linkAvailableBack(BlockHeader* block)
+			{
+				block->NextAvailable = nullptr;
+				block->PreviousAvailable = _availableTail;
+
+				if (_availableTail)
+				{
+					_availableTail->NextAvailable = block;
+				}
+				else
+				{
+					_available = block;
+				}
+
+				_availableTail = block;
+			}
+
+			void unlinkAvailable(BlockHeader* block)
+			{
+				(block->PreviousAvailable ? block->PreviousAvailable->NextAvailable : _available) = block->NextAvailable;
+				(block->NextAvailable ? block->NextAvailable->PreviousAvailable : _availableTail) = block->PreviousAvailable;
+			}
+
+			// The block must not be in the available list anymore
+			void releaseMemoryBlock(BlockHeader* block)
 			{
-				std::uint8_t* memoryBlock = reinterpret_cast<std::uint8_t*>(BackendAllocator::Allocate(EntrySize * PreAllocCount + sizeof(void*)));
+				(block->Previous ? block->Previous->Next : _blocks) = block->Next;
+
+				if (block->Next)
+				{
+					block->Next->Previous = block->Previous;
+				}
+
+				if constexpr (!CanFindBlock_v<BackendAllocator>)
+				{
+					const std::size_t position = indexPosition(block) - 1;
+					std::memmove(_blockIndex + position, _blockIndex + position + 1, (_blockCount - position - 1) * sizeof(BlockHeader*));
+				}
 
-				*(void**)memoryBlock = _blockAllocList;
-				_blockAllocList = memoryBlock;
+				--_blockCount;
+				_freeCount -= EntriesPerBlock;
 
-				memoryBlock += sizeof(std::uint8_t*);
+				BackendAllocator::Deallocate(block);
+			}
 
-				for (std::size_t i = 0; i < PreAllocCount; ++i)
+			bool allocateMemoryBlock()
+			{
+				if constexpr (!CanFindBlock_v<BackendAllocator>)
 				{
-					Deallocate(memoryBlock);
-					memoryBlock += EntrySize;
+					if (!growBlockIndex())
+					{
+						return false;
+					}
 				}
+
+				BlockHeader* block = nullptr;
+
+				if constexpr (EntryAlignment > DefaultAlignment)
+				{
+					block = static_cast<BlockHeader*>(BackendAllocator::Allocate(BlockSize, EntryAlignment));
+				}
+				else
+				{
+					block = static_cast<BlockHeader*>(BackendAllocator::Allocate(BlockSize));
+				}
+
+				if (!block)
+				{
+					return false;
+				}
+
+				if constexpr (!CanFindBlock_v<BackendAllocator>)
+				{
+					const std::size_t position = indexPosition(block);
+					std::memmove(_blockIndex + position + 1, _blockIndex + position, (_blockCount - position) * sizeof(BlockHeader*));
+					_blockIndex[position] = block;
+				}
+
+				block->Previous = nullptr;
+				block->Next = _blocks;
+
+				if (_blocks)
+				{
+					_blocks->Previous = block;
+				}
+
+				_blocks = block;
+				++_blockCount;
+
+				block->Free = nullptr;
+				block->LiveCount = 0;
+
+				auto* entry = reinterpret_cast<std::uint8_t*>(block) + HeaderSize;
+
+				for (std::size_t i = 0; i < EntriesPerBlock; ++i)
+				{
+					*(void**)entry = block->Free;
+					block->Free = entry;
+					entry += EntrySize;
+				}
+
+				_freeCount += EntriesPerBlock;
+
+				linkAvailableFront(block);
+
+				return true;
 			}
 
 		private:
-			void* _blockAllocList = nullptr;
-			void* _free = nullptr;
+			BlockHeader* _blocks = nullptr;
+			BlockHeader* _available = nullptr;
+			BlockHeader* _availableTail = nullptr;
+			void* _cache = nullptr;
+			std::size_t _cacheCount = 0;
+			std::size_t _freeCount = 0;
+			std::size_t _blockCount = 0;
+			std::size_t _highWaterMark = std::numeric_limits<std::size_t>::max();
+			// Blocks sorted by address, for backends without FindBlock()
+			BlockHeader** _blockIndex = nullptr;
+			std::size_t _blockIndexCapacity = 0;
+		};
+
+		template<typename BackendAllocator, std::size_t EntrySize, std::size_t PreAllocCount, std::size_t EntryAlignment>
+		struct HasFixedEntrySize<PoolAllocator<BackendAllocator, EntrySize, PreAllocCount, EntryAlignment>> : std::true_type
+		{
 		};
 
 		template<typename T, typename BackendAllocator, std::size_t PreAllocCount = 128>
-		using PoolObjectAllocator = Baroque::Memory::ObjectAllocator<T, PoolAllocator<BackendAllocator, sizeof(T), PreAllocCount>>;
+		using PoolObjectAllocator = Baroque::Memory::ObjectAllocator<T, PoolAllocator<BackendAllocator, sizeof(T), PreAllocCount, alignof(T)>>;
 	}
 }
\ No newline at end of file
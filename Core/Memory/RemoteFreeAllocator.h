@@ -0,0 +1,177 @@
+#pragma once
+
+#include "Core/CoreDefines.h"
+
+#include "Core/Algorithms/MinMax.h"
+#include "Core/Memory/AllocatorTraits.h"
+
+#include <atomic>
+#include <thread>
+
+namespace Baroque
+{
+	namespace Memory
+	{
+		// Lets a non thread-safe Allocator owned by one thread free its blocks from any thread.
+		// Blocks freed by other threads are pushed on a lock-free list that the owner gives back to
+		// the Allocator on its next Allocate() or FreeRemoteBlocks(). Only the owner thread can
+		// allocate and reallocate, the owner is the thread that created the allocator or called BindToCurrentThread().
+		// Blocks are at least a pointer big to be linked in the list.
+		template<typename Allocator>
+		class RemoteFreeAllocator : private Allocator
+		{
+		public:
+			static constexpr std::size_t StackCapacity = Allocator::StackCapacity;
+
+			RemoteFreeAllocator()
+			: _owner(std::this_thread::get_id())
+			{
+			}
+
+			RemoteFreeAllocator(const RemoteFreeAllocator&) = delete;
+			RemoteFreeAllocator& operator=(const RemoteFreeAllocator&) = delete;
+
+			~RemoteFreeAllocator()
+			{
+				FreeRemoteBlocks();
+			}
+
+			void* Allocate(const std::size_t size)
+			{
+				freeRemoteBlocksIfAny();
+
+				return Allocator::Allocate(Algorithm::Max(size, sizeof(void*)));
+			}
+
+			void* Allocate(const std::size_t size, const std::size_t alignment)
+			{
+				freeRemoteBlocksIfAny();
+
+				return Allocator::Allocate(Algorithm::Max(size, sizeof(void*)), alignment);
+			}
+
+			void Deallocate(void* ptr)
+			{
+				if (!ptr)
+				{
+					return;
+				}
+
+				if (IsOwnerThread())
+				{
+					Allocator::Deallocate(ptr);
+				}
+				else
+				{
+					pushRemoteBlock(ptr);
+				}
+			}
+
+			// The size is lost for the blocks freed by other threads
+			void Deallocate(void* ptr, const std::size_t size)
+			{
+				if (!ptr)
+				{
+					return;
+				}
+
+				if (IsOwnerThread())
+				{
+					DeallocateSized(static_cast<Allocator&>(*this), ptr, Algorithm::Max(size, sizeof(void*)));
+				}
+				else
+				{
+					pushRemoteBlock(ptr);
+				}
+			}
+
+			void* Reallocate(void* ptr, const std::size_t oldSize, const std::size_t newSize)
+			{
+				if constexpr (CanReallocate_v<Allocator>)
+				{
+					if (!IsOwnerThread())
+					{
+						return nullptr;
+					}
+
+					return Allocator::Reallocate(ptr, Algorithm::Max(oldSize, sizeof(void*)), Algorithm::Max(newSize, sizeof(void*)));
+				}
+				else
+				{
+					BAROQUE_UNUSED(ptr);
+					BAROQUE_UNUSED(oldSize);
+					BAROQUE_UNUSED(newSize);
+					return nullptr;
+				}
+			}
+
+			bool Owns(const void* ptr) const
+			{
+				return Allocator::Owns(ptr);
+			}
+
+			// Gives the blocks freed by other threads back to the Allocator, returns their number. Owner thread only.
+			std::size_t FreeRemoteBlocks()
+			{
+				void* block = _remoteBlocks.exchange(nullptr, std::memory_order_acquire);
+
+				std::size_t count = 0;
+
+				while (block)
+				{
+					void* next = *static_cast<void**>(block);
+
+					Allocator::Deallocate(block);
+
+					block = next;
+					++count;
+				}
+
+				return count;
+			}
+
+			// Hands the allocator over to the calling thread, the previous owner must not use it anymore.
+			// Other threads can keep freeing blocks meanwhile, they see either owner and both are remote for them.
+			void BindToCurrentThread()
+			{
+				_owner.store(std::this_thread::get_id(), std::memory_order_release);
+			}
+
+			bool IsOwnerThread() const
+			{
+				return std::this_thread::get_id() == _owner.load(std::memory_order_acquire);
+			}
+
+		private:
+			void freeRemoteBlocksIfAny()
+			{
+				if (_remoteBlocks.load(std::memory_order_relaxed))
+				{
+					FreeRemoteBlocks();
+				}
+			}
+
+			void pushRemoteBlock(void* ptr)
+			{
+				auto* head = _remoteBlocks.load(std::memory_order_relaxed);
+
+				do
+				{
+					*static_cast<void**>(ptr) = head;
+				}
+				while (!_remoteBlocks.compare_exchange_weak(head, ptr, std::memory_order_release, std::memory_order_relaxed));
+			}
+
+		private:
+			// Read by every freeing thread while BindToCurrentThread() can write it
+			std::atomic<std::thread::id> _owner;
+			// The owner takes the whole list at once, there is no ABA on a push-only stack
+			alignas(64) std::atomic<void*> _remoteBlocks{ nullptr };
+		};
+
+		template<typename Allocator>
+		struct CanReallocate<RemoteFreeAllocator<Allocator>> : CanReallocate<Allocator>
+		{
+		};
+	}
+}
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include "Core/CoreDefines.h"
 
+#include "Core/Memory/AllocatorTraits.h"
+
 namespace Baroque
 {
 	namespace Memory
@@ -24,6 +26,18 @@ namespace Baroque
 				}
 			}
 
+			void* Allocate(const std::size_t size, const std::size_t alignment)
+			{
+				if (size <= Threshold)
+				{
+					return SmallAllocator::Allocate(size, alignment);
+				}
+				else
+				{
+					return LargeAllocator::Allocate(size, alignment);
+				}
+			}
+
 			void Deallocate(void* ptr)
 			{
 				if (ptr)
@@ -39,6 +53,52 @@ namespace Baroque
 				}
 			}
 
+			// The size picks the allocator, SmallAllocator::Owns() is not needed
+			void Deallocate(void* ptr, const std::size_t size)
+			{
+				if (ptr)
+				{
+					if (size <= Threshold)
+					{
+						DeallocateSized(static_cast<SmallAllocator&>(*this), ptr, size);
+					}
+					else
+					{
+						DeallocateSized(static_cast<LargeAllocator&>(*this), ptr, size);
+					}
+				}
+			}
+
+			// Blocks only change allocator through Allocate, copy and Deallocate
+			void* Reallocate(void* ptr, const std::size_t oldSize, const std::size_t newSize)
+			{
+				if (!ptr || (oldSize <= Threshold) != (newSize <= Threshold))
+				{
+					return nullptr;
+				}
+
+				if (oldSize <= Threshold)
+				{
+					if constexpr (CanReallocate_v<SmallAllocator>)
+					{
+						return SmallAllocator::Reallocate(ptr, oldSize, newSize);
+					}
+					else
+					{
+						return nullptr;
+					}
+				}
+
+				if constexpr (CanReallocate_v<LargeAllocator>)
+				{
+					return LargeAllocator::Reallocate(ptr, oldSize, newSize);
+				}
+				else
+				{
+					return nullptr;
+				}
+			}
+
 			bool Owns(const void* ptr) const
 			{
 				return SmallAllocator::Owns(ptr) || LargeAllocator::Owns(ptr);
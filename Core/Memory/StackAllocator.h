@@ -2,6 +2,8 @@
 
 #include "Core/CoreDefines.h"
 
+#include "Core/Memory/Alignment.h"
+
 #include <atomic>
 
 namespace Baroque
@@ -19,19 +21,26 @@ namespace Baroque
 			{}
 
 			void* Allocate(const std::size_t size)
+			{
+				return Allocate(size, DefaultAlignment);
+			}
+
+			void* Allocate(const std::size_t size, const std::size_t alignment)
 			{
 				if (size > AllocSize)
 				{
 					return nullptr;
 				}
 
-				if ((_top + size) > (_storage + AllocSize))
+				auto* allocation = AlignUp(_top, alignment);
+
+				if (allocation > (_storage + AllocSize) || size > static_cast<std::size_t>((_storage + AllocSize) - allocation))
 				{
 					return nullptr;
 				}
 
-				_previous = _top;
-				_top += size;
+				_previous = allocation;
+				_top = allocation + size;
 				return _previous;
 			}
 
@@ -47,13 +56,27 @@ namespace Baroque
 				}
 			}
 
+			// Only the last allocation can grow or shrink, in place
+			void* Reallocate(void* ptr, const std::size_t oldSize, const std::size_t newSize)
+			{
+				BAROQUE_UNUSED(oldSize);
+
+				if (!ptr || ptr != _previous || newSize > static_cast<std::size_t>((_storage + AllocSize) - _previous))
+				{
+					return nullptr;
+				}
+
+				_top = _previous + newSize;
+				return ptr;
+			}
+
 			bool Owns(const void* ptr) const
 			{
 				return ptr >= _storage && ptr < (_storage + AllocSize);
 			}
 
 		private:
-			std::uint8_t _storage[AllocSize];
+			alignas(DefaultAlignment) std::uint8_t _storage[AllocSize];
 			std::uint8_t* _top = nullptr;
 			std::uint8_t* _previous = nullptr;
 		};
@@ -0,0 +1,91 @@
+#include "StatsAllocator.h"
+
+namespace Baroque
+{
+	namespace Memory
+	{
+		// Stats are only added, they live until the end of the program
+		struct AllocatorStatsRegistry
+		{
+			static void Add(AllocatorStats& stats)
+			{
+				auto* head = Head.load(std::memory_order_relaxed);
+
+				do
+				{
+					stats._next = head;
+				}
+				while (!Head.compare_exchange_weak(head, &stats, std::memory_order_release, std::memory_order_relaxed));
+			}
+
+			static void ForEach(AllocatorStatsCallback callback, void* userData)
+			{
+				for (auto* stats = Head.load(std::memory_order_acquire); stats; stats = stats->_next)
+				{
+					callback(*stats, userData);
+				}
+			}
+
+			static std::atomic<AllocatorStats*> Head;
+		};
+
+		std::atomic<AllocatorStats*> AllocatorStatsRegistry::Head{ nullptr };
+
+		AllocatorStats::AllocatorStats(const char* name)
+		: _name(name)
+		, _next(nullptr)
+		{
+			AllocatorStatsRegistry::Add(*this);
+		}
+
+		AllocatorStatsSnapshot AllocatorStats::GetSnapshot() const
+		{
+			AllocatorStatsSnapshot snapshot = {};
+			snapshot.Name = _name;
+
+			for (auto& slot : _slots)
+			{
+				snapshot.AllocationCount += slot.AllocationCount.load(std::memory_order_relaxed);
+				snapshot.DeallocationCount += slot.DeallocationCount.load(std::memory_order_relaxed);
+				snapshot.FailedAllocationCount += slot.FailedAllocationCount.load(std::memory_order_relaxed);
+				snapshot.ReallocationCount += slot.ReallocationCount.load(std::memory_order_relaxed);
+				snapshot.AllocatedBytes += slot.AllocatedBytes.load(std::memory_order_relaxed);
+				snapshot.DeallocatedBytes += slot.DeallocatedBytes.load(std::memory_order_relaxed);
+
+				for (std::size_t bucket = 0; bucket < AllocatorStatsHistogramBucketCount; ++bucket)
+				{
+					snapshot.SizeHistogram[bucket] += slot.SizeHistogram[bucket].load(std::memory_order_relaxed);
+				}
+			}
+
+			// The counters of a thread can be read in the middle of an update
+			snapshot.LiveBytes = snapshot.AllocatedBytes > snapshot.DeallocatedBytes ? snapshot.AllocatedBytes - snapshot.DeallocatedBytes : 0;
+
+			const auto peakLiveBytes = _peakLiveBytes.load(std::memory_order_relaxed);
+			snapshot.PeakLiveBytes = Algorithm::Max(snapshot.LiveBytes, peakLiveBytes > 0 ? static_cast<std::size_t>(peakLiveBytes) : std::size_t(0));
+
+			return snapshot;
+		}
+
+		void AllocatorStats::ResetPeak()
+		{
+			_peakLiveBytes.store(_liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		}
+
+		void AllocatorStats::publishLiveBytes(std::ptrdiff_t delta)
+		{
+			const auto liveBytes = _liveBytes.fetch_add(delta, std::memory_order_relaxed) + delta;
+
+			auto peakLiveBytes = _peakLiveBytes.load(std::memory_order_relaxed);
+
+			while (liveBytes > peakLiveBytes && !_peakLiveBytes.compare_exchange_weak(peakLiveBytes, liveBytes, std::memory_order_relaxed))
+			{
+			}
+		}
+
+		void ForEachAllocatorStats(AllocatorStatsCallback callback, void* userData)
+		{
+			AllocatorStatsRegistry::ForEach(callback, userData);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,336 @@
+#pragma once
+
+#include "Core/CoreDefines.h"
+
+#include "Core/Algorithms/MinMax.h"
+#include "Core/Memory/Alignment.h"
+#include "Core/Memory/AllocatorTraits.h"
+#include "Core/Threading/ThreadIndex.h"
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Baroque
+{
+	namespace Memory
+	{
+		// Bucket N of the size histogram counts the allocations of [2^N, 2^(N+1)) bytes, the last bucket also counts anything bigger
+		constexpr std::size_t AllocatorStatsHistogramBucketCount = 32;
+
+		struct AllocatorStatsSnapshot
+		{
+			const char* Name;
+			std::size_t AllocationCount;
+			std::size_t DeallocationCount;
+			// Allocations the allocator couldn't serve, like a stack allocator spilling to its fallback
+			std::size_t FailedAllocationCount;
+			std::size_t ReallocationCount;
+			std::size_t AllocatedBytes;
+			std::size_t DeallocatedBytes;
+			std::size_t LiveBytes;
+			std::size_t PeakLiveBytes;
+			std::size_t SizeHistogram[AllocatorStatsHistogramBucketCount];
+		};
+
+		// Counters of every StatsAllocator with the same Tag. Threads count in their own slot without atomic
+		// read-modify-write operations, threads without a thread index share a slot. The live bytes of a thread are
+		// added to the peak every PeakGranularity bytes, the peak is exact to PeakGranularity bytes per thread.
+		// The counters are exact once all threads are done allocating.
+		class BAROQUE_CORE_API AllocatorStats
+		{
+		public:
+			static constexpr std::ptrdiff_t PeakGranularity = 64 * 1024;
+
+			explicit AllocatorStats(const char* name);
+
+			AllocatorStats(const AllocatorStats&) = delete;
+			AllocatorStats& operator=(const AllocatorStats&) = delete;
+
+			void RecordAllocation(std::size_t size)
+			{
+				const auto threadIndex = GetThreadIndex();
+				auto& slot = _slots[threadIndex];
+				const bool shared = threadIndex == MaxThreadIndexCount;
+
+				add(slot.AllocationCount, 1, shared);
+				add(slot.AllocatedBytes, size, shared);
+				add(slot.SizeHistogram[histogramBucket(size)], 1, shared);
+				addLiveBytes(slot, static_cast<std::ptrdiff_t>(size), shared);
+			}
+
+			void RecordDeallocation(std::size_t size)
+			{
+				const auto threadIndex = GetThreadIndex();
+				auto& slot = _slots[threadIndex];
+				const bool shared = threadIndex == MaxThreadIndexCount;
+
+				add(slot.DeallocationCount, 1, shared);
+				add(slot.DeallocatedBytes, size, shared);
+				addLiveBytes(slot, -static_cast<std::ptrdiff_t>(size), shared);
+			}
+
+			void RecordReallocation(std::size_t oldSize, std::size_t newSize)
+			{
+				const auto threadIndex = GetThreadIndex();
+				auto& slot = _slots[threadIndex];
+				const bool shared = threadIndex == MaxThreadIndexCount;
+
+				add(slot.ReallocationCount, 1, shared);
+				add(slot.AllocatedBytes, newSize, shared);
+				add(slot.DeallocatedBytes, oldSize, shared);
+				addLiveBytes(slot, static_cast<std::ptrdiff_t>(newSize) - static_cast<std::ptrdiff_t>(oldSize), shared);
+			}
+
+			void RecordFailedAllocation()
+			{
+				const auto threadIndex = GetThreadIndex();
+
+				add(_slots[threadIndex].FailedAllocationCount, 1, threadIndex == MaxThreadIndexCount);
+			}
+
+			AllocatorStatsSnapshot GetSnapshot() const;
+
+			// Restarts the peak from the live bytes
+			void ResetPeak();
+
+			const char* GetName() const
+			{
+				return _name;
+			}
+
+		private:
+			struct alignas(64) Slot
+			{
+				std::atomic<std::size_t> AllocationCount{ 0 };
+				std::atomic<std::size_t> DeallocationCount{ 0 };
+				std::atomic<std::size_t> FailedAllocationCount{ 0 };
+				std::atomic<std::size_t> ReallocationCount{ 0 };
+				std::atomic<std::size_t> AllocatedBytes{ 0 };
+				std::atomic<std::size_t> DeallocatedBytes{ 0 };
+				// Live bytes not added to _liveBytes yet
+				std::atomic<std::ptrdiff_t> PendingLiveBytes{ 0 };
+				std::atomic<std::size_t> SizeHistogram[AllocatorStatsHistogramBucketCount] = {};
+			};
+
+			static std::size_t histogramBucket(std::size_t size)
+			{
+				if (size < 2)
+				{
+					return 0;
+				}
+
+#if defined(_MSC_VER)
+				unsigned long highestBit;
+				_BitScanReverse64(&highestBit, size);
+				const std::size_t bucket = highestBit;
+#else
+				const std::size_t bucket = sizeof(unsigned long long) * 8 - 1 - static_cast<std::size_t>(__builtin_clzll(size));
+#endif
+
+				return bucket < AllocatorStatsHistogramBucketCount ? bucket : AllocatorStatsHistogramBucketCount - 1;
+			}
+
+			// Only the owner thread writes its slot, the readers only need the stores to be atomic
+			static void add(std::atomic<std::size_t>& counter, std::size_t value, bool shared)
+			{
+				if (shared)
+				{
+					counter.fetch_add(value, std::memory_order_relaxed);
+				}
+				else
+				{
+					counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+				}
+			}
+
+			void addLiveBytes(Slot& slot, std::ptrdiff_t delta, bool shared)
+			{
+				if (shared)
+				{
+					publishLiveBytes(delta);
+					return;
+				}
+
+				const auto pending = slot.PendingLiveBytes.load(std::memory_order_relaxed) + delta;
+
+				if (pending >= PeakGranularity || pending <= -PeakGranularity)
+				{
+					slot.PendingLiveBytes.store(0, std::memory_order_relaxed);
+					publishLiveBytes(pending);
+				}
+				else
+				{
+					slot.PendingLiveBytes.store(pending, std::memory_order_relaxed);
+				}
+			}
+
+			void publishLiveBytes(std::ptrdiff_t delta);
+
+		private:
+			Slot _slots[MaxThreadIndexCount + 1];
+			std::atomic<std::ptrdiff_t> _liveBytes{ 0 };
+			std::atomic<std::ptrdiff_t> _peakLiveBytes{ 0 };
+			const char* _name;
+			AllocatorStats* _next;
+
+			friend struct AllocatorStatsRegistry;
+		};
+
+		using AllocatorStatsCallback = void(*)(const AllocatorStats& stats, void* userData);
+
+		// Visits the stats of every StatsAllocator used so far
+		BAROQUE_CORE_API void ForEachAllocatorStats(AllocatorStatsCallback callback, void* userData);
+
+		template<typename Function>
+		void ForEachAllocatorStats(Function&& function)
+		{
+			ForEachAllocatorStats([](const AllocatorStats& stats, void* userData)
+			{
+				(*static_cast<std::remove_reference_t<Function>*>(userData))(stats);
+			}, &function);
+		}
+
+		template<typename Tag, typename = void>
+		struct AllocatorStatsName
+		{
+			static constexpr const char* Value = "Unnamed";
+		};
+
+		template<typename Tag>
+		struct AllocatorStatsName<Tag, std::void_t<decltype(Tag::Name)>>
+		{
+			static constexpr const char* Value = Tag::Name;
+		};
+
+		// Counts the allocations of Allocator in the AllocatorStats of Tag, in every build configuration.
+		// The stats are named by a static constexpr const char* Name member of Tag when it has one.
+		// The requested size is kept in a header before every block, it is given to the Allocator on deallocation.
+		template<typename Allocator, typename Tag = Allocator>
+		class StatsAllocator : private Allocator
+		{
+			static_assert(!HasFixedEntrySize_v<Allocator>, "The size header would overflow the fixed size entries of Allocator");
+
+		public:
+			static constexpr std::size_t HeaderSize = DefaultAlignment;
+			static constexpr std::size_t StackCapacity = Allocator::StackCapacity > HeaderSize ? Allocator::StackCapacity - HeaderSize : 0;
+
+			void* Allocate(const std::size_t size)
+			{
+				void* block = size <= std::numeric_limits<std::size_t>::max() - HeaderSize ? Allocator::Allocate(size + HeaderSize) : nullptr;
+
+				return finishAllocation(block, size, HeaderSize);
+			}
+
+			void* Allocate(const std::size_t size, const std::size_t alignment)
+			{
+				const auto headerSize = Algorithm::Max(HeaderSize, alignment);
+
+				void* block = size <= std::numeric_limits<std::size_t>::max() - headerSize ? Allocator::Allocate(size + headerSize, alignment) : nullptr;
+
+				return finishAllocation(block, size, headerSize);
+			}
+
+			void Deallocate(void* ptr)
+			{
+				if (!ptr)
+				{
+					return;
+				}
+
+				const auto* header = getHeader(ptr);
+
+				GetStats().RecordDeallocation(header->Size);
+
+				DeallocateSized(static_cast<Allocator&>(*this), static_cast<std::uint8_t*>(ptr) - header->Offset, header->Size + header->Offset);
+			}
+
+			void* Reallocate(void* ptr, const std::size_t oldSize, const std::size_t newSize)
+			{
+				BAROQUE_UNUSED(oldSize);
+
+				if (!ptr || newSize > std::numeric_limits<std::size_t>::max() - HeaderSize)
+				{
+					return nullptr;
+				}
+
+				auto* header = getHeader(ptr);
+
+				// Over-aligned blocks would lose their alignment if they moved
+				if (header->Offset != HeaderSize)
+				{
+					return nullptr;
+				}
+
+				const auto previousSize = header->Size;
+
+				auto* block = static_cast<std::uint8_t*>(Allocator::Reallocate(static_cast<std::uint8_t*>(ptr) - HeaderSize, previousSize + HeaderSize, newSize + HeaderSize));
+				if (!block)
+				{
+					return nullptr;
+				}
+
+				GetStats().RecordReallocation(previousSize, newSize);
+
+				getHeader(block + HeaderSize)->Size = newSize;
+
+				return block + HeaderSize;
+			}
+
+			bool Owns(const void* ptr) const
+			{
+				return Allocator::Owns(ptr);
+			}
+
+			static AllocatorStats& GetStats()
+			{
+				static AllocatorStats stats(AllocatorStatsName<Tag>::Value);
+				return stats;
+			}
+
+		private:
+			struct Header
+			{
+				std::size_t Size;
+				// Distance from the start of the block
+				std::size_t Offset;
+			};
+
+			static_assert(sizeof(Header) <= HeaderSize, "The header must fit before the allocation");
+
+			static Header* getHeader(void* ptr)
+			{
+				return static_cast<Header*>(ptr) - 1;
+			}
+
+			void* finishAllocation(void* block, std::size_t size, std::size_t headerSize)
+			{
+				if (!block)
+				{
+					GetStats().RecordFailedAllocation();
+					return nullptr;
+				}
+
+				auto* ptr = static_cast<std::uint8_t*>(block) + headerSize;
+
+				auto* header = getHeader(ptr);
+				header->Size = size;
+				header->Offset = headerSize;
+
+				GetStats().RecordAllocation(size);
+
+				return ptr;
+			}
+		};
+
+		template<typename Allocator, typename Tag>
+		struct CanReallocate<StatsAllocator<Allocator, Tag>> : CanReallocate<Allocator>
+		{
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,634 @@
+#include "ThreadCachingAllocator.h"
+
+#include "Core/Algorithms/MinMax.h"
+#include "Core/Memory/Alignment.h"
+#include "Core/Memory/MemorySize.h"
+#include "Core/Memory/VirtualMemoryAllocator.h"
+#include "Core/Threading/Mutex.h"
+
+#include <atomic>
+
+namespace Baroque
+{
+	namespace Memory
+	{
+		using namespace Literals;
+
+		// Memory is handed to the size classes in chunks aligned on their size. The size class of a block
+		// is found from its address in the chunk map, blocks don't have any header.
+		constexpr std::size_t ChunkShift = 16;
+		constexpr std::size_t ChunkSize = std::size_t(1) << ChunkShift;
+		constexpr std::size_t ChunksPerSlab = 64;
+
+		// The chunk map covers 48 bits of address space with two levels
+		constexpr std::size_t ChunkMapLevelBits = 16;
+		constexpr std::size_t ChunkMapLevelSize = std::size_t(1) << ChunkMapLevelBits;
+
+		constexpr std::uint8_t NotOwnedSizeClass = 0;
+		constexpr std::uint8_t LargeSizeClass = 255;
+
+		// Sizes up to 128 bytes use 16 bytes steps, then 4 size classes per power of two up to MaxSmallSize
+		constexpr std::size_t MaxSmallSize = 32_KB;
+		constexpr std::size_t SizeClassCount = 1 + 8 + 4 * 8;
+		constexpr std::size_t SmallLookupStepShift = 4;
+		constexpr std::size_t SmallLookupMaxSize = 1024;
+		constexpr std::size_t MediumLookupStepShift = 7;
+
+		// Number of blocks moved between a thread cache and the central free list at once
+		constexpr std::size_t BatchBytes = 64_KB;
+		constexpr std::size_t MinBatchSize = 2;
+		constexpr std::size_t MaxBatchSize = 32;
+
+		// Large allocations keep a header at the start of their first chunk, the returned pointer is after it
+		// in the same chunk. Address space is reserved past the committed pages so they can grow in place.
+		struct LargeHeader
+		{
+			std::uint8_t* Reservation;
+			std::size_t ReservationSize;
+			// Committed bytes from the start of the chunk
+			std::size_t CommittedSize;
+		};
+
+		constexpr std::size_t LargeHeaderSize = 64;
+		constexpr std::size_t MaxLargeGrowthSize = 1_GB;
+		constexpr std::size_t MaxAlignment = ChunkSize / 2;
+
+		constexpr std::size_t CacheLineSize = 64;
+
+		static_assert(SizeClassCount < LargeSizeClass, "Size classes must fit in the chunk map");
+		static_assert(MaxSmallSize <= ChunkSize / MinBatchSize, "A chunk must contain a full batch of the biggest size class");
+
+		struct SizeClassTable
+		{
+			std::uint32_t Sizes[SizeClassCount] = {};
+			std::uint32_t BatchSizes[SizeClassCount] = {};
+			std::uint8_t SmallLookup[(SmallLookupMaxSize >> SmallLookupStepShift) + 1] = {};
+			std::uint8_t MediumLookup[(MaxSmallSize >> MediumLookupStepShift) + 1] = {};
+		};
+
+		constexpr SizeClassTable MakeSizeClassTable()
+		{
+			SizeClassTable table;
+
+			// Size class 0 is NotOwnedSizeClass
+			std::size_t count = 1;
+
+			for (std::size_t size = 16; size <= 128; size += 16)
+			{
+				table.Sizes[count++] = static_cast<std::uint32_t>(size);
+			}
+
+			for (std::size_t powerOfTwo = 128; powerOfTwo < MaxSmallSize; powerOfTwo *= 2)
+			{
+				for (std::size_t quarter = 5; quarter <= 8; ++quarter)
+				{
+					table.Sizes[count++] = static_cast<std::uint32_t>(powerOfTwo * quarter / 4);
+				}
+			}
+
+			for (std::size_t sizeClass = 1; sizeClass < SizeClassCount; ++sizeClass)
+			{
+				table.BatchSizes[sizeClass] = static_cast<std::uint32_t>(Algorithm::Max(MinBatchSize, Algorithm::Min(MaxBatchSize, BatchBytes / table.Sizes[sizeClass])));
+			}
+
+			std::size_t sizeClass = 1;
+			for (std::size_t index = 0; index < sizeof(table.SmallLookup); ++index)
+			{
+				while (table.Sizes[sizeClass] < (index << SmallLookupStepShift))
+				{
+					++sizeClass;
+				}
+
+				table.SmallLookup[index] = static_cast<std::uint8_t>(sizeClass);
+			}
+
+			sizeClass = 1;
+			for (std::size_t index = 0; index < sizeof(table.MediumLookup); ++index)
+			{
+				while (table.Sizes[sizeClass] < (index << MediumLookupStepShift))
+				{
+					++sizeClass;
+				}
+
+				table.MediumLookup[index] = static_cast<std::uint8_t>(sizeClass);
+			}
+
+			return table;
+		}
+
+		constexpr SizeClassTable SizeClasses = MakeSizeClassTable();
+
+		static_assert(SizeClasses.Sizes[SizeClassCount - 1] == MaxSmallSize, "The last size class must be MaxSmallSize");
+
+		std::size_t GetSizeClass(std::size_t size)
+		{
+			if (size <= SmallLookupMaxSize)
+			{
+				return SizeClasses.SmallLookup[(size + (1 << SmallLookupStepShift) - 1) >> SmallLookupStepShift];
+			}
+
+			return SizeClasses.MediumLookup[(size + (1 << MediumLookupStepShift) - 1) >> MediumLookupStepShift];
+		}
+
+		void*& NextFreeBlock(void* block)
+		{
+			return *static_cast<void**>(block);
+		}
+
+		std::atomic<std::uint8_t*> ChunkMap[ChunkMapLevelSize];
+		Mutex ChunkMapLock;
+
+		std::uint8_t GetChunkSizeClass(const void* ptr)
+		{
+			const auto chunkIndex = reinterpret_cast<std::uintptr_t>(ptr) >> ChunkShift;
+
+			if (chunkIndex >> (2 * ChunkMapLevelBits))
+			{
+				return NotOwnedSizeClass;
+			}
+
+			auto* chunkMapLeaf = ChunkMap[chunkIndex >> ChunkMapLevelBits].load(std::memory_order_acquire);
+
+			return chunkMapLeaf ? chunkMapLeaf[chunkIndex & (ChunkMapLevelSize - 1)] : NotOwnedSizeClass;
+		}
+
+		bool SetChunkSizeClass(const void* chunk, std::uint8_t sizeClass)
+		{
+			const auto chunkIndex = reinterpret_cast<std::uintptr_t>(chunk) >> ChunkShift;
+
+			if (chunkIndex >> (2 * ChunkMapLevelBits))
+			{
+				return false;
+			}
+
+			auto& chunkMapEntry = ChunkMap[chunkIndex >> ChunkMapLevelBits];
+			auto* chunkMapLeaf = chunkMapEntry.load(std::memory_order_acquire);
+
+			if (!chunkMapLeaf)
+			{
+				Baroque::AutoLock autoLock(ChunkMapLock);
+
+				chunkMapLeaf = chunkMapEntry.load(std::memory_order_relaxed);
+				if (!chunkMapLeaf)
+				{
+					// VirtualMemoryAllocator memory is zero-filled by the OS, every chunk starts as NotOwnedSizeClass
+					chunkMapLeaf = static_cast<std::uint8_t*>(VirtualMemoryAllocator{}.Allocate(ChunkMapLevelSize));
+					if (!chunkMapLeaf)
+					{
+						return false;
+					}
+
+					chunkMapEntry.store(chunkMapLeaf, std::memory_order_release);
+				}
+			}
+
+			chunkMapLeaf[chunkIndex & (ChunkMapLevelSize - 1)] = sizeClass;
+
+			return true;
+		}
+
+		// Chunks are cut from bigger slabs that are never given back to the system
+		struct ChunkSource
+		{
+			Mutex Lock;
+			std::uint8_t* Next = nullptr;
+			std::uint8_t* End = nullptr;
+		};
+
+		ChunkSource Chunks;
+
+		std::uint8_t* AllocateChunk(std::uint8_t sizeClass)
+		{
+			std::uint8_t* chunk = nullptr;
+
+			{
+				Baroque::AutoLock autoLock(Chunks.Lock);
+
+				if (Chunks.Next == Chunks.End)
+				{
+					// One more chunk to align the slab, the unused pages are never touched
+					auto* slab = static_cast<std::uint8_t*>(VirtualMemoryAllocator{}.Allocate(ChunksPerSlab * ChunkSize + ChunkSize));
+					if (!slab)
+					{
+						return nullptr;
+					}
+
+					Chunks.Next = AlignUp(slab, ChunkSize);
+					Chunks.End = Chunks.Next + ChunksPerSlab * ChunkSize;
+				}
+
+				chunk = Chunks.Next;
+				Chunks.Next += ChunkSize;
+			}
+
+			return SetChunkSizeClass(chunk, sizeClass) ? chunk : nullptr;
+		}
+
+		struct alignas(CacheLineSize) CentralFreeList
+		{
+			Mutex Lock;
+			void* Free = nullptr;
+		};
+
+		CentralFreeList CentralFreeLists[SizeClassCount];
+
+		// Returns the number of blocks linked from head, up to count
+		std::size_t FetchFromCentralFreeList(std::size_t sizeClass, std::size_t count, void*& head)
+		{
+			auto& centralFreeList = CentralFreeLists[sizeClass];
+
+			Baroque::AutoLock autoLock(centralFreeList.Lock);
+
+			if (!centralFreeList.Free)
+			{
+				auto* chunk = AllocateChunk(static_cast<std::uint8_t>(sizeClass));
+				if (!chunk)
+				{
+					return 0;
+				}
+
+				const std::size_t blockSize = SizeClasses.Sizes[sizeClass];
+
+				// Linked backward so the blocks are handed out in address order
+				void* free = nullptr;
+				for (auto blockIndex = ChunkSize / blockSize; blockIndex-- > 0;)
+				{
+					void* block = chunk + blockIndex * blockSize;
+					NextFreeBlock(block) = free;
+					free = block;
+				}
+
+				centralFreeList.Free = free;
+			}
+
+			head = centralFreeList.Free;
+
+			void* tail = head;
+			std::size_t fetchedCount = 1;
+
+			while (fetchedCount < count && NextFreeBlock(tail))
+			{
+				tail = NextFreeBlock(tail);
+				++fetchedCount;
+			}
+
+			centralFreeList.Free = NextFreeBlock(tail);
+			NextFreeBlock(tail) = nullptr;
+
+			return fetchedCount;
+		}
+
+		void ReleaseToCentralFreeList(std::size_t sizeClass, void* head, void* tail)
+		{
+			auto& centralFreeList = CentralFreeLists[sizeClass];
+
+			Baroque::AutoLock autoLock(centralFreeList.Lock);
+
+			NextFreeBlock(tail) = centralFreeList.Free;
+			centralFreeList.Free = head;
+		}
+
+		enum class ThreadCacheState : std::uint8_t
+		{
+			Uninitialized,
+			Active,
+			// The thread is exiting, blocks go straight to the central free lists
+			Released
+		};
+
+		struct ThreadCacheFreeList
+		{
+			void* Head;
+			std::uint32_t Count;
+		};
+
+		struct ThreadCache
+		{
+			ThreadCacheFreeList FreeLists[SizeClassCount];
+			ThreadCacheState State;
+		};
+
+		// Moves count blocks from the front of the thread free list to the central free list
+		void ReleaseThreadCacheBlocks(ThreadCacheFreeList& freeList, std::size_t sizeClass, std::size_t count)
+		{
+			void* head = freeList.Head;
+			void* tail = head;
+
+			for (std::size_t index = 1; index < count; ++index)
+			{
+				tail = NextFreeBlock(tail);
+			}
+
+			freeList.Head = NextFreeBlock(tail);
+			freeList.Count -= static_cast<std::uint32_t>(count);
+
+			ReleaseToCentralFreeList(sizeClass, head, tail);
+		}
+
+		// The cache itself is trivial so it never needs a dynamic initialization,
+		// the releaser gives its blocks back when the thread exits.
+		thread_local ThreadCache LocalThreadCache;
+
+		struct ThreadCacheReleaser
+		{
+			~ThreadCacheReleaser()
+			{
+				if (!Cache)
+				{
+					return;
+				}
+
+				for (std::size_t sizeClass = 1; sizeClass < SizeClassCount; ++sizeClass)
+				{
+					auto& freeList = Cache->FreeLists[sizeClass];
+
+					if (freeList.Count)
+					{
+						ReleaseThreadCacheBlocks(freeList, sizeClass, freeList.Count);
+					}
+				}
+
+				Cache->State = ThreadCacheState::Released;
+			}
+
+			ThreadCache* Cache = nullptr;
+		};
+
+		thread_local ThreadCacheReleaser LocalThreadCacheReleaser;
+
+		void ActivateThreadCache(ThreadCache& threadCache)
+		{
+			threadCache.State = ThreadCacheState::Active;
+			LocalThreadCacheReleaser.Cache = &threadCache;
+		}
+
+		void* AllocateLarge(std::size_t size, std::size_t alignment)
+		{
+			const auto headerSize = Algorithm::Max(LargeHeaderSize, alignment);
+			const auto pageSize = VirtualMemoryAllocator::GetPageSize();
+
+			if (size > std::numeric_limits<std::size_t>::max() / 4)
+			{
+				return nullptr;
+			}
+
+			// Reserving as much again lets a growing container double once without copying
+			const auto committedSize = AlignUp(headerSize + size, pageSize);
+			const auto growthSize = Algorithm::Min(committedSize, MaxLargeGrowthSize);
+
+			// The aligned chunk must be fully inside the reservation so no other pointer can map to it
+			const auto reservationSize = Algorithm::Max(committedSize + growthSize, ChunkSize) + ChunkSize;
+
+			auto* reservation = static_cast<std::uint8_t*>(VirtualMemoryAllocator::Reserve(reservationSize));
+			if (!reservation)
+			{
+				return nullptr;
+			}
+
+			auto* chunk = AlignUp(reservation, ChunkSize);
+
+			if (!VirtualMemoryAllocator::Commit(chunk, committedSize) || !SetChunkSizeClass(chunk, LargeSizeClass))
+			{
+				VirtualMemoryAllocator::Release(reservation, reservationSize);
+				return nullptr;
+			}
+
+			auto* header = reinterpret_cast<LargeHeader*>(chunk);
+			header->Reservation = reservation;
+			header->ReservationSize = reservationSize;
+			header->CommittedSize = committedSize;
+
+			return chunk + headerSize;
+		}
+
+		void* ReallocateLarge(void* ptr, std::size_t newSize)
+		{
+			auto* chunk = AlignDown(static_cast<std::uint8_t*>(ptr), ChunkSize);
+			auto* header = reinterpret_cast<LargeHeader*>(chunk);
+
+			const auto offset = static_cast<std::size_t>(static_cast<std::uint8_t*>(ptr) - chunk);
+			const auto availableSize = static_cast<std::size_t>(header->Reservation + header->ReservationSize - chunk) - offset;
+
+			if (newSize > availableSize)
+			{
+				return nullptr;
+			}
+
+			const auto committedSize = AlignUp(offset + newSize, VirtualMemoryAllocator::GetPageSize());
+
+			if (committedSize > header->CommittedSize)
+			{
+				if (!VirtualMemoryAllocator::Commit(chunk + header->CommittedSize, committedSize - header->CommittedSize))
+				{
+					return nullptr;
+				}
+
+				header->CommittedSize = committedSize;
+			}
+
+			return ptr;
+		}
+
+		void DeallocateLarge(void* ptr)
+		{
+			auto* chunk = AlignDown(static_cast<std::uint8_t*>(ptr), ChunkSize);
+			const auto* header = reinterpret_cast<const LargeHeader*>(chunk);
+
+			SetChunkSizeClass(chunk, NotOwnedSizeClass);
+
+			VirtualMemoryAllocator::Release(header->Reservation, header->ReservationSize);
+		}
+
+		void* AllocateSlow(ThreadCache& threadCache, std::size_t sizeClass)
+		{
+			if (threadCache.State == ThreadCacheState::Released)
+			{
+				void* block = nullptr;
+				return FetchFromCentralFreeList(sizeClass, 1, block) ? block : nullptr;
+			}
+
+			if (threadCache.State == ThreadCacheState::Uninitialized)
+			{
+				ActivateThreadCache(threadCache);
+			}
+
+			void* head = nullptr;
+			const auto fetchedCount = FetchFromCentralFreeList(sizeClass, SizeClasses.BatchSizes[sizeClass], head);
+
+			if (!fetchedCount)
+			{
+				return nullptr;
+			}
+
+			auto& freeList = threadCache.FreeLists[sizeClass];
+			freeList.Head = NextFreeBlock(head);
+			freeList.Count = static_cast<std::uint32_t>(fetchedCount - 1);
+
+			return head;
+		}
+
+		void DeallocateSlow(ThreadCache& threadCache, std::size_t sizeClass, void* ptr)
+		{
+			if (threadCache.State == ThreadCacheState::Released)
+			{
+				ReleaseToCentralFreeList(sizeClass, ptr, ptr);
+				return;
+			}
+
+			if (threadCache.State == ThreadCacheState::Uninitialized)
+			{
+				ActivateThreadCache(threadCache);
+			}
+
+			auto& freeList = threadCache.FreeLists[sizeClass];
+
+			NextFreeBlock(ptr) = freeList.Head;
+			freeList.Head = ptr;
+			++freeList.Count;
+
+			// Keep one batch in the cache so alternating allocations and frees don't bounce on the central free list
+			const std::size_t batchSize = SizeClasses.BatchSizes[sizeClass];
+
+			if (freeList.Count > 2 * batchSize)
+			{
+				ReleaseThreadCacheBlocks(freeList, sizeClass, batchSize);
+			}
+		}
+
+		void* AllocateFromSizeClass(std::size_t sizeClass)
+		{
+			auto& threadCache = LocalThreadCache;
+			auto& freeList = threadCache.FreeLists[sizeClass];
+
+			if (void* block = freeList.Head)
+			{
+				freeList.Head = NextFreeBlock(block);
+				--freeList.Count;
+				return block;
+			}
+
+			return AllocateSlow(threadCache, sizeClass);
+		}
+
+		void* ThreadCachingAllocator::Allocate(const std::size_t size)
+		{
+			if (size > MaxSmallSize)
+			{
+				return AllocateLarge(size, LargeHeaderSize);
+			}
+
+			return AllocateFromSizeClass(GetSizeClass(size));
+		}
+
+		void* ThreadCachingAllocator::Allocate(const std::size_t size, const std::size_t alignment)
+		{
+			if (alignment <= DefaultAlignment)
+			{
+				return Allocate(size);
+			}
+
+			if (alignment > MaxAlignment)
+			{
+				return nullptr;
+			}
+
+			// Blocks are laid out from the start of their chunk, a size class that is a multiple of
+			// the alignment only has aligned blocks. Power of two size classes end the search.
+			for (auto alignedSize = AlignUp(size, alignment); alignedSize <= MaxSmallSize;)
+			{
+				const auto sizeClass = GetSizeClass(alignedSize);
+				const std::size_t sizeClassSize = SizeClasses.Sizes[sizeClass];
+
+				if (sizeClassSize % alignment == 0)
+				{
+					return AllocateFromSizeClass(sizeClass);
+				}
+
+				alignedSize = AlignUp(sizeClassSize + 1, alignment);
+			}
+
+			return AllocateLarge(size, alignment);
+		}
+
+		void ThreadCachingAllocator::Deallocate(void* ptr)
+		{
+			if (!ptr)
+			{
+				return;
+			}
+
+			const auto sizeClass = GetChunkSizeClass(ptr);
+
+			if (sizeClass == LargeSizeClass)
+			{
+				DeallocateLarge(ptr);
+				return;
+			}
+
+			auto& threadCache = LocalThreadCache;
+			auto& freeList = threadCache.FreeLists[sizeClass];
+
+			if (threadCache.State == ThreadCacheState::Active && freeList.Count < 2 * SizeClasses.BatchSizes[sizeClass])
+			{
+				NextFreeBlock(ptr) = freeList.Head;
+				freeList.Head = ptr;
+				++freeList.Count;
+				return;
+			}
+
+			DeallocateSlow(threadCache, sizeClass, ptr);
+		}
+
+		void ThreadCachingAllocator::Deallocate(void* ptr, const std::size_t size)
+		{
+			// Smaller sizes can be in a bigger size class or in a large block when they were aligned
+			if (ptr && size > MaxSmallSize)
+			{
+				DeallocateLarge(ptr);
+				return;
+			}
+
+			Deallocate(ptr);
+		}
+
+		void* ThreadCachingAllocator::Reallocate(void* ptr, const std::size_t oldSize, const std::size_t newSize)
+		{
+			BAROQUE_UNUSED(oldSize);
+
+			if (!ptr)
+			{
+				return nullptr;
+			}
+
+			const auto sizeClass = GetChunkSizeClass(ptr);
+
+			if (sizeClass == LargeSizeClass)
+			{
+				return ReallocateLarge(ptr, newSize);
+			}
+
+			// Moving to another size class is no better than allocating and copying
+			return newSize <= SizeClasses.Sizes[sizeClass] ? ptr : nullptr;
+		}
+
+		std::size_t ThreadCachingAllocator::GetAllocationSize(const std::size_t size)
+		{
+			if (size <= MaxSmallSize)
+			{
+				return SizeClasses.Sizes[GetSizeClass(size)];
+			}
+
+			if (size > std::numeric_limits<std::size_t>::max() / 4)
+			{
+				return size;
+			}
+
+			return AlignUp(LargeHeaderSize + size, VirtualMemoryAllocator::GetPageSize()) - LargeHeaderSize;
+		}
+
+		bool ThreadCachingAllocator::Owns(const void* ptr) const
+		{
+			return GetChunkSizeClass(ptr) != NotOwnedSizeClass;
+		}
+	}
+}
\ No newline at end of file
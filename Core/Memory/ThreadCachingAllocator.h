@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Core/CoreDefines.h"
+
+namespace Baroque
+{
+	namespace Memory
+	{
+		// General purpose allocator with size classes and a cache of free blocks per thread.
+		// Small allocations are served from the thread cache without any lock, the thread caches
+		// exchange batches of blocks with a central free list per size class. Memory is taken from
+		// the system in chunks dedicated to one size class, bigger allocations go to the system directly.
+		// Blocks can be freed by any thread. Blocks are aligned on DefaultAlignment, or on their size class
+		// when it is a multiple of the requested alignment.
+		class BAROQUE_CORE_API ThreadCachingAllocator
+		{
+		public:
+			static constexpr std::size_t StackCapacity = 0;
+
+			void* Allocate(const std::size_t size);
+			// Alignments up to 32 KB are supported
+			void* Allocate(const std::size_t size, const std::size_t alignment);
+			void Deallocate(void* ptr);
+			// Blocks over the small sizes are freed without looking up their chunk
+			void Deallocate(void* ptr, const std::size_t size);
+			// Grows or shrinks in place when the size class or the pages reserved after a large block allow it
+			void* Reallocate(void* ptr, const std::size_t oldSize, const std::size_t newSize);
+			bool Owns(const void* ptr) const;
+
+			// Size of the size class or of the committed pages of a block of size bytes
+			static std::size_t GetAllocationSize(const std::size_t size);
+		};
+	}
+}
\ No newline at end of file
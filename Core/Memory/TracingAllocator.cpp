@@ -1,171 +1,575 @@
 #include "TracingAllocator.h"
 
-#if defined(BAROQUE_TRACE_MEMORY)
+#if defined(BAROQUE_TRACING_ALLOCATOR)
 #include "Core/Memory/PoolAllocator.h"
 #include "Core/Memory/VirtualMemoryAllocator.h"
+#include "Core/Algorithms/MinMax.h"
 #include "Core/Hashing/PointerHash.h"
-#include "Core/Threading/ReaderWriterLock.h"
+#include "Core/Threading/Mutex.h"
 #include "Core/Memory/MemorySize.h"
 
+#include <cstdio>
+#include <cstdlib>
+
+#if defined(BAROQUE_SAMPLE_MEMORY)
+#include <cmath>
+#endif
+
 namespace Baroque
 {
 	namespace Memory
 	{
 		using namespace Literals;
 
-		constexpr std::size_t AllocationInfoTableSize = 16 * 1024;
+		// The allocation table is split in shards selected by the high bits of the pointer hash,
+		// each shard has its own lock and open-addressing table so threads allocating at the same
+		// time rarely touch the same lock or cache lines.
+		constexpr std::size_t AllocationShardCountBits = 6;
+		constexpr std::size_t AllocationShardCount = std::size_t(1) << AllocationShardCountBits;
+		constexpr std::size_t InitialAllocationShardTableSize = 1024;
 		constexpr std::size_t TraceMemoryCategoryTableSize = 128;
 
+		// Number of old table slots moved to the new table on each register/unregister while a shard is growing.
+		// A grow happens at half load and doubles the capacity, so the migration of the old table is always done
+		// long before the next grow (capacity / 2 inserts * MigrationStepSize >= old capacity).
+		constexpr std::size_t MigrationStepSize = 8;
+
 		constexpr std::size_t PageSize = 64_KB;
+		constexpr std::size_t CacheLineSize = 64;
+
+		static_assert((InitialAllocationShardTableSize & (InitialAllocationShardTableSize - 1)) == 0, "The Allocation Shard Table must be a power of two");
+		static_assert((TraceMemoryCategoryTableSize & (TraceMemoryCategoryTableSize - 1)) == 0, "The Debug Memory Category Info Table must be a power of two");
+		static_assert(MigrationStepSize >= 2, "The migration must be done before the next grow");
+
+#if defined(BAROQUE_SAMPLE_MEMORY)
+		constexpr std::size_t DefaultSamplingInterval = 512_KB;
+		constexpr std::size_t SampledAllocationFilterSize = 16 * 1024;
+
+		static_assert((SampledAllocationFilterSize & (SampledAllocationFilterSize - 1)) == 0, "The Sampled Allocation Filter must be a power of two");
+#endif
+
+		struct AllocationSlot
+		{
+			const void* Allocation;
+			AllocationInfo* Info;
+		};
 
-		static_assert((AllocationInfoTableSize& (AllocationInfoTableSize - 1)) == 0, "The Allocation Info Table must be a power of two");
-		static_assert((TraceMemoryCategoryTableSize& (TraceMemoryCategoryTableSize - 1)) == 0, "The Debug Memory Category Info Table must be a power of two");
+		struct AllocationTable
+		{
+			AllocationSlot* Slots = nullptr;
+			std::size_t Capacity = 0;
+		};
 
-		struct AllocationInfoNode : public AllocationInfo
+		// Marks an entry removed from a table being migrated, probing continues past it
+		const void* const TombstoneAllocation = reinterpret_cast<const void*>(std::uintptr_t(1));
+
+		// PoolAllocator blocks are rounded up to a power of two, half a page of entries gives one page blocks
+		using AllocationInfoAllocatorType = PoolObjectAllocator<AllocationInfo, VirtualMemoryAllocator, PageSize / 2 / sizeof(AllocationInfo)>;
+
+		struct alignas(CacheLineSize) AllocationShard
 		{
-			AllocationInfoNode* Next;
+			Mutex Lock;
+			AllocationInfoAllocatorType InfoAllocator;
+			AllocationTable Table;
+			// Previous table while its entries are moved to Table, only removals are done on it
+			AllocationTable OldTable;
+			std::size_t MigrationIndex = 0;
+			std::size_t Count = 0;
 		};
 
-		struct TraceMemoryCategoryNode : public TraceMemoryCategoryInfo
+		AllocationShard AllocationShards[AllocationShardCount];
+
+		// Categories are looked up without a lock, only the insertion of a new category is serialized.
+		// A slot is published by storing its key after its info is initialized.
+		std::atomic<const TraceMemoryCategory*> TraceCategoryKeys[TraceMemoryCategoryTableSize];
+		TraceMemoryCategoryInfo TraceCategoryInfoTable[TraceMemoryCategoryTableSize];
+		Mutex TraceCategoryLock;
+
+#if defined(BAROQUE_SAMPLE_MEMORY)
+		std::atomic<std::size_t> SamplingInterval{ DefaultSamplingInterval };
+		std::atomic<std::uint64_t> SamplerSeed{ 0 };
+
+		// Number of sampled allocations whose hash falls in each entry. Freeing an allocation
+		// that was not sampled usually finds a zero here and never takes a shard lock.
+		std::atomic<std::uint32_t> SampledAllocationFilter[SampledAllocationFilterSize];
+
+		struct AllocationSampler
 		{
-			TraceMemoryCategoryNode* Next;
+			std::size_t BytesUntilSample = 0;
+			// Interval used for the current draw, 0 until the first allocation of the thread
+			std::size_t Interval = 0;
+			std::uint64_t RandomState = 0;
 		};
 
-		using AllocationInfoNodeAllocatorType = PoolObjectAllocator<AllocationInfoNode, VirtualMemoryAllocator, (PageSize - sizeof(void*)) / sizeof(AllocationInfoNode)>;
-		using TraceCategoryNodeAllocatorType = PoolObjectAllocator<TraceMemoryCategoryNode, VirtualMemoryAllocator, (PageSize - sizeof(void(*))) / sizeof(TraceMemoryCategoryNode)>;
+		thread_local AllocationSampler ThreadSampler;
+
+		// Indexed by address instead of hash, neighbour allocations share cache lines of the filter
+		std::atomic<std::uint32_t>& GetSampledAllocationFilter(const void* allocation)
+		{
+			return SampledAllocationFilter[(reinterpret_cast<std::uintptr_t>(allocation) >> 4) & (SampledAllocationFilterSize - 1)];
+		}
+
+		// Bytes until the next sample follow an exponential distribution so that sampling is a Poisson process
+		// over the allocated bytes, each byte has the same chance to be sampled whatever the allocation pattern.
+		void DrawNextSample(AllocationSampler& sampler, std::size_t interval)
+		{
+			if (!sampler.RandomState)
+			{
+				sampler.RandomState = Hashing::PointerHash(&sampler) ^ Hashing::PointerHash(reinterpret_cast<const void*>(SamplerSeed.fetch_add(1, std::memory_order_relaxed) + 1));
+				sampler.RandomState |= 1;
+			}
+
+			sampler.RandomState ^= sampler.RandomState << 13;
+			sampler.RandomState ^= sampler.RandomState >> 7;
+			sampler.RandomState ^= sampler.RandomState << 17;
+
+			// Uniform in ]0, 1[ from the 53 high bits
+			const double uniform = (static_cast<double>(sampler.RandomState >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+
+			sampler.BytesUntilSample = static_cast<std::size_t>(-std::log(uniform) * static_cast<double>(interval)) + 1;
+			sampler.Interval = interval;
+		}
 
-		AllocationInfoNodeAllocatorType AllocationInfoNodeAllocator;
-		TraceCategoryNodeAllocatorType TraceCategoryNodeAllocator;
+		// An allocation of size bytes is sampled with probability 1 - e^(-size / interval), weighting it by the
+		// inverse of that probability gives unbiased byte and count estimates
+		std::size_t EstimateSampledBytes(std::size_t size)
+		{
+			const auto sizeInBytes = static_cast<double>(size);
+			const auto probability = -std::expm1(-sizeInBytes / static_cast<double>(ThreadSampler.Interval));
 
-		AllocationInfoNode* AllocationInfoTable[AllocationInfoTableSize];
-		TraceMemoryCategoryNode* TraceCategoryInfoTable[TraceMemoryCategoryTableSize];
+			return static_cast<std::size_t>(sizeInBytes / probability + 0.5);
+		}
+#endif
 
-		ReaderWriterLock AllocLock;
+		AllocationShard& GetAllocationShard(std::uint64_t allocationHash)
+		{
+			return AllocationShards[allocationHash >> (64 - AllocationShardCountBits)];
+		}
 
-		void RegisterOrUpdateCategory(const TraceMemoryCategory* category)
+		AllocationSlot* FindAllocationSlot(const AllocationTable& table, const void* allocation, std::uint64_t allocationHash)
 		{
-			auto categoryHashIndex = Hashing::PointerHash(category) & (TraceMemoryCategoryTableSize - 1);
+			if (!table.Slots)
+			{
+				return nullptr;
+			}
 
-			auto * *categoryIt = &TraceCategoryInfoTable[categoryHashIndex];
+			const auto mask = table.Capacity - 1;
 
-			while (categoryIt && *categoryIt)
+			for (auto index = allocationHash & mask; ; index = (index + 1) & mask)
 			{
-				if ((*categoryIt)->Category == category)
+				auto& slot = table.Slots[index];
+
+				if (slot.Allocation == allocation)
 				{
-					break;
+					return &slot;
 				}
 
-				categoryIt = &(*categoryIt)->Next;
+				if (!slot.Allocation)
+				{
+					return nullptr;
+				}
 			}
+		}
+
+		void InsertAllocationSlot(AllocationTable& table, const void* allocation, std::uint64_t allocationHash, AllocationInfo* info)
+		{
+			const auto mask = table.Capacity - 1;
 
-			if (*categoryIt)
+			auto index = allocationHash & mask;
+
+			while (table.Slots[index].Allocation)
 			{
-				++(*categoryIt)->AllocationCount;
+				index = (index + 1) & mask;
 			}
-			else
+
+			table.Slots[index].Allocation = allocation;
+			table.Slots[index].Info = info;
+		}
+
+		void MigrateAllocationShard(AllocationShard& shard, std::size_t slotCount)
+		{
+			auto& oldTable = shard.OldTable;
+
+			if (!oldTable.Slots)
 			{
-				*categoryIt = TraceCategoryNodeAllocator.Allocate();
-				(*categoryIt)->Category = category;
-				++(*categoryIt)->AllocationCount;
+				return;
 			}
+
+			auto migrationEnd = Algorithm::Min(shard.MigrationIndex + slotCount, oldTable.Capacity);
+
+			for (auto index = shard.MigrationIndex; index < migrationEnd; ++index)
+			{
+				auto& slot = oldTable.Slots[index];
+
+				if (slot.Allocation && slot.Allocation != TombstoneAllocation)
+				{
+					InsertAllocationSlot(shard.Table, slot.Allocation, Hashing::PointerHash(slot.Allocation), slot.Info);
+
+					// Lookups check the new table first, the old entry only needs to keep the probe chain alive
+					slot.Allocation = TombstoneAllocation;
+				}
+			}
+
+			shard.MigrationIndex = migrationEnd;
+
+			if (migrationEnd == oldTable.Capacity)
+			{
+				HugePageAllocator{}.Deallocate(oldTable.Slots);
+				oldTable = AllocationTable{};
+			}
+		}
+
+		// Starts an incremental migration to a table twice as big instead of rehashing everything at once.
+		// The shard keeps its table when the new one can't be mapped.
+		bool GrowAllocationShard(AllocationShard& shard)
+		{
+			// Never happens with MigrationStepSize >= 2, but stay correct if the policy changes
+			MigrateAllocationShard(shard, shard.OldTable.Capacity);
+
+			AllocationTable newTable;
+			newTable.Capacity = shard.Table.Capacity ? shard.Table.Capacity * 2 : InitialAllocationShardTableSize;
+
+			// Zero-filled by the OS, pages are only touched when used. Big tables use huge pages,
+			// the lookups are random accesses all over the table.
+			newTable.Slots = static_cast<AllocationSlot*>(HugePageAllocator{}.Allocate(newTable.Capacity * sizeof(AllocationSlot)));
+
+			if (!newTable.Slots)
+			{
+				return false;
+			}
+
+			shard.OldTable = shard.Table;
+			shard.Table = newTable;
+			shard.MigrationIndex = 0;
+
+			return true;
+		}
+
+		// Backward shift deletion, keeps linear probing chains valid without tombstones
+		void RemoveAllocationSlot(AllocationTable& table, AllocationSlot* removedSlot)
+		{
+			const auto mask = table.Capacity - 1;
+
+			auto hole = static_cast<std::size_t>(removedSlot - table.Slots);
+
+			for (auto index = (hole + 1) & mask; table.Slots[index].Allocation; index = (index + 1) & mask)
+			{
+				auto idealIndex = Hashing::PointerHash(table.Slots[index].Allocation) & mask;
+
+				// Move the entry into the hole if its ideal slot is not between the hole and its current slot
+				if (((index - idealIndex) & mask) >= ((index - hole) & mask))
+				{
+					table.Slots[hole] = table.Slots[index];
+					hole = index;
+				}
+			}
+
+			table.Slots[hole].Allocation = nullptr;
+			table.Slots[hole].Info = nullptr;
 		}
 
-		void UpdateCategoryOnUnregisterAllocation(const TraceMemoryCategory* category)
+		TraceMemoryCategoryInfo* FindCategory(const TraceMemoryCategory* category)
 		{
-			auto categoryHashIndex = Hashing::PointerHash(category) & (TraceMemoryCategoryTableSize - 1);
+			const auto mask = TraceMemoryCategoryTableSize - 1;
 
-			auto * categoryIt = TraceCategoryInfoTable[categoryHashIndex];
+			auto index = Hashing::PointerHash(category) & mask;
 
-			while (categoryIt)
+			for (std::size_t probe = 0; probe < TraceMemoryCategoryTableSize; ++probe, index = (index + 1) & mask)
 			{
-				if (categoryIt->Category == category)
+				auto* key = TraceCategoryKeys[index].load(std::memory_order_acquire);
+
+				if (key == category)
+				{
+					return &TraceCategoryInfoTable[index];
+				}
+
+				if (!key)
 				{
-					++categoryIt->DeallocationCount;
 					break;
 				}
+			}
+
+			return nullptr;
+		}
+
+		std::size_t GetSizeHistogramBucket(std::size_t size)
+		{
+			std::size_t bucket = 0;
 
-				categoryIt = categoryIt->Next;
+			while (size > 1 && bucket < TraceMemorySizeHistogramBucketCount - 1)
+			{
+				size >>= 1;
+				++bucket;
 			}
+
+			return bucket;
 		}
 
-		void RegisterAllocation(const void* allocation, const std::size_t size, const TraceMemoryCategory& category, const Baroque::SourceLocation& sourceLocation)
+		// Number of allocations a sample stands for, always 1 when every allocation is traced
+		std::size_t GetSampledCount(std::size_t size, std::size_t sampledBytes)
 		{
-			if (!allocation)
+			return size ? Algorithm::Max<std::size_t>((sampledBytes + size / 2) / size, 1) : 1;
+		}
+
+		void AddCategoryAllocation(TraceMemoryCategoryInfo& categoryInfo, std::size_t size, std::size_t sampledBytes)
+		{
+			const auto sampledCount = GetSampledCount(size, sampledBytes);
+
+			categoryInfo.AllocationCount.fetch_add(sampledCount, std::memory_order_relaxed);
+			categoryInfo.TotalAllocatedBytes.fetch_add(sampledBytes, std::memory_order_relaxed);
+			categoryInfo.SizeHistogram[GetSizeHistogramBucket(size)].fetch_add(sampledCount, std::memory_order_relaxed);
+
+			auto liveBytes = categoryInfo.LiveBytes.fetch_add(sampledBytes, std::memory_order_relaxed) + sampledBytes;
+
+			auto peakLiveBytes = categoryInfo.PeakLiveBytes.load(std::memory_order_relaxed);
+			while (liveBytes > peakLiveBytes && !categoryInfo.PeakLiveBytes.compare_exchange_weak(peakLiveBytes, liveBytes, std::memory_order_relaxed))
 			{
-				return;
 			}
+		}
+
+		void RemoveCategoryAllocation(const TraceMemoryCategory* category, std::size_t size, std::size_t sampledBytes)
+		{
+			if (auto* categoryInfo = FindCategory(category))
+			{
+				categoryInfo->DeallocationCount.fetch_add(GetSampledCount(size, sampledBytes), std::memory_order_relaxed);
+				categoryInfo->LiveBytes.fetch_sub(sampledBytes, std::memory_order_relaxed);
+			}
+		}
+
+		TraceMemoryCategoryInfo* FindOrRegisterCategory(const TraceMemoryCategory* category)
+		{
+			if (auto* categoryInfo = FindCategory(category))
+			{
+				return categoryInfo;
+			}
+
+			Baroque::AutoLock autoLock(TraceCategoryLock);
+
+			// Another thread could have registered it while we were waiting
+			if (auto* categoryInfo = FindCategory(category))
+			{
+				return categoryInfo;
+			}
+
+			const auto mask = TraceMemoryCategoryTableSize - 1;
 
-			Baroque::AutoWriteLock autoLock(AllocLock);
+			auto index = Hashing::PointerHash(category) & mask;
 
-			AllocationInfoNode* allocInfo = AllocationInfoNodeAllocator.Allocate();
+			for (std::size_t probe = 0; probe < TraceMemoryCategoryTableSize; ++probe, index = (index + 1) & mask)
+			{
+				if (!TraceCategoryKeys[index].load(std::memory_order_relaxed))
+				{
+					auto& categoryInfo = TraceCategoryInfoTable[index];
+					categoryInfo.Category = category;
 
-			allocInfo->Allocation = allocation;
-			allocInfo->Category = &category;
-			allocInfo->Size = size;
-			allocInfo->SourceLocation = sourceLocation;
+					TraceCategoryKeys[index].store(category, std::memory_order_release);
 
-			auto allocHash = Hashing::PointerHash(allocation) & (AllocationInfoTableSize - 1);
-			allocInfo->Next = AllocationInfoTable[allocHash];
-			AllocationInfoTable[allocHash] = allocInfo;
+					return &categoryInfo;
+				}
+			}
 
-			RegisterOrUpdateCategory(&category);
+			// Category table is full
+			return nullptr;
 		}
 
-		void UnregisterAllocation(const void* allocation)
+		void TraceAllocation(const void* allocation, const std::size_t size, const std::size_t sampledBytes, const TraceMemoryCategory& category, const Baroque::SourceLocation& sourceLocation)
 		{
-			if (!allocation)
+			if (auto* categoryInfo = FindOrRegisterCategory(&category))
 			{
-				return;
+				AddCategoryAllocation(*categoryInfo, size, sampledBytes);
+			}
+
+			auto allocHash = Hashing::PointerHash(allocation);
+			auto& shard = GetAllocationShard(allocHash);
+
+			// Registering an address again replaces its previous allocation
+			const TraceMemoryCategory* replacedCategory = nullptr;
+			std::size_t replacedSize = 0;
+			std::size_t replacedSampledBytes = 0;
+
+			{
+				Baroque::AutoLock autoLock(shard.Lock);
+
+				AllocationInfo* allocInfo = nullptr;
+
+				auto* existingSlot = FindAllocationSlot(shard.Table, allocation, allocHash);
+				if (!existingSlot)
+				{
+					existingSlot = FindAllocationSlot(shard.OldTable, allocation, allocHash);
+				}
+
+				if (existingSlot)
+				{
+					allocInfo = existingSlot->Info;
+
+					replacedCategory = allocInfo->Category;
+					replacedSize = allocInfo->Size;
+					replacedSampledBytes = allocInfo->SampledBytes;
+				}
+				else
+				{
+					// Over half full the table grows, without a new table it can still fill up to its last free slot
+					if ((shard.Count + 1) * 2 > shard.Table.Capacity && !GrowAllocationShard(shard) && shard.Count + 1 >= shard.Table.Capacity)
+					{
+						std::fprintf(stderr, "Out of memory for the allocation table of the TracingAllocator, %zu allocations traced\n", shard.Count);
+						std::abort();
+					}
+
+					allocInfo = shard.InfoAllocator.Allocate();
+
+					InsertAllocationSlot(shard.Table, allocation, allocHash, allocInfo);
+					++shard.Count;
+
+#if defined(BAROQUE_SAMPLE_MEMORY)
+					GetSampledAllocationFilter(allocation).fetch_add(1, std::memory_order_relaxed);
+#endif
+				}
+
+				MigrateAllocationShard(shard, MigrationStepSize);
+
+				allocInfo->Allocation = allocation;
+				allocInfo->Category = &category;
+				allocInfo->Size = size;
+				allocInfo->SourceLocation = sourceLocation;
+				allocInfo->SampledBytes = sampledBytes;
 			}
 
-			Baroque::AutoWriteLock autoLock(AllocLock);
+			if (replacedCategory)
+			{
+				RemoveCategoryAllocation(replacedCategory, replacedSize, replacedSampledBytes);
+			}
+		}
 
-			auto allocHash = Hashing::PointerHash(allocation) & (AllocationInfoTableSize - 1);
+		void UntraceAllocation(const void* allocation)
+		{
+			auto allocHash = Hashing::PointerHash(allocation);
+			auto& shard = GetAllocationShard(allocHash);
 
-			auto * *allocIt = &AllocationInfoTable[allocHash];
-			auto * *previous = &AllocationInfoTable[allocHash];
+			const TraceMemoryCategory* category = nullptr;
+			std::size_t size = 0;
+			std::size_t sampledBytes = 0;
 
-			while (allocIt)
 			{
-				if ((*allocIt)->Allocation == allocation)
+				Baroque::AutoLock autoLock(shard.Lock);
+
+				if (auto* slot = FindAllocationSlot(shard.Table, allocation, allocHash))
 				{
-					UpdateCategoryOnUnregisterAllocation((*allocIt)->Category);
+					category = slot->Info->Category;
+					size = slot->Info->Size;
+					sampledBytes = slot->Info->SampledBytes;
 
-					(*previous)->Next = (*allocIt)->Next;
-					AllocationInfoNodeAllocator.Deallocate(*allocIt);
-					*allocIt = nullptr;
-					break;
+					shard.InfoAllocator.Deallocate(slot->Info);
+					RemoveAllocationSlot(shard.Table, slot);
+				}
+				else if (auto* oldSlot = FindAllocationSlot(shard.OldTable, allocation, allocHash))
+				{
+					category = oldSlot->Info->Category;
+					size = oldSlot->Info->Size;
+					sampledBytes = oldSlot->Info->SampledBytes;
+
+					shard.InfoAllocator.Deallocate(oldSlot->Info);
+					oldSlot->Allocation = TombstoneAllocation;
+					oldSlot->Info = nullptr;
+				}
+				else
+				{
+					return;
 				}
 
-				previous = allocIt;
-				allocIt = &(*allocIt)->Next;
+				--shard.Count;
+
+#if defined(BAROQUE_SAMPLE_MEMORY)
+				GetSampledAllocationFilter(allocation).fetch_sub(1, std::memory_order_relaxed);
+#endif
+
+				MigrateAllocationShard(shard, MigrationStepSize);
 			}
+
+			RemoveCategoryAllocation(category, size, sampledBytes);
 		}
 
-		const AllocationInfo* GetAllocationInfo(const void* allocation)
+#if defined(BAROQUE_SAMPLE_MEMORY)
+		void SampleAllocation(AllocationSampler& sampler, const void* allocation, const std::size_t size, const TraceMemoryCategory& category, const Baroque::SourceLocation& sourceLocation)
+		{
+			const auto interval = SamplingInterval.load(std::memory_order_relaxed);
+
+			// First allocation of the thread or the interval changed, start a new draw with the new interval
+			if (sampler.Interval != interval)
+			{
+				DrawNextSample(sampler, interval);
+
+				if (size < sampler.BytesUntilSample)
+				{
+					sampler.BytesUntilSample -= size;
+					return;
+				}
+			}
+
+			DrawNextSample(sampler, interval);
+
+			TraceAllocation(allocation, size, EstimateSampledBytes(size), category, sourceLocation);
+		}
+#endif
+
+		// Keep the locked work out of line, skipping an allocation that is not sampled must stay cheap
+		void RegisterAllocation(const void* allocation, const std::size_t size, const TraceMemoryCategory& category, const Baroque::SourceLocation& sourceLocation)
 		{
 			if (!allocation)
 			{
-				return nullptr;
+				return;
 			}
 
-			Baroque::AutoReadLock autoLock(AllocLock);
+#if defined(BAROQUE_SAMPLE_MEMORY)
+			auto& sampler = ThreadSampler;
 
-			auto allocHash = Hashing::PointerHash(allocation) & (AllocationInfoTableSize - 1);
+			if (size < sampler.BytesUntilSample && sampler.Interval == SamplingInterval.load(std::memory_order_relaxed))
+			{
+				sampler.BytesUntilSample -= size;
+				return;
+			}
 
-			auto * allocIt = AllocationInfoTable[allocHash];
+			SampleAllocation(sampler, allocation, size, category, sourceLocation);
+#else
+			TraceAllocation(allocation, size, size, category, sourceLocation);
+#endif
+		}
 
-			while (allocIt)
+		void UnregisterAllocation(const void* allocation)
+		{
+			if (!allocation)
 			{
-				if (allocIt->Allocation == allocation)
-				{
-					return allocIt;
-				}
+				return;
+			}
 
-				allocIt = allocIt->Next;
+#if defined(BAROQUE_SAMPLE_MEMORY)
+			if (!GetSampledAllocationFilter(allocation).load(std::memory_order_relaxed))
+			{
+				return;
 			}
+#endif
 
-			return nullptr;
+			UntraceAllocation(allocation);
+		}
+
+		const AllocationInfo* GetAllocationInfo(const void* allocation)
+		{
+			if (!allocation)
+			{
+				return nullptr;
+			}
+
+			auto allocHash = Hashing::PointerHash(allocation);
+			auto& shard = GetAllocationShard(allocHash);
+
+			Baroque::AutoLock autoLock(shard.Lock);
+
+			auto* slot = FindAllocationSlot(shard.Table, allocation, allocHash);
+			if (!slot)
+			{
+				slot = FindAllocationSlot(shard.OldTable, allocation, allocHash);
+			}
+
+			return slot ? slot->Info : nullptr;
 		}
 
 		const TraceMemoryCategoryInfo* GetTraceMemoryCategoryInfo(const TraceMemoryCategory & category)
@@ -175,23 +579,54 @@ namespace Baroque
 
 		const TraceMemoryCategoryInfo* GetTraceMemoryCategoryInfo(const TraceMemoryCategory * category)
 		{
-			Baroque::AutoReadLock autoLock(AllocLock);
+			return FindCategory(category);
+		}
 
-			auto categoryHashIndex = Hashing::PointerHash(category) & (TraceMemoryCategoryTableSize - 1);
+#if defined(BAROQUE_SAMPLE_MEMORY)
+		void SetTraceMemorySamplingInterval(std::size_t samplingInterval)
+		{
+			SamplingInterval.store(Algorithm::Max<std::size_t>(samplingInterval, 1), std::memory_order_relaxed);
+		}
 
-			auto * categoryIt = TraceCategoryInfoTable[categoryHashIndex];
+		std::size_t GetTraceMemorySamplingInterval()
+		{
+			return SamplingInterval.load(std::memory_order_relaxed);
+		}
+#endif
 
-			while (categoryIt)
+		void ForEachAllocationInTable(const AllocationTable& table, AllocationInfoCallback callback, void* userData)
+		{
+			for (std::size_t index = 0; index < table.Capacity; ++index)
 			{
-				if (categoryIt->Category == category)
+				auto& slot = table.Slots[index];
+
+				if (slot.Allocation && slot.Allocation != TombstoneAllocation)
 				{
-					return categoryIt;
+					callback(*slot.Info, userData);
 				}
+			}
+		}
 
-				categoryIt = categoryIt->Next;
+		void ForEachAllocation(AllocationInfoCallback callback, void* userData)
+		{
+			for (auto& shard : AllocationShards)
+			{
+				Baroque::AutoLock autoLock(shard.Lock);
+
+				ForEachAllocationInTable(shard.Table, callback, userData);
+				ForEachAllocationInTable(shard.OldTable, callback, userData);
 			}
+		}
 
-			return nullptr;
+		void ForEachTraceMemoryCategory(TraceMemoryCategoryCallback callback, void* userData)
+		{
+			for (std::size_t index = 0; index < TraceMemoryCategoryTableSize; ++index)
+			{
+				if (TraceCategoryKeys[index].load(std::memory_order_acquire))
+				{
+					callback(TraceCategoryInfoTable[index], userData);
+				}
+			}
 		}
 	}
 }
@@ -2,9 +2,23 @@
 
 #include "Core/CoreDefines.h"
 
-#if defined(BAROQUE_TRACE_MEMORY)
+// BAROQUE_TRACE_MEMORY records every allocation, BAROQUE_SAMPLE_MEMORY only records a random sample
+// of the allocations, one per SamplingInterval allocated bytes on average
+#if defined(BAROQUE_TRACE_MEMORY) && defined(BAROQUE_SAMPLE_MEMORY)
+#error "BAROQUE_TRACE_MEMORY and BAROQUE_SAMPLE_MEMORY can't be defined at the same time"
+#endif
+
+#if defined(BAROQUE_TRACE_MEMORY) || defined(BAROQUE_SAMPLE_MEMORY)
+#define BAROQUE_TRACING_ALLOCATOR 1
+#endif
+
+#if defined(BAROQUE_TRACING_ALLOCATOR)
+#include "Core/Memory/AllocatorTraits.h"
 #include "Core/Utilities/SourceLocation.h"
 
+#include <atomic>
+#include <type_traits>
+
 namespace Baroque
 {
 	namespace Memory
@@ -25,20 +39,62 @@ namespace Baroque
 			std::size_t Size;
 			Baroque::SourceLocation SourceLocation;
 			const TraceMemoryCategory* Category;
+			// Estimated allocated bytes this allocation stands for, same as Size when every allocation is traced
+			std::size_t SampledBytes;
 		};
 
+		// Bucket N of the size histogram counts the allocations of [2^N, 2^(N+1)) bytes, the last bucket also counts anything bigger
+		constexpr std::size_t TraceMemorySizeHistogramBucketCount = 32;
+
+		// Counters are updated with relaxed atomics, they are exact once all threads are done allocating.
+		// With BAROQUE_SAMPLE_MEMORY they are unbiased estimates computed from the sampled allocations.
 		struct BAROQUE_CORE_API TraceMemoryCategoryInfo
 		{
 			const TraceMemoryCategory* Category;
-			std::size_t AllocationCount;
-			std::size_t DeallocationCount;
+			std::atomic<std::size_t> AllocationCount;
+			std::atomic<std::size_t> DeallocationCount;
+			std::atomic<std::size_t> LiveBytes;
+			std::atomic<std::size_t> TotalAllocatedBytes;
+			std::atomic<std::size_t> PeakLiveBytes;
+			std::atomic<std::size_t> SizeHistogram[TraceMemorySizeHistogramBucketCount];
 		};
 
+		using TraceMemoryCategoryCallback = void(*)(const TraceMemoryCategoryInfo& categoryInfo, void* userData);
+		using AllocationInfoCallback = void(*)(const AllocationInfo& allocationInfo, void* userData);
+
 		BAROQUE_CORE_API void RegisterAllocation(const void* allocation, const std::size_t size, const TraceMemoryCategory& category, const Baroque::SourceLocation& sourceLocation);
 		BAROQUE_CORE_API void UnregisterAllocation(const void* allocation);
 		BAROQUE_CORE_API const AllocationInfo* GetAllocationInfo(const void* allocation);
 		BAROQUE_CORE_API const TraceMemoryCategoryInfo* GetTraceMemoryCategoryInfo(const TraceMemoryCategory& category);
 		BAROQUE_CORE_API const TraceMemoryCategoryInfo* GetTraceMemoryCategoryInfo(const TraceMemoryCategory* category);
+		BAROQUE_CORE_API void ForEachTraceMemoryCategory(TraceMemoryCategoryCallback callback, void* userData);
+
+		// Visits every live traced allocation. The shard being visited is locked during the callbacks,
+		// the callback must not allocate or free memory with a TracingAllocator.
+		BAROQUE_CORE_API void ForEachAllocation(AllocationInfoCallback callback, void* userData);
+
+#if defined(BAROQUE_SAMPLE_MEMORY)
+		BAROQUE_CORE_API void SetTraceMemorySamplingInterval(std::size_t samplingInterval);
+		BAROQUE_CORE_API std::size_t GetTraceMemorySamplingInterval();
+#endif
+
+		template<typename Function>
+		void ForEachTraceMemoryCategory(Function&& function)
+		{
+			ForEachTraceMemoryCategory([](const TraceMemoryCategoryInfo& categoryInfo, void* userData)
+			{
+				(*static_cast<std::remove_reference_t<Function>*>(userData))(categoryInfo);
+			}, &function);
+		}
+
+		template<typename Function>
+		void ForEachAllocation(Function&& function)
+		{
+			ForEachAllocation([](const AllocationInfo& allocationInfo, void* userData)
+			{
+				(*static_cast<std::remove_reference_t<Function>*>(userData))(allocationInfo);
+			}, &function);
+		}
 
 		template<typename Allocator>
 		class TracingAllocator : private Allocator
@@ -57,6 +113,41 @@ namespace Baroque
 				return alloc;
 			}
 
+			void* Allocate(const std::size_t size, const std::size_t alignment, const TraceMemoryCategory& category, const Baroque::SourceLocation& sourceLocation)
+			{
+				void* alloc = Allocator::Allocate(size, alignment);
+				if (alloc)
+				{
+					RegisterAllocation(alloc, size, category, sourceLocation);
+				}
+
+				return alloc;
+			}
+
+			// The old block is unregistered first, once freed by the reallocation its address can be registered again by another thread
+			void* Reallocate(void* ptr, const std::size_t oldSize, const std::size_t newSize, const TraceMemoryCategory& category, const Baroque::SourceLocation& sourceLocation)
+			{
+				const auto* oldInfo = GetAllocationInfo(ptr);
+
+				const TraceMemoryCategory& oldCategory = oldInfo && oldInfo->Category ? *oldInfo->Category : category;
+				const Baroque::SourceLocation oldSourceLocation = oldInfo ? oldInfo->SourceLocation : sourceLocation;
+
+				UnregisterAllocation(ptr);
+
+				void* alloc = Allocator::Reallocate(ptr, oldSize, newSize);
+				if (alloc)
+				{
+					RegisterAllocation(alloc, newSize, category, sourceLocation);
+				}
+				else
+				{
+					// The old block is still allocated
+					RegisterAllocation(ptr, oldSize, oldCategory, oldSourceLocation);
+				}
+
+				return alloc;
+			}
+
 			void Deallocate(void* ptr)
 			{
 				UnregisterAllocation(ptr);
@@ -64,16 +155,33 @@ namespace Baroque
 				Allocator::Deallocate(ptr);
 			}
 
+			void Deallocate(void* ptr, const std::size_t size)
+			{
+				UnregisterAllocation(ptr);
+
+				DeallocateSized(static_cast<Allocator&>(*this), ptr, size);
+			}
+
 			bool Owns(const void* ptr) const
 			{
 				return Allocator::Owns(ptr);
 			}
+
+			static std::size_t GetAllocationSize(const std::size_t size)
+			{
+				return Memory::GetAllocationSize<Allocator>(size);
+			}
+		};
+
+		template<typename Allocator>
+		struct CanReallocate<TracingAllocator<Allocator>> : CanReallocate<Allocator>
+		{
 		};
 	}
 }
 #endif
 
-#if defined(BAROQUE_TRACE_MEMORY)
+#if defined(BAROQUE_TRACING_ALLOCATOR)
 #define BAROQUE_EXTERN_MEMORY_CATEGORY(Name) extern Baroque::Memory::TraceMemoryCategory _Baroque_Trace_Category_##Name;
 #define BAROQUE_REGISTER_MEMORY_CATEGORY(Name) Baroque::Memory::TraceMemoryCategory _Baroque_Trace_Category_##Name(#Name);
 #define BAROQUE_GET_MEMORY_CATEGORY(Name) _Baroque_Trace_Category_##Name
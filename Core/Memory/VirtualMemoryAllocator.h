@@ -6,12 +6,43 @@ namespace Baroque
 {
 	namespace Memory
 	{
+		enum class VirtualMemoryPages
+		{
+			Normal,
+			// Hint that the range should use huge pages when it is committed, ignored if the system doesn't support it
+			Huge
+		};
+
 		class BAROQUE_CORE_API VirtualMemoryAllocator
 		{
 		public:
 			static constexpr std::size_t StackCapacity = 0;
 
 			void* Allocate(const std::size_t size);
+			void* Allocate(const std::size_t size, const std::size_t alignment);
+			void Deallocate(void* ptr);
+
+			// Reserved address space can't be accessed until it is committed. Committed memory is zero-filled,
+			// addresses and sizes must be multiples of GetPageSize().
+			static void* Reserve(const std::size_t size, const VirtualMemoryPages pages = VirtualMemoryPages::Normal);
+			static bool Commit(void* ptr, const std::size_t size);
+			// The pages go back to the system but the address range stays reserved
+			static void Decommit(void* ptr, const std::size_t size);
+			static void Release(void* ptr, const std::size_t size);
+
+			static std::size_t GetPageSize();
+			static std::size_t GetHugePageSize();
+		};
+
+		// Allocations of at least GetHugePageSize() are aligned and backed by huge pages when the system allows it,
+		// smaller allocations are the same as VirtualMemoryAllocator
+		class BAROQUE_CORE_API HugePageAllocator
+		{
+		public:
+			static constexpr std::size_t StackCapacity = 0;
+
+			void* Allocate(const std::size_t size);
+			void* Allocate(const std::size_t size, const std::size_t alignment);
 			void Deallocate(void* ptr);
 		};
 	}
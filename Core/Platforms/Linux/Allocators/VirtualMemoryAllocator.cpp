@@ -0,0 +1,365 @@
+#include "Core/Memory/VirtualMemoryAllocator.h"
+
+#include "Core/Memory/Alignment.h"
+#include "Core/Hashing/PointerHash.h"
+#include "Core/Threading/Mutex.h"
+
+#include <atomic>
+#include <cstdio>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace Baroque
+{
+	namespace Memory
+	{
+		// munmap() needs the mapping length, it is kept in a table outside of the mappings so page sized
+		// and page aligned requests only map their own pages
+		struct MappingSlot
+		{
+			void* Mapping;
+			std::size_t Size;
+		};
+
+		struct MappingTable
+		{
+			MappingSlot* Slots = nullptr;
+			std::size_t Capacity = 0;
+			std::size_t Count = 0;
+		};
+
+		constexpr std::size_t InitialMappingTableCapacity = 256;
+
+		Mutex MappingTableLock;
+		MappingTable Mappings;
+
+		constexpr std::size_t DefaultHugePageSize = 2 * 1024 * 1024;
+
+		// Explicit huge pages need a pool configured by the administrator, stop asking after the first failure
+		std::atomic<bool> ExplicitHugePagesUnavailable{ false };
+
+		void* MapPages(std::size_t size, int extraFlags)
+		{
+			void* mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | extraFlags, -1, 0);
+
+			return mapping == MAP_FAILED ? nullptr : mapping;
+		}
+
+		std::size_t ReadHugePageSize()
+		{
+			std::size_t hugePageSize = 0;
+
+			if (std::FILE* file = std::fopen("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", "r"))
+			{
+				if (std::fscanf(file, "%zu", &hugePageSize) != 1)
+				{
+					hugePageSize = 0;
+				}
+
+				std::fclose(file);
+			}
+
+			return hugePageSize ? hugePageSize : DefaultHugePageSize;
+		}
+
+		// Open addressing with linear probing, the slots come straight from mmap() so they are zero-filled
+		void InsertMappingSlot(MappingTable& table, void* mapping, std::size_t size)
+		{
+			const auto mask = table.Capacity - 1;
+
+			auto index = Hashing::PointerHash(mapping) & mask;
+			while (table.Slots[index].Mapping)
+			{
+				index = (index + 1) & mask;
+			}
+
+			table.Slots[index].Mapping = mapping;
+			table.Slots[index].Size = size;
+			++table.Count;
+		}
+
+		bool GrowMappingTable(MappingTable& table)
+		{
+			const auto newCapacity = table.Capacity ? table.Capacity * 2 : InitialMappingTableCapacity;
+
+			auto* newSlots = static_cast<MappingSlot*>(MapPages(newCapacity * sizeof(MappingSlot), 0));
+			if (!newSlots)
+			{
+				return false;
+			}
+
+			MappingTable newTable;
+			newTable.Slots = newSlots;
+			newTable.Capacity = newCapacity;
+
+			for (std::size_t i = 0; i < table.Capacity; ++i)
+			{
+				if (table.Slots[i].Mapping)
+				{
+					InsertMappingSlot(newTable, table.Slots[i].Mapping, table.Slots[i].Size);
+				}
+			}
+
+			if (table.Slots)
+			{
+				::munmap(table.Slots, table.Capacity * sizeof(MappingSlot));
+			}
+
+			table = newTable;
+
+			return true;
+		}
+
+		bool AddMapping(void* mapping, std::size_t size)
+		{
+			AutoLock<Mutex> lock(MappingTableLock);
+
+			// Keep the table at most half full
+			if ((Mappings.Count + 1) * 2 > Mappings.Capacity && !GrowMappingTable(Mappings))
+			{
+				return false;
+			}
+
+			InsertMappingSlot(Mappings, mapping, size);
+
+			return true;
+		}
+
+		// Returns the size of the removed mapping, 0 if it is unknown
+		std::size_t RemoveMapping(void* mapping)
+		{
+			AutoLock<Mutex> lock(MappingTableLock);
+
+			if (!Mappings.Count)
+			{
+				return 0;
+			}
+
+			const auto mask = Mappings.Capacity - 1;
+
+			auto hole = Hashing::PointerHash(mapping) & mask;
+			while (Mappings.Slots[hole].Mapping != mapping)
+			{
+				if (!Mappings.Slots[hole].Mapping)
+				{
+					return 0;
+				}
+
+				hole = (hole + 1) & mask;
+			}
+
+			const auto size = Mappings.Slots[hole].Size;
+
+			for (auto index = (hole + 1) & mask; Mappings.Slots[index].Mapping; index = (index + 1) & mask)
+			{
+				auto idealIndex = Hashing::PointerHash(Mappings.Slots[index].Mapping) & mask;
+
+				// Move the entry into the hole if its ideal slot is not between the hole and its current slot
+				if (((index - idealIndex) & mask) >= ((index - hole) & mask))
+				{
+					Mappings.Slots[hole] = Mappings.Slots[index];
+					hole = index;
+				}
+			}
+
+			Mappings.Slots[hole].Mapping = nullptr;
+			Mappings.Slots[hole].Size = 0;
+			--Mappings.Count;
+
+			return size;
+		}
+
+		// Mappings are page aligned, bigger alignments map the alignment slack and trim both ends
+		std::uint8_t* MapAlignedPages(std::size_t size, std::size_t alignment, int extraFlags)
+		{
+			const auto pageSize = VirtualMemoryAllocator::GetPageSize();
+
+			if (alignment <= pageSize)
+			{
+				return static_cast<std::uint8_t*>(MapPages(size, extraFlags));
+			}
+
+			const auto slackSize = alignment - pageSize;
+
+			auto* unalignedMapping = static_cast<std::uint8_t*>(MapPages(size + slackSize, extraFlags));
+			if (!unalignedMapping)
+			{
+				return nullptr;
+			}
+
+			auto* mapping = AlignUp(unalignedMapping, alignment);
+
+			const std::size_t headSize = static_cast<std::size_t>(mapping - unalignedMapping);
+			if (headSize)
+			{
+				::munmap(unalignedMapping, headSize);
+			}
+
+			if (slackSize - headSize)
+			{
+				::munmap(mapping + size, slackSize - headSize);
+			}
+
+			return mapping;
+		}
+
+		void* VirtualMemoryAllocator::Allocate(const std::size_t size)
+		{
+			return Allocate(size, GetPageSize());
+		}
+
+		void* VirtualMemoryAllocator::Allocate(const std::size_t size, const std::size_t alignment)
+		{
+			const auto pageSize = GetPageSize();
+			const auto slackSize = alignment > pageSize ? alignment - pageSize : 0;
+
+			if (size > std::numeric_limits<std::size_t>::max() - pageSize - slackSize)
+			{
+				return nullptr;
+			}
+
+			// Empty requests still get a unique pointer
+			const auto mappingSize = AlignUp(size ? size : 1, pageSize);
+
+			auto* mapping = MapAlignedPages(mappingSize, alignment, 0);
+			if (!mapping)
+			{
+				return nullptr;
+			}
+
+			if (!AddMapping(mapping, mappingSize))
+			{
+				::munmap(mapping, mappingSize);
+				return nullptr;
+			}
+
+			return mapping;
+		}
+
+		void VirtualMemoryAllocator::Deallocate(void* ptr)
+		{
+			if (ptr)
+			{
+				if (const auto size = RemoveMapping(ptr))
+				{
+					::munmap(ptr, size);
+				}
+			}
+		}
+
+		void* VirtualMemoryAllocator::Reserve(const std::size_t size, const VirtualMemoryPages pages)
+		{
+			// MAP_NORESERVE: reserved address space doesn't count against the overcommit limit
+			void* mapping = ::mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+			if (mapping == MAP_FAILED)
+			{
+				return nullptr;
+			}
+
+#if defined(MADV_HUGEPAGE)
+			if (pages == VirtualMemoryPages::Huge)
+			{
+				::madvise(mapping, size, MADV_HUGEPAGE);
+			}
+#else
+			BAROQUE_UNUSED(pages);
+#endif
+
+			return mapping;
+		}
+
+		bool VirtualMemoryAllocator::Commit(void* ptr, const std::size_t size)
+		{
+			// Physical pages are only given on the first access
+			return ::mprotect(ptr, size, PROT_READ | PROT_WRITE) == 0;
+		}
+
+		void VirtualMemoryAllocator::Decommit(void* ptr, const std::size_t size)
+		{
+			::madvise(ptr, size, MADV_DONTNEED);
+			::mprotect(ptr, size, PROT_NONE);
+		}
+
+		void VirtualMemoryAllocator::Release(void* ptr, const std::size_t size)
+		{
+			::munmap(ptr, size);
+		}
+
+		std::size_t VirtualMemoryAllocator::GetPageSize()
+		{
+			static const std::size_t pageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+			return pageSize;
+		}
+
+		std::size_t VirtualMemoryAllocator::GetHugePageSize()
+		{
+			static const std::size_t hugePageSize = ReadHugePageSize();
+			return hugePageSize;
+		}
+
+		void* HugePageAllocator::Allocate(const std::size_t size)
+		{
+			return Allocate(size, VirtualMemoryAllocator::GetPageSize());
+		}
+
+		void* HugePageAllocator::Allocate(const std::size_t size, const std::size_t alignment)
+		{
+			const auto hugePageSize = VirtualMemoryAllocator::GetHugePageSize();
+
+			if (size < hugePageSize || alignment > hugePageSize)
+			{
+				return VirtualMemoryAllocator{}.Allocate(size, alignment);
+			}
+
+			if (size > std::numeric_limits<std::size_t>::max() - 2 * hugePageSize)
+			{
+				return nullptr;
+			}
+
+			// Huge page mappings are aligned on the huge page size
+			const auto mappingSize = AlignUp(size, hugePageSize);
+
+			std::uint8_t* mapping = nullptr;
+
+#if defined(MAP_HUGETLB)
+			if (!ExplicitHugePagesUnavailable.load(std::memory_order_relaxed))
+			{
+				mapping = static_cast<std::uint8_t*>(MapPages(mappingSize, MAP_HUGETLB));
+				if (!mapping)
+				{
+					ExplicitHugePagesUnavailable.store(true, std::memory_order_relaxed);
+				}
+			}
+#endif
+
+			if (!mapping)
+			{
+				// Transparent huge pages only back aligned ranges
+				mapping = MapAlignedPages(mappingSize, hugePageSize, 0);
+				if (!mapping)
+				{
+					return nullptr;
+				}
+
+#if defined(MADV_HUGEPAGE)
+				::madvise(mapping, mappingSize, MADV_HUGEPAGE);
+#endif
+			}
+
+			if (!AddMapping(mapping, mappingSize))
+			{
+				::munmap(mapping, mappingSize);
+				return nullptr;
+			}
+
+			return mapping;
+		}
+
+		void HugePageAllocator::Deallocate(void* ptr)
+		{
+			// Both allocators use the same mapping table
+			VirtualMemoryAllocator{}.Deallocate(ptr);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Core/CoreDefines.h"
+
+#include <atomic>
+#include <climits>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#if defined(BAROQUE_ARCHITECTURE_X64)
+#include <immintrin.h>
+#endif
+
+namespace Baroque
+{
+	namespace Futex
+	{
+		static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t), "std::atomic<std::uint32_t> must be usable as a futex word");
+
+		// Sleep until woken if the futex word still contains expectedValue.
+		// Spurious wakeups are possible, callers must re-check their condition.
+		inline void Wait(std::atomic<std::uint32_t>& futexWord, std::uint32_t expectedValue)
+		{
+			::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&futexWord), FUTEX_WAIT_PRIVATE, expectedValue, nullptr, nullptr, 0);
+		}
+
+		inline void WakeOne(std::atomic<std::uint32_t>& futexWord)
+		{
+			::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&futexWord), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+		}
+
+		inline void WakeAll(std::atomic<std::uint32_t>& futexWord)
+		{
+			::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&futexWord), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+		}
+
+		// Hint to the CPU that we are in a spin-wait loop
+		inline void CpuRelax()
+		{
+#if defined(BAROQUE_ARCHITECTURE_X64)
+			_mm_pause();
+#elif defined(BAROQUE_ARCHITECTURE_AARCH64) || defined(BAROQUE_ARCHITECTURE_ARM)
+			asm volatile("yield" ::: "memory");
+#endif
+		}
+	}
+}
\ No newline at end of file
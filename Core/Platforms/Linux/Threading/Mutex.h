@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Core/CoreDefines.h"
+
+#include "Core/Algorithms/MinMax.h"
+#include "Core/Platforms/Linux/Threading/Futex.h"
+
+namespace Baroque
+{
+	// Futex mutex (Drepper's "Futexes Are Tricky" mutex #2) with a bounded adaptive spin
+	// before going to sleep. The spin budget follows the number of spins that were needed
+	// to acquire the lock recently, like glibc PTHREAD_MUTEX_ADAPTIVE_NP.
+	class Mutex
+	{
+	private:
+		static constexpr std::uint32_t Unlocked = 0;
+		static constexpr std::uint32_t Locked = 1;
+		static constexpr std::uint32_t LockedWithWaiters = 2;
+
+		static constexpr std::int32_t MinSpinCount = 16;
+		static constexpr std::int32_t MaxSpinCount = 128;
+
+	public:
+		Mutex() = default;
+		Mutex(const Mutex&) = delete;
+		Mutex& operator=(const Mutex&) = delete;
+
+		void Lock()
+		{
+			std::uint32_t expected = Unlocked;
+			if (!_state.compare_exchange_strong(expected, Locked, std::memory_order_acquire, std::memory_order_relaxed))
+			{
+				lockSlow();
+			}
+		}
+
+		void Unlock()
+		{
+			if (_state.exchange(Unlocked, std::memory_order_release) == LockedWithWaiters)
+			{
+				Futex::WakeOne(_state);
+			}
+		}
+
+		bool TryLock()
+		{
+			std::uint32_t expected = Unlocked;
+			return _state.compare_exchange_strong(expected, Locked, std::memory_order_acquire, std::memory_order_relaxed);
+		}
+
+	private:
+		void lockSlow()
+		{
+			auto spinEstimate = _spinEstimate.load(std::memory_order_relaxed);
+			auto maxSpin = Algorithm::Min(MaxSpinCount, spinEstimate * 2 + MinSpinCount);
+
+			for (std::int32_t spin = 0; spin < maxSpin; ++spin)
+			{
+				if (_state.load(std::memory_order_relaxed) == Unlocked)
+				{
+					std::uint32_t expected = Unlocked;
+					if (_state.compare_exchange_weak(expected, Locked, std::memory_order_acquire, std::memory_order_relaxed))
+					{
+						_spinEstimate.store(spinEstimate + (spin - spinEstimate) / 8, std::memory_order_relaxed);
+						return;
+					}
+				}
+
+				Futex::CpuRelax();
+			}
+
+			// Every thread that went through the sleeping path marks the lock as contended so the
+			// owner knows it has to wake someone up on Unlock().
+			while (_state.exchange(LockedWithWaiters, std::memory_order_acquire) != Unlocked)
+			{
+				Futex::Wait(_state, LockedWithWaiters);
+			}
+
+			_spinEstimate.store(spinEstimate + (maxSpin - spinEstimate) / 8, std::memory_order_relaxed);
+		}
+
+	private:
+		std::atomic<std::uint32_t> _state{ Unlocked };
+		std::atomic<std::int32_t> _spinEstimate{ 0 };
+	};
+}
\ No newline at end of file
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "Core/CoreDefines.h"
+
+#include "Core/Platforms/Linux/Threading/Futex.h"
+
+namespace Baroque
+{
+	enum class ReaderWriterLockMode
+	{
+		// New readers can join while a writer is waiting, a steady stream of readers can starve writers
+		ReaderPreferring,
+		// New readers are blocked as soon as a writer is waiting
+		WriterPreferring
+	};
+
+	// Futex reader/writer lock.
+	// _state holds the reader count and the writer bit, readers and writers sleep on
+	// separate sequence words so UnlockWrite() can wake either one writer or all readers.
+	// Recursive read locking can deadlock in WriterPreferring mode if a writer is queued in between.
+	template<ReaderWriterLockMode Mode>
+	class ReaderWriterLockImplementation
+	{
+	private:
+		static constexpr std::uint32_t WriterLocked = 1u << 31;
+		static constexpr std::uint32_t ReaderCountMask = WriterLocked - 1;
+
+		static constexpr std::uint32_t SpinCount = 64;
+
+	public:
+		ReaderWriterLockImplementation() = default;
+		ReaderWriterLockImplementation(const ReaderWriterLockImplementation&) = delete;
+		ReaderWriterLockImplementation& operator=(const ReaderWriterLockImplementation&) = delete;
+
+		void LockRead()
+		{
+			if (TryLockRead())
+			{
+				return;
+			}
+
+			for (std::uint32_t spin = 0; spin < SpinCount; ++spin)
+			{
+				Futex::CpuRelax();
+
+				if (TryLockRead())
+				{
+					return;
+				}
+			}
+
+			_readersWaiting.fetch_add(1);
+
+			for (;;)
+			{
+				// Read the sequence before testing the lock so a concurrent unlock cannot be missed
+				auto sequence = _readerSequence.load();
+
+				if (TryLockRead())
+				{
+					break;
+				}
+
+				Futex::Wait(_readerSequence, sequence);
+			}
+
+			_readersWaiting.fetch_sub(1);
+		}
+
+		void UnlockRead()
+		{
+			auto previous = _state.fetch_sub(1);
+
+			if ((previous & ReaderCountMask) == 1 && _writersWaiting.load() > 0)
+			{
+				_writerSequence.fetch_add(1);
+				Futex::WakeOne(_writerSequence);
+			}
+		}
+
+		bool TryLockRead()
+		{
+			auto state = _state.load(std::memory_order_relaxed);
+
+			for (;;)
+			{
+				if (state & WriterLocked)
+				{
+					return false;
+				}
+
+				if constexpr (Mode == ReaderWriterLockMode::WriterPreferring)
+				{
+					if (_writersWaiting.load() > 0)
+					{
+						return false;
+					}
+				}
+
+				if (_state.compare_exchange_weak(state, state + 1))
+				{
+					return true;
+				}
+			}
+		}
+
+		void LockWrite()
+		{
+			if (TryLockWrite())
+			{
+				return;
+			}
+
+			for (std::uint32_t spin = 0; spin < SpinCount; ++spin)
+			{
+				Futex::CpuRelax();
+
+				if (TryLockWrite())
+				{
+					return;
+				}
+			}
+
+			_writersWaiting.fetch_add(1);
+
+			for (;;)
+			{
+				auto sequence = _writerSequence.load();
+
+				if (TryLockWrite())
+				{
+					break;
+				}
+
+				Futex::Wait(_writerSequence, sequence);
+			}
+
+			_writersWaiting.fetch_sub(1);
+		}
+
+		void UnlockWrite()
+		{
+			_state.store(0);
+
+			if (_writersWaiting.load() > 0)
+			{
+				_writerSequence.fetch_add(1);
+				Futex::WakeOne(_writerSequence);
+
+				if constexpr (Mode == ReaderWriterLockMode::WriterPreferring)
+				{
+					return;
+				}
+			}
+
+			if (_readersWaiting.load() > 0)
+			{
+				_readerSequence.fetch_add(1);
+				Futex::WakeAll(_readerSequence);
+			}
+		}
+
+		bool TryLockWrite()
+		{
+			std::uint32_t expected = 0;
+			return _state.compare_exchange_strong(expected, WriterLocked);
+		}
+
+	private:
+		std::atomic<std::uint32_t> _state{ 0 };
+		std::atomic<std::uint32_t> _readerSequence{ 0 };
+		std::atomic<std::uint32_t> _writerSequence{ 0 };
+		std::atomic<std::uint32_t> _readersWaiting{ 0 };
+		std::atomic<std::uint32_t> _writersWaiting{ 0 };
+	};
+
+	using ReaderWriterLock = ReaderWriterLockImplementation<ReaderWriterLockMode::WriterPreferring>;
+}
\ No newline at end of file
@@ -1,20 +1,144 @@
 #include "Core/Memory/VirtualMemoryAllocator.h"
 
+#include "Core/Memory/Alignment.h"
+
 #include "Core/Platforms/Win32/MinimalWindowsIncludes.h"
 #include <memoryapi.h>
+#include <sysinfoapi.h>
 
 namespace Baroque
 {
 	namespace Memory
 	{
+		constexpr std::size_t DefaultHugePageSize = 2 * 1024 * 1024;
+
+		// Another thread can take the address range between the release and the new allocation
+		constexpr std::size_t AlignedAllocationAttemptCount = 8;
+
+		std::size_t GetAllocationGranularity()
+		{
+			static const std::size_t allocationGranularity = []()
+			{
+				SYSTEM_INFO systemInfo;
+				::GetSystemInfo(&systemInfo);
+				return static_cast<std::size_t>(systemInfo.dwAllocationGranularity);
+			}();
+
+			return allocationGranularity;
+		}
+
 		void* VirtualMemoryAllocator::Allocate(const std::size_t size)
 		{
 			return ::VirtualAlloc(nullptr, size, MEM_COMMIT, PAGE_READWRITE);
 		}
 
+		void* VirtualMemoryAllocator::Allocate(const std::size_t size, const std::size_t alignment)
+		{
+			if (alignment <= GetAllocationGranularity())
+			{
+				return Allocate(size);
+			}
+
+			if (size > std::numeric_limits<std::size_t>::max() - alignment)
+			{
+				return nullptr;
+			}
+
+			// VirtualFree() needs the base address of the allocation, find an aligned free range
+			// then allocate exactly at its aligned address
+			for (std::size_t attempt = 0; attempt < AlignedAllocationAttemptCount; ++attempt)
+			{
+				auto* range = static_cast<std::uint8_t*>(::VirtualAlloc(nullptr, size + alignment, MEM_RESERVE, PAGE_NOACCESS));
+				if (!range)
+				{
+					return nullptr;
+				}
+
+				::VirtualFree(range, 0, MEM_RELEASE);
+
+				if (void* result = ::VirtualAlloc(AlignUp(range, alignment), size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE))
+				{
+					return result;
+				}
+			}
+
+			return nullptr;
+		}
+
 		void VirtualMemoryAllocator::Deallocate(void* ptr)
 		{
 			::VirtualFree(ptr, 0, MEM_RELEASE);
 		}
+
+		void* VirtualMemoryAllocator::Reserve(const std::size_t size, const VirtualMemoryPages pages)
+		{
+			// Large pages can't be committed separately from their reservation on Windows, use HugePageAllocator for them
+			BAROQUE_UNUSED(pages);
+
+			return ::VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
+		}
+
+		bool VirtualMemoryAllocator::Commit(void* ptr, const std::size_t size)
+		{
+			return ::VirtualAlloc(ptr, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+		}
+
+		void VirtualMemoryAllocator::Decommit(void* ptr, const std::size_t size)
+		{
+			::VirtualFree(ptr, size, MEM_DECOMMIT);
+		}
+
+		void VirtualMemoryAllocator::Release(void* ptr, const std::size_t size)
+		{
+			BAROQUE_UNUSED(size);
+
+			::VirtualFree(ptr, 0, MEM_RELEASE);
+		}
+
+		std::size_t VirtualMemoryAllocator::GetPageSize()
+		{
+			static const std::size_t pageSize = []()
+			{
+				SYSTEM_INFO systemInfo;
+				::GetSystemInfo(&systemInfo);
+				return static_cast<std::size_t>(systemInfo.dwPageSize);
+			}();
+
+			return pageSize;
+		}
+
+		std::size_t VirtualMemoryAllocator::GetHugePageSize()
+		{
+			static const std::size_t hugePageSize = ::GetLargePageMinimum();
+			return hugePageSize ? hugePageSize : DefaultHugePageSize;
+		}
+
+		void* HugePageAllocator::Allocate(const std::size_t size)
+		{
+			return Allocate(size, DefaultAlignment);
+		}
+
+		void* HugePageAllocator::Allocate(const std::size_t size, const std::size_t alignment)
+		{
+			const auto largePageSize = ::GetLargePageMinimum();
+
+			// Large pages need the SeLockMemoryPrivilege, fall back to normal pages without it
+			if (largePageSize && size >= largePageSize && alignment <= largePageSize)
+			{
+				const auto roundedSize = (size + largePageSize - 1) & ~(largePageSize - 1);
+
+				if (void* result = ::VirtualAlloc(nullptr, roundedSize, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE))
+				{
+					return result;
+				}
+			}
+
+			return VirtualMemoryAllocator{}.Allocate(size, alignment);
+		}
+
+		void HugePageAllocator::Deallocate(void* ptr)
+		{
+			::VirtualFree(ptr, 0, MEM_RELEASE);
+		}
 	}
 }
\ No newline at end of file
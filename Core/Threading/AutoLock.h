@@ -53,7 +53,7 @@ namespace Baroque
 		{
 			if (_needUnlock)
 			{
-				_lock.Unlock();
+				_lock.UnlockRead();
 			}
 		}
 
@@ -93,7 +93,7 @@ namespace Baroque
 		{
 			if (_needUnlock)
 			{
-				_lock.Unlock();
+				_lock.UnlockWrite();
 			}
 		}
 
@@ -6,6 +6,8 @@
 
 #if defined(BAROQUE_PLATFORM_WINDOWS)
 #include "Core/Platforms/Win32/Threading/Mutex.h"
+#elif defined(BAROQUE_PLATFORM_LINUX)
+#include "Core/Platforms/Linux/Threading/Mutex.h"
 #else
 #error "Implement Mutex for your platform"
 #endif
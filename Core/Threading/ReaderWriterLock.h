@@ -6,6 +6,8 @@
 
 #if defined(BAROQUE_PLATFORM_WINDOWS)
 #include "Core/Platforms/Win32/Threading/ReaderWriterLock.h"
+#elif defined(BAROQUE_PLATFORM_LINUX)
+#include "Core/Platforms/Linux/Threading/ReaderWriterLock.h"
 #else
 #error "Implement ReaderWriterLock for your platform"
 #endif
@@ -0,0 +1,86 @@
+#include "ThreadIndex.h"
+
+#include <atomic>
+#include <cstdint>
+
+namespace Baroque
+{
+	static_assert(MaxThreadIndexCount == 64, "Thread indices are allocated from a 64 bits mask");
+
+	// Index + 1 of the current thread, 0 when it doesn't have one yet
+	constexpr std::size_t UnassignedThreadIndex = 0;
+	constexpr std::size_t ReleasedThreadIndex = ~std::size_t(0);
+
+	std::atomic<std::uint64_t> UsedThreadIndices{ 0 };
+
+	// Trivial so it never needs a dynamic initialization, the releaser
+	// gives the index back when the thread exits.
+	thread_local std::size_t LocalThreadIndex;
+
+	struct ThreadIndexReleaser
+	{
+		~ThreadIndexReleaser()
+		{
+			if (Index < MaxThreadIndexCount)
+			{
+				UsedThreadIndices.fetch_and(~(std::uint64_t(1) << Index), std::memory_order_release);
+			}
+
+			LocalThreadIndex = ReleasedThreadIndex;
+		}
+
+		std::size_t Index = MaxThreadIndexCount;
+	};
+
+	thread_local ThreadIndexReleaser LocalThreadIndexReleaser;
+
+	std::size_t AcquireThreadIndex()
+	{
+		auto used = UsedThreadIndices.load(std::memory_order_relaxed);
+
+		for (;;)
+		{
+			if (used == ~std::uint64_t(0))
+			{
+				return MaxThreadIndexCount;
+			}
+
+			std::size_t index = 0;
+			while (used & (std::uint64_t(1) << index))
+			{
+				++index;
+			}
+
+			// Acquire pairs with the release of the previous owner, the data indexed by it is handed over with the index
+			if (UsedThreadIndices.compare_exchange_weak(used, used | (std::uint64_t(1) << index), std::memory_order_acquire, std::memory_order_relaxed))
+			{
+				return index;
+			}
+		}
+	}
+
+	std::size_t GetThreadIndex()
+	{
+		const auto threadIndex = LocalThreadIndex;
+
+		if (threadIndex == ReleasedThreadIndex)
+		{
+			return MaxThreadIndexCount;
+		}
+
+		if (threadIndex != UnassignedThreadIndex)
+		{
+			return threadIndex - 1;
+		}
+
+		const auto index = AcquireThreadIndex();
+
+		if (index < MaxThreadIndexCount)
+		{
+			LocalThreadIndexReleaser.Index = index;
+			LocalThreadIndex = index + 1;
+		}
+
+		return index;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "Core/CoreDefines.h"
+
+namespace Baroque
+{
+	// Number of threads that can hold an index at the same time
+	constexpr std::size_t MaxThreadIndexCount = 64;
+
+	// Returns a small index unique among the running threads, or MaxThreadIndexCount when all the indices
+	// are taken or the thread is exiting. Indices are recycled when threads exit. Used to give threads
+	// their own slot in per-thread tables.
+	BAROQUE_CORE_API std::size_t GetThreadIndex();
+}
\ No newline at end of file
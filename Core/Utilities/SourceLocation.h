@@ -24,7 +24,7 @@ namespace Baroque
 	};
 }
 
-#if defined(BAROQUE_COMPILER_MSVC)
+#if defined(BAROQUE_COMPILER_MSVC) || defined(BAROQUE_COMPILER_GCC) || defined(BAROQUE_COMPILER_CLANG)
 #define BAROQUE_SOURCE_LOCATION Baroque::SourceLocation{__FILE__, __func__ , static_cast<std::uint32_t>(__LINE__)}
 #else
 #error "Define Baroque::SourceLocation for your compiler"
@@ -29,6 +29,7 @@ namespace Baroque
 			: _allocator(allocator)
 			{}
 
+			// Unsized, the pointer can be to a derived type or to a block larger than T
 			constexpr void operator()(Pointer value)
 			{
 				_allocator.Deallocate(value);
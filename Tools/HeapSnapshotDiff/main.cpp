@@ -0,0 +1,198 @@
+#include "Core/Memory/HeapSnapshot.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Compares two heap snapshots written by Baroque::Memory::WriteHeapSnapshot() and reports
+// the live memory growth by source location and by category.
+//
+// Usage: HeapSnapshotDiff <before> <after> [maximum rows, default 30]
+namespace
+{
+	struct Usage
+	{
+		std::int64_t Bytes = 0;
+		std::int64_t Count = 0;
+	};
+
+	using UsageMap = std::unordered_map<std::string, Usage>;
+
+	struct Snapshot
+	{
+		UsageMap BySourceLocation;
+		UsageMap ByCategory;
+	};
+
+	template<typename T>
+	bool readValue(std::FILE* file, T& value)
+	{
+		return std::fread(&value, sizeof(value), 1, file) == 1;
+	}
+
+	bool readSnapshot(const char* filename, Snapshot& snapshot)
+	{
+		std::FILE* file = std::fopen(filename, "rb");
+		if (!file)
+		{
+			std::fprintf(stderr, "Can't open %s\n", filename);
+			return false;
+		}
+
+		bool succeeded = false;
+
+		std::vector<std::string> strings(1);
+
+		auto getString = [&strings](std::uint32_t id) -> const std::string&
+		{
+			return id < strings.size() ? strings[id] : strings[0];
+		};
+
+		Baroque::Memory::HeapSnapshotHeader header;
+		if (readValue(file, header) && header.Magic == Baroque::Memory::HeapSnapshotMagic && header.Version == Baroque::Memory::HeapSnapshotVersion)
+		{
+			Baroque::Memory::HeapSnapshotRecordType recordType;
+
+			while (readValue(file, recordType))
+			{
+				if (recordType == Baroque::Memory::HeapSnapshotRecordType::End)
+				{
+					succeeded = true;
+					break;
+				}
+
+				if (recordType == Baroque::Memory::HeapSnapshotRecordType::String)
+				{
+					std::uint32_t id;
+					std::uint32_t length;
+					if (!readValue(file, id) || !readValue(file, length))
+					{
+						break;
+					}
+
+					std::string string(length, '\0');
+					if (length && std::fread(&string[0], length, 1, file) != 1)
+					{
+						break;
+					}
+
+					if (id >= strings.size())
+					{
+						strings.resize(id + 1);
+					}
+
+					strings[id] = std::move(string);
+				}
+				else if (recordType == Baroque::Memory::HeapSnapshotRecordType::Allocation)
+				{
+					Baroque::Memory::HeapSnapshotAllocation allocation;
+					if (!readValue(file, allocation))
+					{
+						break;
+					}
+
+					const auto sampledBytes = static_cast<std::int64_t>(allocation.SampledBytes);
+					const auto sampledCount = allocation.Size ? std::max<std::int64_t>((sampledBytes + static_cast<std::int64_t>(allocation.Size / 2)) / static_cast<std::int64_t>(allocation.Size), 1) : 1;
+
+					auto& locationUsage = snapshot.BySourceLocation[getString(allocation.FileNameId) + ":" + std::to_string(allocation.Line) + " (" + getString(allocation.FunctionId) + ")"];
+					locationUsage.Bytes += sampledBytes;
+					locationUsage.Count += sampledCount;
+
+					auto& categoryUsage = snapshot.ByCategory[getString(allocation.CategoryNameId)];
+					categoryUsage.Bytes += sampledBytes;
+					categoryUsage.Count += sampledCount;
+				}
+				else
+				{
+					break;
+				}
+			}
+		}
+
+		std::fclose(file);
+
+		if (!succeeded)
+		{
+			std::fprintf(stderr, "%s is not a valid heap snapshot\n", filename);
+		}
+
+		return succeeded;
+	}
+
+	void printGrowth(const char* title, const UsageMap& before, const UsageMap& after, std::size_t maximumRows)
+	{
+		std::vector<std::pair<std::string, Usage>> growth;
+
+		for (auto& afterUsage : after)
+		{
+			Usage delta = afterUsage.second;
+
+			auto it = before.find(afterUsage.first);
+			if (it != before.end())
+			{
+				delta.Bytes -= it->second.Bytes;
+				delta.Count -= it->second.Count;
+			}
+
+			growth.emplace_back(afterUsage.first, delta);
+		}
+
+		for (auto& beforeUsage : before)
+		{
+			if (after.find(beforeUsage.first) == after.end())
+			{
+				growth.emplace_back(beforeUsage.first, Usage{ -beforeUsage.second.Bytes, -beforeUsage.second.Count });
+			}
+		}
+
+		growth.erase(std::remove_if(growth.begin(), growth.end(), [](auto& entry) { return entry.second.Bytes == 0 && entry.second.Count == 0; }), growth.end());
+
+		std::sort(growth.begin(), growth.end(), [](auto& left, auto& right) { return left.second.Bytes > right.second.Bytes; });
+
+		std::int64_t totalBytes = 0;
+		std::int64_t totalCount = 0;
+
+		for (auto& entry : growth)
+		{
+			totalBytes += entry.second.Bytes;
+			totalCount += entry.second.Count;
+		}
+
+		std::printf("%s: %+" PRId64 " bytes, %+" PRId64 " allocations\n", title, totalBytes, totalCount);
+
+		for (std::size_t i = 0; i < growth.size() && i < maximumRows; ++i)
+		{
+			std::printf("  %+14" PRId64 " bytes %+10" PRId64 " allocations  %s\n", growth[i].second.Bytes, growth[i].second.Count, growth[i].first.c_str());
+		}
+
+		std::printf("\n");
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		std::fprintf(stderr, "Usage: %s <before> <after> [maximum rows]\n", argv[0]);
+		return 1;
+	}
+
+	const std::size_t maximumRows = argc > 3 ? static_cast<std::size_t>(std::strtoul(argv[3], nullptr, 10)) : 30;
+
+	Snapshot before;
+	Snapshot after;
+
+	if (!readSnapshot(argv[1], before) || !readSnapshot(argv[2], after))
+	{
+		return 1;
+	}
+
+	printGrowth("Growth by category", before.ByCategory, after.ByCategory, maximumRows);
+	printGrowth("Growth by source location", before.BySourceLocation, after.BySourceLocation, maximumRows);
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include "Core/Containers/Array.h"
+#include "Core/Containers/GrowthPolicy.h"
+#include "Core/Memory/BucketizerAllocator.h"
+#include "Core/Memory/MallocAllocator.h"
+#include "Core/Memory/ThreadCachingAllocator.h"
+
+namespace
+{
+	// Blocks are given in 48 bytes steps
+	struct SteppedAllocator : Baroque::Memory::MallocAllocator
+	{
+		static std::size_t GetAllocationSize(const std::size_t size)
+		{
+			return (size + 47) / 48 * 48;
+		}
+	};
+
+	BAROQUE_DEFINE_ALLOCATOR(TestSteppedAllocator, SteppedAllocator);
+	BAROQUE_DEFINE_ALLOCATOR(TestMallocAllocator, Baroque::Memory::MallocAllocator);
+
+	template<typename GrowthPolicy>
+	std::size_t capacityAfterAdds(std::size_t count)
+	{
+		Baroque::Array<std::uint32_t, TestMallocAllocator, GrowthPolicy> values;
+
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			values.Add(static_cast<std::uint32_t>(i));
+		}
+
+		return values.Capacity();
+	}
+}
+
+TEST(ArrayGrowthPolicy, ShouldGrowGeometrically)
+{
+	EXPECT_EQ(capacityAfterAdds<Baroque::DoublingGrowth>(1), 4u);
+	EXPECT_EQ(capacityAfterAdds<Baroque::DoublingGrowth>(5), 8u);
+	EXPECT_EQ(capacityAfterAdds<Baroque::DoublingGrowth>(100), 128u);
+
+	EXPECT_EQ(capacityAfterAdds<Baroque::OneAndHalfGrowth>(1), 4u);
+	EXPECT_EQ(capacityAfterAdds<Baroque::OneAndHalfGrowth>(5), 6u);
+	EXPECT_EQ(capacityAfterAdds<Baroque::OneAndHalfGrowth>(7), 9u);
+	EXPECT_EQ(capacityAfterAdds<Baroque::OneAndHalfGrowth>(10), 13u);
+}
+
+TEST(ArrayGrowthPolicy, ShouldRoundToTheAllocationSize)
+{
+	Baroque::Array<std::uint32_t, TestSteppedAllocator, Baroque::SizeClassGrowth<>> values;
+
+	values.Add(1);
+	EXPECT_EQ(values.Capacity(), 12u);
+
+	for (std::uint32_t i = 0; i < 12; ++i)
+	{
+		values.Add(i);
+	}
+
+	EXPECT_EQ(values.Capacity(), 24u);
+}
+
+TEST(ArrayGrowthPolicy, ShouldLandOnAllocatorSizeClasses)
+{
+	using Policy = Baroque::SizeClassGrowth<Baroque::OneAndHalfGrowth>;
+
+	for (std::size_t capacity : { 0u, 4u, 100u, 1000u, 10000u, 100000u })
+	{
+		auto newCapacity = Policy::NextCapacity<Baroque::Memory::ThreadCachingAllocator>(capacity, capacity + 1, 12);
+
+		EXPECT_GT(newCapacity, capacity);
+		EXPECT_LE(newCapacity * 12, Baroque::Memory::ThreadCachingAllocator::GetAllocationSize(newCapacity * 12));
+		EXPECT_GT((newCapacity + 1) * 12, Baroque::Memory::ThreadCachingAllocator::GetAllocationSize(newCapacity * 12));
+	}
+
+	using Buckets = Baroque::Memory::BucketizerAllocator<16, 512, 16>;
+
+	// 13 items of 10 bytes take the 144 bytes bucket, it holds 14
+	EXPECT_EQ(Policy::NextCapacity<Buckets>(9, 10, 10), 14u);
+}
+
+TEST(ArrayGrowthPolicy, ShouldRoundLargeArraysToPages)
+{
+	using Policy = Baroque::PageGrowth<Baroque::OneAndHalfGrowth, 4096>;
+
+	const auto pageSize = Baroque::Memory::VirtualMemoryAllocator::GetPageSize();
+
+	EXPECT_EQ(Policy::NextCapacity<Baroque::Memory::MallocAllocator>(10, 11, 8), 15u);
+
+	auto newCapacity = Policy::NextCapacity<Baroque::Memory::MallocAllocator>(1000, 1001, 8);
+	EXPECT_EQ(newCapacity * 8 % pageSize, 0u);
+	EXPECT_GE(newCapacity, 1500u);
+}
+
+TEST(ArrayGrowthPolicy, ShouldNotGrowWhenTheItemsFit)
+{
+	Baroque::Array<std::uint32_t, TestMallocAllocator, Baroque::DoublingGrowth> values;
+	values.Reserve(10);
+
+	values.Add({ 1, 2, 3 });
+	values.Add({ 4, 5, 6 });
+	EXPECT_EQ(values.Capacity(), 10u);
+
+	values.Insert(0, { 7, 8, 9, 10 });
+	EXPECT_EQ(values.Capacity(), 10u);
+	EXPECT_EQ(values.Size(), 10u);
+
+	values.Add({ 11, 12, 13 });
+	EXPECT_EQ(values.Capacity(), 20u);
+	EXPECT_EQ(values[12], 13u);
+
+	values.Add({ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19 });
+	EXPECT_EQ(values.Capacity(), 40u);
+	EXPECT_EQ(values.Size(), 33u);
+}
\ No newline at end of file
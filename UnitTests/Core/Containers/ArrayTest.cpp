@@ -890,7 +890,7 @@ TEST(Array, RemoveByValue)
 
 	EXPECT_EQ(TestComplexType::DtorCount, 3);
 	EXPECT_EQ(TestComplexType::CopyCtorCount, 0);
-	EXPECT_EQ(TestComplexType::MoveCtorCount, 3);
+	EXPECT_EQ(TestComplexType::MoveCtorCount, 2);
 
 	EXPECT_EQ(removed, 2);
 	EXPECT_EQ(array.Size(), 3);
@@ -923,7 +923,7 @@ TEST(Array, RemoveWithPredicate)
 
 	EXPECT_EQ(TestComplexType::DtorCount, 2);
 	EXPECT_EQ(TestComplexType::CopyCtorCount, 0);
-	EXPECT_EQ(TestComplexType::MoveCtorCount, 3);
+	EXPECT_EQ(TestComplexType::MoveCtorCount, 2);
 
 	EXPECT_EQ(removed, 2);
 	EXPECT_EQ(array.Size(), 3);
@@ -934,6 +934,122 @@ TEST(Array, RemoveWithPredicate)
 	}
 }
 
+TEST(Array, RemoveWithPredicateShouldKeepOrderOfRuns)
+{
+	Baroque::Array<int> array;
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		array.Add(i);
+	}
+
+	auto removed = array.RemoveByPredicate([](int item) {
+		return item % 7 == 0 || (item >= 500 && item < 600);
+	});
+
+	Baroque::Array<int> expected;
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		if (!(i % 7 == 0 || (i >= 500 && i < 600)))
+		{
+			expected.Add(i);
+		}
+	}
+
+	EXPECT_EQ(removed, 1000 - expected.Size());
+	EXPECT_EQ(array, expected);
+}
+
+TEST(Array, RemoveWithPredicateShouldRemoveAllOrNothing)
+{
+	Baroque::Array<int> array{ 1, 2, 3 };
+
+	auto removeNothing = [](int) { return false; };
+	auto removeAll = [](int) { return true; };
+
+	EXPECT_EQ(array.RemoveByPredicate(removeNothing), 0);
+	EXPECT_EQ(array.Size(), 3);
+
+	EXPECT_EQ(array.RemoveByPredicate(removeAll), 3);
+	EXPECT_TRUE(array.IsEmpty());
+
+	EXPECT_EQ(array.RemoveByPredicate(removeAll), 0);
+}
+
+TEST(Array, RemoveUnordered)
+{
+	Baroque::Array<TestComplexType> array;
+
+	array.Add(1);
+	array.Add(2);
+	array.Add(3);
+	array.Add(2);
+	array.Add(4);
+
+	TestComplexType::Reset();
+
+	auto removed = array.RemoveUnordered(TestComplexType{ 2 });
+
+	EXPECT_EQ(TestComplexType::DtorCount, 3);
+	EXPECT_EQ(TestComplexType::CopyCtorCount, 0);
+	EXPECT_EQ(TestComplexType::MoveCtorCount, 1);
+
+	EXPECT_EQ(removed, 2);
+	ASSERT_EQ(array.Size(), 3);
+	EXPECT_EQ(array[0].Value, 1);
+	EXPECT_EQ(array[1].Value, 4);
+	EXPECT_EQ(array[2].Value, 3);
+}
+
+TEST(Array, RemoveWithPredicateUnordered)
+{
+	Baroque::Array<int> array;
+
+	for (int i = 0; i < 100; ++i)
+	{
+		array.Add(i);
+	}
+
+	auto removed = array.RemoveByPredicateUnordered([](int item) {
+		return item % 3 != 0;
+	});
+
+	EXPECT_EQ(removed, 66);
+	ASSERT_EQ(array.Size(), 34);
+
+	int sum = 0;
+
+	for (auto item : array)
+	{
+		EXPECT_EQ(item % 3, 0);
+		sum += item;
+	}
+
+	EXPECT_EQ(sum, 3 * (33 * 34 / 2));
+}
+
+TEST(Array, RemoveAtSwap)
+{
+	Baroque::Array<int> array{ 10, 20, 30, 40 };
+
+	array.RemoveAtSwap(1);
+
+	ASSERT_EQ(array.Size(), 3);
+	EXPECT_EQ(array[0], 10);
+	EXPECT_EQ(array[1], 40);
+	EXPECT_EQ(array[2], 30);
+
+	array.RemoveAtSwap(2);
+
+	ASSERT_EQ(array.Size(), 2);
+	EXPECT_EQ(array[1], 40);
+
+	array.RemoveAtSwap(5);
+
+	EXPECT_EQ(array.Size(), 2);
+}
+
 TEST(Array, RemoveAt)
 {
 	static const int ExpectedResults[]{
@@ -1415,7 +1531,7 @@ TEST(SmallArray, ShouldCopyCtorProperlyWhenOnHeap)
 	EXPECT_FALSE(copyData >= copyStartArray && copyData <= copyEndArray);
 }
 
-TEST(SmallArray, SmallArrayOnStackShouldNeverMoveCtor)
+TEST(SmallArray, MoveCtorShouldMoveItemsWhenOnStack)
 {
 	Baroque::SmallArray<int, 6> original;
 
@@ -1424,27 +1540,32 @@ TEST(SmallArray, SmallArrayOnStackShouldNeverMoveCtor)
 		original.Add(i + 1);
 	}
 
-	std::uint8_t* originalStartArray = reinterpret_cast<std::uint8_t*>(&original);
-	std::uint8_t* originalEndArray = originalStartArray + sizeof(original);
-	auto* stackData = reinterpret_cast<std::uint8_t*>(original.Data());
-	EXPECT_TRUE(stackData >= originalStartArray && stackData <= originalEndArray);
-
-	auto originalSize = original.Size();
-	auto originalCapacity = original.Capacity();
 	auto originalData = original.Data();
 
 	Baroque::SmallArray<int, 6> moved(std::move(original));
 
-	EXPECT_EQ(moved.Size(), originalSize);
-	EXPECT_EQ(moved.Capacity(), originalCapacity);
-	EXPECT_NE(moved.Data(), originalData);
+	std::uint8_t* movedStartArray = reinterpret_cast<std::uint8_t*>(&moved);
+	std::uint8_t* movedEndArray = movedStartArray + sizeof(moved);
+	auto* movedData = reinterpret_cast<std::uint8_t*>(moved.Data());
+	EXPECT_TRUE(movedData >= movedStartArray && movedData <= movedEndArray);
+
+	EXPECT_EQ(moved.Size(), 6);
+	EXPECT_EQ(moved.Capacity(), 6);
 
-	EXPECT_EQ(original.Size(), originalSize);
-	EXPECT_EQ(original.Capacity(), originalCapacity);
+	for (int i = 0; i < 6; ++i)
+	{
+		EXPECT_EQ(moved[i], i + 1);
+	}
+
+	EXPECT_EQ(original.Size(), 0);
+	EXPECT_EQ(original.Capacity(), 6);
+	EXPECT_EQ(original.Data(), originalData);
+
+	original.Add(42);
 	EXPECT_EQ(original.Data(), originalData);
 }
 
-TEST(SmallArray, SmallArrayOnHeapShouldNeverMoveCtor)
+TEST(SmallArray, MoveCtorShouldStealHeapData)
 {
 	Baroque::SmallArray<int, 6> original;
 
@@ -1453,11 +1574,6 @@ TEST(SmallArray, SmallArrayOnHeapShouldNeverMoveCtor)
 		original.Add(i + 1);
 	}
 
-	std::uint8_t* originalStartArray = reinterpret_cast<std::uint8_t*>(&original);
-	std::uint8_t* originalEndArray = originalStartArray + sizeof(original);
-	auto* stackData = reinterpret_cast<std::uint8_t*>(original.Data());
-	EXPECT_FALSE(stackData >= originalStartArray && stackData <= originalEndArray);
-
 	auto originalSize = original.Size();
 	auto originalCapacity = original.Capacity();
 	auto originalData = original.Data();
@@ -1466,11 +1582,47 @@ TEST(SmallArray, SmallArrayOnHeapShouldNeverMoveCtor)
 
 	EXPECT_EQ(moved.Size(), originalSize);
 	EXPECT_EQ(moved.Capacity(), originalCapacity);
-	EXPECT_NE(moved.Data(), originalData);
+	EXPECT_EQ(moved.Data(), originalData);
 
-	EXPECT_EQ(original.Size(), originalSize);
-	EXPECT_EQ(original.Capacity(), originalCapacity);
-	EXPECT_EQ(original.Data(), originalData);
+	EXPECT_EQ(original.Size(), 0);
+	EXPECT_EQ(original.Capacity(), 0);
+	EXPECT_EQ(original.Data(), nullptr);
+
+	original.Add(42);
+
+	std::uint8_t* originalStartArray = reinterpret_cast<std::uint8_t*>(&original);
+	std::uint8_t* originalEndArray = originalStartArray + sizeof(original);
+	auto* stackData = reinterpret_cast<std::uint8_t*>(original.Data());
+	EXPECT_TRUE(stackData >= originalStartArray && stackData <= originalEndArray);
+	EXPECT_EQ(original[0], 42);
+}
+
+TEST(SmallArray, MoveCtorShouldMoveComplexTypeWhenOnStack)
+{
+	TestComplexType::Reset();
+
+	{
+		Baroque::SmallArray<TestComplexType, 4> original;
+
+		original.Emplace(1);
+		original.Emplace(2);
+		original.Emplace(3);
+
+		TestComplexType::Reset();
+
+		Baroque::SmallArray<TestComplexType, 4> moved(std::move(original));
+
+		EXPECT_EQ(TestComplexType::MoveCtorCount, 3);
+		EXPECT_EQ(TestComplexType::CopyCtorCount, 0);
+		// Moved-from items don't count their destruction
+		EXPECT_EQ(TestComplexType::DtorCount, 0);
+
+		EXPECT_EQ(moved.Size(), 3);
+		EXPECT_EQ(moved[2].Value, 3);
+		EXPECT_EQ(original.Size(), 0);
+	}
+
+	EXPECT_EQ(TestComplexType::DtorCount, 3);
 }
 
 TEST(SmallArray, ShouldCopyAssignProperlyWhenOnStack)
@@ -1529,7 +1681,7 @@ TEST(SmallArray, ShouldCopyAssignProperlyWhenOnHeap)
 	EXPECT_FALSE(copyData >= copyStartArray && copyData <= copyEndArray);
 }
 
-TEST(SmallArray, SmallArrayOnStackShouldNeverMoveAssign)
+TEST(SmallArray, MoveAssignShouldMoveItemsWhenOnStack)
 {
 	Baroque::SmallArray<int, 6> original;
 
@@ -1538,29 +1690,28 @@ TEST(SmallArray, SmallArrayOnStackShouldNeverMoveAssign)
 		original.Add(i + 1);
 	}
 
-	std::uint8_t* originalStartArray = reinterpret_cast<std::uint8_t*>(&original);
-	std::uint8_t* originalEndArray = originalStartArray + sizeof(original);
-	auto* stackData = reinterpret_cast<std::uint8_t*>(original.Data());
-	EXPECT_TRUE(stackData >= originalStartArray && stackData <= originalEndArray);
-
-	auto originalSize = original.Size();
-	auto originalCapacity = original.Capacity();
 	auto originalData = original.Data();
 
 	Baroque::SmallArray<int, 6> moved;
+	moved.Add(100);
 
 	moved = std::move(original);
 
-	EXPECT_EQ(moved.Size(), originalSize);
-	EXPECT_EQ(moved.Capacity(), originalCapacity);
-	EXPECT_NE(moved.Data(), originalData);
+	std::uint8_t* movedStartArray = reinterpret_cast<std::uint8_t*>(&moved);
+	std::uint8_t* movedEndArray = movedStartArray + sizeof(moved);
+	auto* movedData = reinterpret_cast<std::uint8_t*>(moved.Data());
+	EXPECT_TRUE(movedData >= movedStartArray && movedData <= movedEndArray);
+
+	EXPECT_EQ(moved.Size(), 6);
+	EXPECT_EQ(moved.Capacity(), 6);
+	EXPECT_EQ(moved[0], 1);
+	EXPECT_EQ(moved[5], 6);
 
-	EXPECT_EQ(original.Size(), originalSize);
-	EXPECT_EQ(original.Capacity(), originalCapacity);
+	EXPECT_EQ(original.Size(), 0);
 	EXPECT_EQ(original.Data(), originalData);
 }
 
-TEST(SmallArray, SmallArrayOnHeapShouldNeverMoveAssign)
+TEST(SmallArray, MoveAssignShouldStealHeapData)
 {
 	Baroque::SmallArray<int, 6> original;
 
@@ -1569,24 +1720,125 @@ TEST(SmallArray, SmallArrayOnHeapShouldNeverMoveAssign)
 		original.Add(i + 1);
 	}
 
-	std::uint8_t* originalStartArray = reinterpret_cast<std::uint8_t*>(&original);
-	std::uint8_t* originalEndArray = originalStartArray + sizeof(original);
-	auto* stackData = reinterpret_cast<std::uint8_t*>(original.Data());
-	EXPECT_FALSE(stackData >= originalStartArray && stackData <= originalEndArray);
-
 	auto originalSize = original.Size();
 	auto originalCapacity = original.Capacity();
 	auto originalData = original.Data();
 
 	Baroque::SmallArray<int, 6> moved;
-	
+
+	for (int i = 0; i < 10; ++i)
+	{
+		moved.Add(i);
+	}
+
 	moved = std::move(original);
 
 	EXPECT_EQ(moved.Size(), originalSize);
 	EXPECT_EQ(moved.Capacity(), originalCapacity);
-	EXPECT_NE(moved.Data(), originalData);
+	EXPECT_EQ(moved.Data(), originalData);
+	EXPECT_EQ(moved[15], 16);
 
-	EXPECT_EQ(original.Size(), originalSize);
-	EXPECT_EQ(original.Capacity(), originalCapacity);
-	EXPECT_EQ(original.Data(), originalData);
+	EXPECT_EQ(original.Size(), 0);
+	EXPECT_EQ(original.Data(), nullptr);
+}
+
+TEST(SmallArray, ShouldBeReturnedFromFunctions)
+{
+	auto makeArray = [](int count, bool other)
+	{
+		Baroque::SmallArray<int, 6> first;
+		Baroque::SmallArray<int, 6> second;
+
+		for (int i = 0; i < count; ++i)
+		{
+			first.Add(i);
+			second.Add(-i);
+		}
+
+		// Two candidates, no copy elision
+		return other ? std::move(second) : std::move(first);
+	};
+
+	auto onStack = makeArray(4, false);
+	ASSERT_EQ(onStack.Size(), 4);
+	EXPECT_EQ(onStack[3], 3);
+
+	auto onHeap = makeArray(20, true);
+	ASSERT_EQ(onHeap.Size(), 20);
+	EXPECT_EQ(onHeap[19], -19);
+}
+
+TEST(SmallArray, SwapShouldExchangeHeapData)
+{
+	Baroque::SmallArray<int, 4> left;
+	Baroque::SmallArray<int, 4> right;
+
+	for (int i = 0; i < 10; ++i)
+	{
+		left.Add(i);
+		right.Add(i * 10);
+	}
+
+	right.Add(100);
+
+	auto leftData = left.Data();
+	auto rightData = right.Data();
+
+	left.Swap(right);
+
+	EXPECT_EQ(left.Data(), rightData);
+	EXPECT_EQ(right.Data(), leftData);
+	EXPECT_EQ(left.Size(), 11);
+	EXPECT_EQ(right.Size(), 10);
+	EXPECT_EQ(left[10], 100);
+}
+
+TEST(SmallArray, SwapShouldMoveItemsWhenOnStack)
+{
+	Baroque::SmallArray<int, 4> left;
+	Baroque::SmallArray<int, 4> right;
+
+	left.Add({ 1, 2 });
+
+	for (int i = 0; i < 10; ++i)
+	{
+		right.Add(i * 10);
+	}
+
+	auto rightData = right.Data();
+
+	left.Swap(right);
+
+	EXPECT_EQ(left.Data(), rightData);
+	ASSERT_EQ(left.Size(), 10);
+	EXPECT_EQ(left[9], 90);
+
+	std::uint8_t* rightStartArray = reinterpret_cast<std::uint8_t*>(&right);
+	std::uint8_t* rightEndArray = rightStartArray + sizeof(right);
+	auto* rightStackData = reinterpret_cast<std::uint8_t*>(right.Data());
+	EXPECT_TRUE(rightStackData >= rightStartArray && rightStackData <= rightEndArray);
+	ASSERT_EQ(right.Size(), 2);
+	EXPECT_EQ(right[0], 1);
+	EXPECT_EQ(right[1], 2);
+
+	left.Swap(right);
+
+	ASSERT_EQ(left.Size(), 2);
+	EXPECT_EQ(left[1], 2);
+	EXPECT_EQ(right.Data(), rightData);
+}
+
+TEST(Array, SwapShouldExchangeData)
+{
+	Baroque::Array<int> left{ 1, 2, 3 };
+	Baroque::Array<int> right{ 4 };
+
+	auto leftData = left.Data();
+
+	left.Swap(right);
+
+	EXPECT_EQ(right.Data(), leftData);
+	ASSERT_EQ(left.Size(), 1);
+	EXPECT_EQ(left[0], 4);
+	EXPECT_EQ(right.Size(), 3);
 }
\ No newline at end of file
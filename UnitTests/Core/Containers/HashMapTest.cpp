@@ -0,0 +1,416 @@
+#include <gtest/gtest.h>
+
+#include "Core/Containers/HashMap.h"
+#include "Core/Containers/StringView.h"
+#include "UnitTests/Core/TestComplexType.h"
+
+namespace
+{
+	// Every key in the same probe sequence
+	struct ConstantHash
+	{
+		std::uint64_t operator()(int) const
+		{
+			return 42;
+		}
+	};
+
+	struct Identifier
+	{
+		int Value;
+	};
+
+	bool operator==(const Identifier& left, int right)
+	{
+		return left.Value == right;
+	}
+
+	bool operator==(const Identifier& left, const Identifier& right)
+	{
+		return left.Value == right.Value;
+	}
+
+	// Identifier keys can be searched with their int value
+	struct IdentifierHash
+	{
+		std::uint64_t operator()(const Identifier& identifier) const
+		{
+			return Baroque::Hash<int>()(identifier.Value);
+		}
+
+		std::uint64_t operator()(int value) const
+		{
+			return Baroque::Hash<int>()(value);
+		}
+	};
+}
+
+TEST(HashMap, ShouldBeEmptyByDefault)
+{
+	Baroque::HashMap<int, int> map;
+
+	EXPECT_TRUE(map.IsEmpty());
+	EXPECT_EQ(map.Size(), 0);
+	EXPECT_EQ(map.Capacity(), 0);
+	EXPECT_EQ(map.Find(1), nullptr);
+	EXPECT_FALSE(map.Contains(1));
+	EXPECT_FALSE(map.Remove(1));
+	EXPECT_TRUE(map.begin() == map.end());
+}
+
+TEST(HashMap, ShouldFindAddedEntries)
+{
+	Baroque::HashMap<int, int> map;
+
+	for (int i = 0; i < 10000; ++i)
+	{
+		EXPECT_TRUE(map.Add(i, i * 3));
+	}
+
+	EXPECT_EQ(map.Size(), 10000);
+
+	for (int i = 0; i < 10000; ++i)
+	{
+		auto* value = map.Find(i);
+		ASSERT_NE(value, nullptr);
+		EXPECT_EQ(*value, i * 3);
+	}
+
+	EXPECT_EQ(map.Find(10000), nullptr);
+	EXPECT_EQ(map.Find(-1), nullptr);
+}
+
+TEST(HashMap, AddShouldKeepCurrentValue)
+{
+	Baroque::HashMap<int, int> map;
+
+	EXPECT_TRUE(map.Add(1, 10));
+	EXPECT_FALSE(map.Add(1, 20));
+
+	EXPECT_EQ(*map.Find(1), 10);
+	EXPECT_EQ(map.Size(), 1);
+}
+
+TEST(HashMap, SetShouldReplaceValue)
+{
+	Baroque::HashMap<int, int> map;
+
+	map.Set(1, 10);
+	auto& value = map.Set(1, 20);
+
+	EXPECT_EQ(value, 20);
+	EXPECT_EQ(*map.Find(1), 20);
+	EXPECT_EQ(map.Size(), 1);
+}
+
+TEST(HashMap, FindOrAddShouldDefaultConstruct)
+{
+	Baroque::HashMap<int, int> map;
+
+	EXPECT_EQ(map.FindOrAdd(5), 0);
+
+	map[5] += 3;
+	map[5] += 4;
+	map[6] = 1;
+
+	EXPECT_EQ(*map.Find(5), 7);
+	EXPECT_EQ(*map.Find(6), 1);
+	EXPECT_EQ(map.Size(), 2);
+}
+
+TEST(HashMap, ShouldInitWithInitializerList)
+{
+	Baroque::HashMap<int, int> map{ { 1, 10 }, { 2, 20 }, { 1, 30 } };
+
+	EXPECT_EQ(map.Size(), 2);
+	EXPECT_EQ(*map.Find(1), 30);
+	EXPECT_EQ(*map.Find(2), 20);
+}
+
+TEST(HashMap, RemoveShouldKeepOtherEntries)
+{
+	Baroque::HashMap<int, int> map;
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		map.Add(i, i);
+	}
+
+	for (int i = 0; i < 1000; i += 2)
+	{
+		EXPECT_TRUE(map.Remove(i));
+	}
+
+	EXPECT_FALSE(map.Remove(0));
+	EXPECT_EQ(map.Size(), 500);
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		EXPECT_EQ(map.Contains(i), i % 2 == 1);
+	}
+}
+
+TEST(HashMap, ShouldWorkWhenAllKeysCollide)
+{
+	Baroque::HashMap<int, int, ConstantHash> map;
+
+	for (int i = 0; i < 100; ++i)
+	{
+		map.Add(i, i);
+	}
+
+	for (int i = 0; i < 100; i += 3)
+	{
+		EXPECT_TRUE(map.Remove(i));
+	}
+
+	for (int i = 0; i < 100; ++i)
+	{
+		EXPECT_EQ(map.Contains(i), i % 3 != 0);
+	}
+
+	for (int i = 0; i < 100; i += 3)
+	{
+		EXPECT_TRUE(map.Add(i, -i));
+	}
+
+	EXPECT_EQ(map.Size(), 100);
+	EXPECT_EQ(*map.Find(99), -99);
+}
+
+TEST(HashMap, AddAndRemoveShouldNotGrow)
+{
+	Baroque::HashMap<int, int> map;
+
+	map.Reserve(100);
+
+	const auto capacity = map.Capacity();
+
+	for (int i = 0; i < 100000; ++i)
+	{
+		map.Add(i, i);
+
+		if (i >= 50)
+		{
+			map.Remove(i - 50);
+		}
+	}
+
+	EXPECT_EQ(map.Size(), 50);
+	EXPECT_EQ(map.Capacity(), capacity);
+}
+
+TEST(HashMap, ReserveShouldKeepEntriesInPlace)
+{
+	Baroque::HashMap<int, int> map;
+
+	map.Reserve(1000);
+
+	auto* first = &map.FindOrAdd(0);
+
+	for (int i = 1; i < 1000; ++i)
+	{
+		map.Add(i, i);
+	}
+
+	EXPECT_EQ(map.Find(0), first);
+	EXPECT_GE(map.Capacity(), 1000);
+}
+
+TEST(HashMap, ClearShouldKeepCapacity)
+{
+	Baroque::HashMap<int, int> map;
+
+	for (int i = 0; i < 100; ++i)
+	{
+		map.Add(i, i);
+	}
+
+	const auto capacity = map.Capacity();
+
+	map.Clear();
+
+	EXPECT_TRUE(map.IsEmpty());
+	EXPECT_EQ(map.Capacity(), capacity);
+	EXPECT_FALSE(map.Contains(1));
+
+	map.Add(1, 1);
+	EXPECT_TRUE(map.Contains(1));
+}
+
+TEST(HashMap, ShouldIterateAllEntries)
+{
+	Baroque::HashMap<int, int> map;
+
+	for (int i = 0; i < 100; ++i)
+	{
+		map.Add(i, i * 2);
+	}
+
+	int count = 0;
+	int sum = 0;
+
+	for (auto& entry : map)
+	{
+		EXPECT_EQ(entry.Value, entry.Key * 2);
+
+		++count;
+		sum += entry.Key;
+	}
+
+	EXPECT_EQ(count, 100);
+	EXPECT_EQ(sum, 99 * 100 / 2);
+}
+
+TEST(HashMap, RemoveByPredicate)
+{
+	Baroque::HashMap<int, int> map;
+
+	for (int i = 0; i < 100; ++i)
+	{
+		map.Add(i, i);
+	}
+
+	auto removed = map.RemoveByPredicate([](const Baroque::KeyValuePair<int, int>& entry) {
+		return entry.Value >= 10;
+	});
+
+	EXPECT_EQ(removed, 90);
+	EXPECT_EQ(map.Size(), 10);
+	EXPECT_TRUE(map.Contains(9));
+	EXPECT_FALSE(map.Contains(10));
+}
+
+TEST(HashMap, ShouldDestroyComplexValues)
+{
+	TestComplexType::Reset();
+
+	{
+		Baroque::HashMap<int, TestComplexType> map;
+
+		for (int i = 0; i < 100; ++i)
+		{
+			map.Add(i, i);
+		}
+
+		EXPECT_EQ(TestComplexType::CtorCount, 100);
+
+		map.Remove(5);
+		EXPECT_EQ(TestComplexType::DtorCount, 1);
+	}
+
+	EXPECT_EQ(TestComplexType::DtorCount, 100);
+}
+
+TEST(HashMap, CopyShouldDuplicateEntries)
+{
+	Baroque::HashMap<int, int> original;
+
+	for (int i = 0; i < 100; ++i)
+	{
+		original.Add(i, i);
+	}
+
+	Baroque::HashMap<int, int> copy(original);
+
+	EXPECT_EQ(copy, original);
+
+	copy.Set(1, 100);
+
+	EXPECT_NE(copy, original);
+	EXPECT_EQ(*original.Find(1), 1);
+
+	original = copy;
+
+	EXPECT_EQ(original, copy);
+}
+
+TEST(HashMap, MoveShouldTakeStorage)
+{
+	Baroque::HashMap<int, int> original;
+
+	for (int i = 0; i < 100; ++i)
+	{
+		original.Add(i, i);
+	}
+
+	auto* value = original.Find(42);
+
+	Baroque::HashMap<int, int> moved(std::move(original));
+
+	EXPECT_EQ(moved.Find(42), value);
+	EXPECT_EQ(moved.Size(), 100);
+	EXPECT_TRUE(original.IsEmpty());
+	EXPECT_EQ(original.Capacity(), 0);
+
+	original = std::move(moved);
+
+	EXPECT_EQ(original.Find(42), value);
+	EXPECT_TRUE(moved.IsEmpty());
+}
+
+TEST(HashMap, MoveShouldMoveInlineEntries)
+{
+	using SmallMap = Baroque::HashMap<int, int, Baroque::Hash<int>, Baroque::Memory::SmallAllocator<256>>;
+
+	SmallMap original;
+
+	for (int i = 0; i < 10; ++i)
+	{
+		original.Add(i, i);
+	}
+
+	std::uint8_t* originalStart = reinterpret_cast<std::uint8_t*>(&original);
+	auto* originalValue = reinterpret_cast<std::uint8_t*>(original.Find(3));
+	EXPECT_TRUE(originalValue >= originalStart && originalValue < originalStart + sizeof(original));
+
+	SmallMap moved(std::move(original));
+
+	std::uint8_t* movedStart = reinterpret_cast<std::uint8_t*>(&moved);
+	auto* movedValue = reinterpret_cast<std::uint8_t*>(moved.Find(3));
+	EXPECT_TRUE(movedValue >= movedStart && movedValue < movedStart + sizeof(moved));
+
+	EXPECT_EQ(moved.Size(), 10);
+	EXPECT_TRUE(original.IsEmpty());
+
+	original.Add(1, 1);
+	EXPECT_TRUE(original.Contains(1));
+}
+
+TEST(HashMap, Swap)
+{
+	Baroque::HashMap<int, int> left{ { 1, 1 } };
+	Baroque::HashMap<int, int> right{ { 2, 2 }, { 3, 3 } };
+
+	left.Swap(right);
+
+	EXPECT_EQ(left.Size(), 2);
+	EXPECT_TRUE(left.Contains(3));
+	EXPECT_EQ(right.Size(), 1);
+	EXPECT_TRUE(right.Contains(1));
+}
+
+TEST(HashMap, ShouldFindStringViewKeysWithLiterals)
+{
+	Baroque::HashMap<Baroque::StringView, int> map;
+
+	map.Add("first", 1);
+	map.Add("second", 2);
+
+	EXPECT_EQ(*map.Find("first"), 1);
+	EXPECT_EQ(*map.Find(Baroque::StringView("second")), 2);
+	EXPECT_EQ(map.Find("third"), nullptr);
+}
+
+TEST(HashMap, ShouldFindWithOtherKeyType)
+{
+	Baroque::HashMap<Identifier, int, IdentifierHash> map;
+
+	map.Add(Identifier{ 1 }, 10);
+	map.Add(Identifier{ 2 }, 20);
+
+	EXPECT_EQ(*map.Find(2), 20);
+	EXPECT_TRUE(map.Contains(1));
+	EXPECT_TRUE(map.Remove(1));
+	EXPECT_FALSE(map.Contains(Identifier{ 1 }));
+}
\ No newline at end of file
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include "Core/Containers/HashSet.h"
+
+TEST(HashSet, ShouldBeEmptyByDefault)
+{
+	Baroque::HashSet<int> set;
+
+	EXPECT_TRUE(set.IsEmpty());
+	EXPECT_FALSE(set.Contains(0));
+	EXPECT_EQ(set.Find(0), nullptr);
+	EXPECT_TRUE(set.begin() == set.end());
+}
+
+TEST(HashSet, AddShouldIgnoreDuplicates)
+{
+	Baroque::HashSet<int> set;
+
+	EXPECT_TRUE(set.Add(1));
+	EXPECT_TRUE(set.Add(2));
+	EXPECT_FALSE(set.Add(1));
+
+	EXPECT_EQ(set.Size(), 2);
+	EXPECT_TRUE(set.Contains(1));
+	EXPECT_TRUE(set.Contains(2));
+	EXPECT_EQ(*set.Find(2), 2);
+}
+
+TEST(HashSet, ShouldInitWithInitializerList)
+{
+	Baroque::HashSet<int> set{ 1, 2, 3, 2 };
+
+	EXPECT_EQ(set.Size(), 3);
+	EXPECT_TRUE(set.Contains(3));
+}
+
+TEST(HashSet, Remove)
+{
+	Baroque::HashSet<std::uint64_t> set;
+
+	for (std::uint64_t i = 0; i < 5000; ++i)
+	{
+		set.Add(i << 32);
+	}
+
+	for (std::uint64_t i = 0; i < 5000; i += 5)
+	{
+		EXPECT_TRUE(set.Remove(i << 32));
+	}
+
+	EXPECT_EQ(set.Size(), 4000);
+
+	for (std::uint64_t i = 0; i < 5000; ++i)
+	{
+		EXPECT_EQ(set.Contains(i << 32), i % 5 != 0);
+	}
+}
+
+TEST(HashSet, ShouldIterateAllValues)
+{
+	Baroque::HashSet<int> set;
+
+	for (int i = 0; i < 50; ++i)
+	{
+		set.Add(i);
+	}
+
+	int sum = 0;
+
+	for (int value : set)
+	{
+		sum += value;
+	}
+
+	EXPECT_EQ(sum, 49 * 50 / 2);
+}
+
+TEST(HashSet, ShouldGrowInlineStorage)
+{
+	// The first storage takes the whole stack, the old storage used to be freed under the new one when growing inside it
+	Baroque::HashSet<int, Baroque::Hash<int>, Baroque::Memory::SmallAllocator<512>> set;
+
+	for (int i = 0; i < 40; ++i)
+	{
+		set.Add(i);
+	}
+
+	auto* setStart = reinterpret_cast<const std::uint8_t*>(&set);
+	auto* value = reinterpret_cast<const std::uint8_t*>(set.Find(0));
+	EXPECT_TRUE(value >= setStart && value < setStart + sizeof(set));
+
+	for (int i = 0; i < 40; ++i)
+	{
+		EXPECT_TRUE(set.Contains(i));
+	}
+
+	for (int i = 40; i < 200; ++i)
+	{
+		set.Add(i);
+	}
+
+	EXPECT_EQ(set.Size(), 200);
+
+	for (int i = 0; i < 200; ++i)
+	{
+		EXPECT_TRUE(set.Contains(i));
+	}
+}
+
+TEST(HashSet, ShouldHashPointers)
+{
+	int values[10];
+
+	Baroque::HashSet<int*> set;
+
+	for (auto& value : values)
+	{
+		set.Add(&value);
+	}
+
+	EXPECT_EQ(set.Size(), 10);
+	EXPECT_TRUE(set.Contains(&values[4]));
+}
+
+TEST(HashSet, OperatorEquals)
+{
+	Baroque::HashSet<int> left{ 1, 2, 3 };
+	Baroque::HashSet<int> right{ 3, 2, 1 };
+
+	EXPECT_EQ(left, right);
+
+	right.Remove(2);
+
+	EXPECT_NE(left, right);
+}
\ No newline at end of file
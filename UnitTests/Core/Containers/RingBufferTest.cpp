@@ -0,0 +1,448 @@
+#include <gtest/gtest.h>
+
+#include "Core/Containers/Array.h"
+#include "Core/Containers/RingBuffer.h"
+#include "UnitTests/Core/TestComplexType.h"
+
+#include <limits>
+
+TEST(RingBuffer, ShouldBeEmptyByDefault)
+{
+	Baroque::RingBuffer<int> buffer;
+
+	EXPECT_TRUE(buffer.IsEmpty());
+	EXPECT_EQ(buffer.Size(), 0);
+	EXPECT_EQ(buffer.Capacity(), 0);
+	EXPECT_EQ(buffer.FirstSpan().Size(), 0);
+	EXPECT_EQ(buffer.SecondSpan().Size(), 0);
+	EXPECT_TRUE(buffer.begin() == buffer.end());
+
+	buffer.PopFront();
+	buffer.PopBack();
+
+	EXPECT_TRUE(buffer.IsEmpty());
+}
+
+TEST(RingBuffer, ShouldBeFirstInFirstOut)
+{
+	Baroque::RingBuffer<int> buffer;
+
+	for (int i = 0; i < 100; ++i)
+	{
+		buffer.PushBack(i);
+	}
+
+	EXPECT_EQ(buffer.Size(), 100);
+	EXPECT_TRUE(Baroque::Memory::IsPowerOfTwo(buffer.Capacity()));
+
+	for (int i = 0; i < 100; ++i)
+	{
+		EXPECT_EQ(buffer.Front(), i);
+		buffer.PopFront();
+	}
+
+	EXPECT_TRUE(buffer.IsEmpty());
+}
+
+TEST(RingBuffer, ShouldPushAndPopAtBothEnds)
+{
+	Baroque::RingBuffer<int> buffer;
+
+	buffer.PushBack(2);
+	buffer.PushFront(1);
+	buffer.PushBack(3);
+	buffer.PushFront(0);
+
+	ASSERT_EQ(buffer.Size(), 4);
+
+	for (int i = 0; i < 4; ++i)
+	{
+		EXPECT_EQ(buffer[i], i);
+	}
+
+	EXPECT_EQ(buffer.Front(), 0);
+	EXPECT_EQ(buffer.Back(), 3);
+
+	buffer.PopBack();
+	buffer.PopFront();
+
+	EXPECT_EQ(buffer.Front(), 1);
+	EXPECT_EQ(buffer.Back(), 2);
+}
+
+TEST(RingBuffer, ShouldNotGrowWhenUsedAsQueue)
+{
+	Baroque::RingBuffer<int> buffer;
+
+	buffer.Reserve(16);
+
+	const auto capacity = buffer.Capacity();
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		buffer.PushBack(i);
+
+		if (buffer.Size() > 10)
+		{
+			EXPECT_EQ(buffer.Front(), i - 10);
+			buffer.PopFront();
+		}
+	}
+
+	EXPECT_EQ(buffer.Capacity(), capacity);
+	EXPECT_EQ(buffer.Front(), 990);
+	EXPECT_EQ(buffer.Back(), 999);
+}
+
+TEST(RingBuffer, GrowShouldKeepOrderWhenWrapped)
+{
+	Baroque::RingBuffer<int> buffer;
+
+	buffer.Reserve(8);
+
+	for (int i = 0; i < 6; ++i)
+	{
+		buffer.PushBack(i);
+	}
+
+	for (int i = 0; i < 4; ++i)
+	{
+		buffer.PopFront();
+	}
+
+	for (int i = 6; i < 100; ++i)
+	{
+		buffer.PushBack(i);
+	}
+
+	ASSERT_EQ(buffer.Size(), 96);
+
+	int expected = 4;
+
+	for (int value : buffer)
+	{
+		EXPECT_EQ(value, expected++);
+	}
+}
+
+TEST(RingBuffer, SpansShouldCoverItemsInOrder)
+{
+	Baroque::RingBuffer<int> buffer;
+
+	buffer.Reserve(8);
+
+	for (int i = 0; i < 8; ++i)
+	{
+		buffer.PushBack(i);
+	}
+
+	EXPECT_EQ(buffer.FirstSpan().Size(), 8);
+	EXPECT_EQ(buffer.SecondSpan().Size(), 0);
+
+	buffer.PopFront();
+	buffer.PopFront();
+	buffer.PushBack(8);
+
+	auto first = buffer.FirstSpan();
+	auto second = buffer.SecondSpan();
+
+	ASSERT_EQ(first.Size(), 6);
+	ASSERT_EQ(second.Size(), 1);
+	EXPECT_EQ(first[0], 2);
+	EXPECT_EQ(first[5], 7);
+	EXPECT_EQ(second[0], 8);
+}
+
+TEST(RingBuffer, ShouldPushAndPopBulk)
+{
+	Baroque::RingBuffer<int> buffer;
+
+	buffer.Reserve(8);
+
+	int values[] = { 0, 1, 2, 3, 4, 5 };
+
+	buffer.PushBack(Baroque::ArrayView<int>(values, 6));
+
+	int popped[4] = {};
+
+	EXPECT_EQ(buffer.PopFront(Baroque::ArraySpan<int>(popped, 4)), 4);
+	EXPECT_EQ(popped[3], 3);
+
+	// Wraps around the end of the storage
+	buffer.PushBack(Baroque::ArrayView<int>(values, 6));
+
+	EXPECT_EQ(buffer.Size(), 8);
+	EXPECT_EQ(buffer.Capacity(), 8);
+	EXPECT_EQ(buffer.SecondSpan().Size(), 4);
+
+	int all[10] = {};
+
+	EXPECT_EQ(buffer.PopFront(Baroque::ArraySpan<int>(all, 10)), 8);
+
+	const int expected[] = { 4, 5, 0, 1, 2, 3, 4, 5 };
+
+	for (int i = 0; i < 8; ++i)
+	{
+		EXPECT_EQ(all[i], expected[i]);
+	}
+
+	EXPECT_TRUE(buffer.IsEmpty());
+}
+
+TEST(RingBuffer, ShouldDestroyComplexItems)
+{
+	TestComplexType::Reset();
+
+	{
+		Baroque::RingBuffer<TestComplexType> buffer;
+
+		for (int i = 0; i < 20; ++i)
+		{
+			buffer.EmplaceBack(i);
+			buffer.EmplaceFront(-i);
+		}
+
+		buffer.PopFront();
+		buffer.PopBack();
+
+		EXPECT_EQ(TestComplexType::DtorCount, 2);
+		EXPECT_EQ(buffer.Front().Value, -18);
+		EXPECT_EQ(buffer.Back().Value, 18);
+
+		Baroque::RingBuffer<TestComplexType> copy(buffer);
+
+		EXPECT_EQ(TestComplexType::CopyCtorCount, 38);
+		EXPECT_EQ(copy[10].Value, buffer[10].Value);
+
+		Baroque::Array<TestComplexType> popped;
+		popped.Resize(5);
+
+		EXPECT_EQ(buffer.PopFront(popped.ToArraySpan()), 5);
+		EXPECT_EQ(popped[0].Value, -18);
+		EXPECT_EQ(buffer.Size(), 33);
+	}
+
+	EXPECT_EQ(TestComplexType::CtorCount + TestComplexType::CopyCtorCount, TestComplexType::DtorCount);
+}
+
+TEST(RingBuffer, CopyShouldDuplicateItems)
+{
+	Baroque::RingBuffer<int> original;
+
+	for (int i = 0; i < 10; ++i)
+	{
+		original.PushFront(i);
+	}
+
+	Baroque::RingBuffer<int> copy(original);
+
+	copy.PopFront();
+
+	EXPECT_EQ(original.Size(), 10);
+	EXPECT_EQ(original.Front(), 9);
+	EXPECT_EQ(copy.Front(), 8);
+
+	original = copy;
+
+	EXPECT_EQ(original.Size(), 9);
+	EXPECT_EQ(original.Back(), 0);
+}
+
+TEST(RingBuffer, MoveShouldStealHeapData)
+{
+	Baroque::RingBuffer<int> original;
+
+	for (int i = 0; i < 10; ++i)
+	{
+		original.PushBack(i);
+	}
+
+	auto* data = &original.Front();
+
+	Baroque::RingBuffer<int> moved(std::move(original));
+
+	EXPECT_EQ(&moved.Front(), data);
+	EXPECT_EQ(moved.Size(), 10);
+	EXPECT_TRUE(original.IsEmpty());
+	EXPECT_EQ(original.Capacity(), 0);
+
+	original = std::move(moved);
+
+	EXPECT_EQ(&original.Front(), data);
+	EXPECT_TRUE(moved.IsEmpty());
+}
+
+TEST(RingBuffer, MoveShouldMoveInlineItems)
+{
+	using SmallRingBuffer = Baroque::RingBuffer<int, Baroque::Memory::SmallAllocator<256>>;
+
+	SmallRingBuffer original;
+
+	for (int i = 0; i < 10; ++i)
+	{
+		original.PushBack(i);
+	}
+
+	original.PopFront();
+
+	auto* originalStart = reinterpret_cast<std::uint8_t*>(&original);
+	auto* originalData = reinterpret_cast<std::uint8_t*>(&original.Front());
+	EXPECT_TRUE(originalData >= originalStart && originalData < originalStart + sizeof(original));
+
+	SmallRingBuffer moved(std::move(original));
+
+	auto* movedStart = reinterpret_cast<std::uint8_t*>(&moved);
+	auto* movedData = reinterpret_cast<std::uint8_t*>(&moved.Front());
+	EXPECT_TRUE(movedData >= movedStart && movedData < movedStart + sizeof(moved));
+
+	EXPECT_EQ(moved.Size(), 9);
+	EXPECT_EQ(moved.Front(), 1);
+	EXPECT_EQ(moved.Back(), 9);
+	EXPECT_TRUE(original.IsEmpty());
+
+	original.PushBack(1);
+	EXPECT_EQ(original.Front(), 1);
+}
+
+TEST(RingBuffer, ShouldGrowOutOfInlineStorage)
+{
+	Baroque::RingBuffer<int, Baroque::Memory::SmallAllocator<256>> buffer;
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		buffer.PushBack(i);
+	}
+
+	EXPECT_EQ(buffer.Size(), 1000);
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		EXPECT_EQ(buffer[i], i);
+	}
+}
+
+TEST(RingBuffer, ShouldStartInSmallInlineStorage)
+{
+	Baroque::RingBuffer<std::uint64_t, Baroque::Memory::SmallAllocator<32>> buffer;
+
+	buffer.PushBack(1);
+
+	auto* start = reinterpret_cast<std::uint8_t*>(&buffer);
+	auto* data = reinterpret_cast<std::uint8_t*>(&buffer.Front());
+	EXPECT_TRUE(data >= start && data < start + sizeof(buffer));
+	EXPECT_EQ(buffer.Capacity(), 4);
+
+	for (std::uint64_t i = 2; i <= 5; ++i)
+	{
+		buffer.PushBack(i);
+	}
+
+	EXPECT_EQ(buffer.Capacity(), 8);
+	EXPECT_EQ(buffer.Front(), 1);
+	EXPECT_EQ(buffer.Back(), 5);
+}
+
+TEST(RingBuffer, ReserveShouldAbortWhenTheSizeOverflows)
+{
+	Baroque::RingBuffer<std::uint64_t> buffer;
+
+	// The next power of two doesn't fit, a smaller buffer would be overrun
+	EXPECT_DEATH(buffer.Reserve(std::numeric_limits<std::size_t>::max() / 2 + 2), "");
+	EXPECT_DEATH(buffer.Reserve(std::numeric_limits<std::size_t>::max() / sizeof(std::uint64_t) + 1), "");
+}
+
+TEST(RingBuffer, Swap)
+{
+	Baroque::RingBuffer<int> left;
+	Baroque::RingBuffer<int> right;
+
+	left.PushBack(1);
+	right.PushBack(2);
+	right.PushBack(3);
+
+	left.Swap(right);
+
+	EXPECT_EQ(left.Size(), 2);
+	EXPECT_EQ(left.Back(), 3);
+	EXPECT_EQ(right.Size(), 1);
+	EXPECT_EQ(right.Front(), 1);
+}
+
+TEST(FixedRingBuffer, PushShouldFailWhenFull)
+{
+	Baroque::FixedRingBuffer<int, 4> buffer;
+
+	EXPECT_EQ(buffer.Capacity(), 4);
+
+	EXPECT_TRUE(buffer.PushBack(1));
+	EXPECT_TRUE(buffer.PushBack(2));
+	EXPECT_TRUE(buffer.PushFront(0));
+	EXPECT_TRUE(buffer.PushBack(3));
+
+	EXPECT_TRUE(buffer.IsFull());
+	EXPECT_FALSE(buffer.PushBack(4));
+	EXPECT_FALSE(buffer.PushFront(-1));
+
+	for (int i = 0; i < 4; ++i)
+	{
+		EXPECT_EQ(buffer[i], i);
+	}
+
+	buffer.PopFront();
+
+	EXPECT_TRUE(buffer.PushBack(4));
+	EXPECT_EQ(buffer.Back(), 4);
+	EXPECT_EQ(buffer.Front(), 1);
+}
+
+TEST(FixedRingBuffer, BulkPushShouldStopWhenFull)
+{
+	Baroque::FixedRingBuffer<int, 8> buffer;
+
+	int values[] = { 0, 1, 2, 3, 4, 5 };
+
+	EXPECT_EQ(buffer.PushBack(Baroque::ArrayView<int>(values, 6)), 6);
+	EXPECT_EQ(buffer.PushBack(Baroque::ArrayView<int>(values, 6)), 2);
+
+	EXPECT_EQ(buffer.Size(), 8);
+	EXPECT_EQ(buffer.Back(), 1);
+}
+
+TEST(FixedRingBuffer, CopyAndMoveShouldKeepOrder)
+{
+	TestComplexType::Reset();
+
+	{
+		Baroque::FixedRingBuffer<TestComplexType, 8> original;
+
+		for (int i = 0; i < 6; ++i)
+		{
+			original.EmplaceBack(i);
+		}
+
+		original.PopFront();
+		original.PopFront();
+		original.EmplaceBack(6);
+		original.EmplaceBack(7);
+		original.EmplaceBack(8);
+
+		Baroque::FixedRingBuffer<TestComplexType, 8> copy(original);
+		Baroque::FixedRingBuffer<TestComplexType, 8> moved(std::move(original));
+
+		EXPECT_TRUE(original.IsEmpty());
+		ASSERT_EQ(copy.Size(), 7);
+		ASSERT_EQ(moved.Size(), 7);
+
+		for (int i = 0; i < 7; ++i)
+		{
+			EXPECT_EQ(copy[i].Value, i + 2);
+			EXPECT_EQ(moved[i].Value, i + 2);
+		}
+
+		original = copy;
+
+		EXPECT_EQ(original.Back().Value, 8);
+	}
+
+	EXPECT_EQ(TestComplexType::CtorCount + TestComplexType::CopyCtorCount, TestComplexType::DtorCount);
+}
\ No newline at end of file
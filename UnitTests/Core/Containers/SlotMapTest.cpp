@@ -0,0 +1,254 @@
+#include <gtest/gtest.h>
+
+#include "Core/Containers/HashSet.h"
+#include "Core/Containers/SlotMap.h"
+#include "UnitTests/Core/TestComplexType.h"
+
+namespace
+{
+	// 4 slots and 63 generations
+	using TinyHandle = Baroque::SlotMapHandle<int, std::uint8_t, 2>;
+}
+
+TEST(SlotMapHandle, ShouldPackIndexAndGeneration)
+{
+	using Handle = Baroque::SlotMapHandle32<int>;
+
+	auto handle = Handle::Make(1234, 56);
+
+	EXPECT_EQ(handle.Index(), 1234);
+	EXPECT_EQ(handle.Generation(), 56);
+	EXPECT_TRUE(handle.IsValid());
+	EXPECT_FALSE(Handle().IsValid());
+	EXPECT_EQ(Handle::GenerationBitCount, 12);
+
+	auto largeHandle = Baroque::SlotMapHandle64<int>::Make(0xFFFFFFFF, 0xFFFFFFFF);
+
+	EXPECT_EQ(largeHandle.Index(), 0xFFFFFFFF);
+	EXPECT_EQ(largeHandle.Generation(), 0xFFFFFFFF);
+}
+
+TEST(SlotMap, ShouldBeEmptyByDefault)
+{
+	Baroque::SlotMap<int> map;
+
+	EXPECT_TRUE(map.IsEmpty());
+	EXPECT_EQ(map.Size(), 0);
+	EXPECT_EQ(map.Find({}), nullptr);
+	EXPECT_FALSE(map.Remove({}));
+	EXPECT_TRUE(map.begin() == map.end());
+}
+
+TEST(SlotMap, ShouldFindAddedValues)
+{
+	Baroque::SlotMap<int> map;
+	Baroque::Array<Baroque::SlotMapHandle32<int>> handles;
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		handles.Add(map.Add(i * 2));
+	}
+
+	EXPECT_EQ(map.Size(), 1000);
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		auto* value = map.Find(handles[i]);
+		ASSERT_NE(value, nullptr);
+		EXPECT_EQ(*value, i * 2);
+	}
+}
+
+TEST(SlotMap, RemovedHandlesShouldNotBeFound)
+{
+	Baroque::SlotMap<int> map;
+
+	auto first = map.Add(1);
+	auto second = map.Add(2);
+
+	EXPECT_TRUE(map.Remove(first));
+	EXPECT_FALSE(map.Remove(first));
+
+	EXPECT_FALSE(map.Contains(first));
+	EXPECT_EQ(map.Find(first), nullptr);
+	EXPECT_EQ(*map.Find(second), 2);
+
+	auto third = map.Add(3);
+
+	EXPECT_NE(third, first);
+	EXPECT_FALSE(map.Contains(first));
+	EXPECT_EQ(*map.Find(third), 3);
+}
+
+TEST(SlotMap, RemoveShouldKeepValuesPacked)
+{
+	Baroque::SlotMap<int> map;
+	Baroque::Array<Baroque::SlotMapHandle32<int>> handles;
+
+	for (int i = 0; i < 100; ++i)
+	{
+		handles.Add(map.Add(i));
+	}
+
+	for (int i = 0; i < 100; i += 3)
+	{
+		EXPECT_TRUE(map.Remove(handles[i]));
+	}
+
+	EXPECT_EQ(map.Size(), 66);
+	EXPECT_EQ(map.end() - map.begin(), 66);
+
+	int sum = 0;
+
+	for (int value : map)
+	{
+		EXPECT_NE(value % 3, 0);
+		sum += value;
+	}
+
+	EXPECT_EQ(sum, 99 * 100 / 2 - 3 * (33 * 34 / 2));
+
+	for (int i = 0; i < 100; ++i)
+	{
+		auto* value = map.Find(handles[i]);
+
+		if (i % 3 == 0)
+		{
+			EXPECT_EQ(value, nullptr);
+		}
+		else
+		{
+			ASSERT_NE(value, nullptr);
+			EXPECT_EQ(*value, i);
+		}
+	}
+}
+
+TEST(SlotMap, GetHandleShouldMatchIterationOrder)
+{
+	Baroque::SlotMap<int> map;
+
+	for (int i = 0; i < 10; ++i)
+	{
+		map.Add(i);
+	}
+
+	map.Remove(map.GetHandle(2));
+	map.Remove(map.GetHandle(0));
+
+	for (std::size_t i = 0; i < map.Size(); ++i)
+	{
+		EXPECT_EQ(map.Find(map.GetHandle(i)), map.begin() + i);
+	}
+}
+
+TEST(SlotMap, ShouldReuseOldestFreeSlot)
+{
+	Baroque::SlotMap<int> map;
+
+	auto first = map.Add(1);
+	auto second = map.Add(2);
+
+	map.Remove(first);
+	map.Remove(second);
+
+	auto third = map.Add(3);
+	auto fourth = map.Add(4);
+
+	EXPECT_EQ(third.Index(), first.Index());
+	EXPECT_EQ(third.Generation(), first.Generation() + 1);
+	EXPECT_EQ(fourth.Index(), second.Index());
+	EXPECT_EQ(map.Add(5).Index(), 2);
+}
+
+TEST(SlotMap, ShouldRetireSlotsWhenGenerationsWrap)
+{
+	Baroque::SlotMap<int, TinyHandle> map;
+	Baroque::HashSet<std::uint8_t> handles;
+
+	TinyHandle handle;
+
+	while ((handle = map.Add(0)).IsValid())
+	{
+		EXPECT_TRUE(handles.Add(handle.Value));
+		map.Remove(handle);
+	}
+
+	EXPECT_EQ(handles.Size(), 4 * 63);
+	EXPECT_TRUE(map.IsEmpty());
+}
+
+TEST(SlotMap, AddShouldFailWhenAllSlotsAreUsed)
+{
+	Baroque::SlotMap<int, TinyHandle> map;
+
+	for (int i = 0; i < 4; ++i)
+	{
+		EXPECT_TRUE(map.Add(i).IsValid());
+	}
+
+	EXPECT_FALSE(map.Add(4).IsValid());
+	EXPECT_EQ(map.Size(), 4);
+
+	map.Remove(map.GetHandle(1));
+
+	EXPECT_TRUE(map.Add(4).IsValid());
+}
+
+TEST(SlotMap, ClearShouldInvalidateHandles)
+{
+	Baroque::SlotMap<int> map;
+
+	auto first = map.Add(1);
+	auto second = map.Add(2);
+
+	map.Clear();
+
+	EXPECT_TRUE(map.IsEmpty());
+	EXPECT_FALSE(map.Contains(first));
+	EXPECT_FALSE(map.Contains(second));
+
+	auto third = map.Add(3);
+
+	EXPECT_EQ(*map.Find(third), 3);
+	EXPECT_EQ(map.Size(), 1);
+}
+
+TEST(SlotMap, ShouldDestroyComplexValues)
+{
+	TestComplexType::Reset();
+
+	{
+		Baroque::SlotMap<TestComplexType, Baroque::SlotMapHandle64<TestComplexType>> map;
+
+		Baroque::Array<Baroque::SlotMapHandle64<TestComplexType>> handles;
+
+		for (int i = 0; i < 10; ++i)
+		{
+			handles.Add(map.Emplace(i));
+		}
+
+		EXPECT_EQ(TestComplexType::CtorCount, 10);
+
+		map.Remove(handles[3]);
+
+		EXPECT_EQ(map.Find(handles[9])->Value, 9);
+		EXPECT_EQ(map.Size(), 9);
+	}
+
+	EXPECT_EQ(TestComplexType::CtorCount + TestComplexType::CopyCtorCount, TestComplexType::DtorCount);
+}
+
+TEST(SlotMap, HandlesShouldBeHashable)
+{
+	Baroque::SlotMap<int> map;
+	Baroque::HashSet<Baroque::SlotMapHandle32<int>> handles;
+
+	for (int i = 0; i < 100; ++i)
+	{
+		handles.Add(map.Add(i));
+	}
+
+	EXPECT_EQ(handles.Size(), 100);
+	EXPECT_TRUE(handles.Contains(map.GetHandle(50)));
+}
\ No newline at end of file
@@ -0,0 +1,299 @@
+#include <gtest/gtest.h>
+
+#include "Core/Containers/SoAArray.h"
+#include "Core/Memory/Alignment.h"
+#include "UnitTests/Core/TestComplexType.h"
+
+#include <memory>
+
+namespace
+{
+	using ParticleArray = Baroque::SoAArray<float, int, double>;
+	using SmallParticleArray = Baroque::SoAArrayImplementation<Baroque::Memory::SmallAllocator<1024>, Baroque::DefaultGrowthPolicy, float, int>;
+}
+
+TEST(SoAArray, ShouldBeEmptyByDefault)
+{
+	ParticleArray array;
+
+	EXPECT_TRUE(array.IsEmpty());
+	EXPECT_EQ(array.Size(), 0);
+	EXPECT_EQ(array.Capacity(), 0);
+	EXPECT_EQ(array.GetColumn<0>().Size(), 0);
+}
+
+TEST(SoAArray, AddShouldFillEachColumn)
+{
+	ParticleArray array;
+
+	for (int i = 0; i < 100; ++i)
+	{
+		array.Add(i * 0.5f, i, i * 2.0);
+	}
+
+	EXPECT_EQ(array.Size(), 100);
+	EXPECT_GE(array.Capacity(), 100);
+
+	auto floats = array.GetColumn<0>();
+	auto ints = array.GetColumn<1>();
+	auto doubles = array.GetColumn<2>();
+
+	ASSERT_EQ(floats.Size(), 100);
+	ASSERT_EQ(ints.Size(), 100);
+	ASSERT_EQ(doubles.Size(), 100);
+
+	for (int i = 0; i < 100; ++i)
+	{
+		EXPECT_EQ(floats[i], i * 0.5f);
+		EXPECT_EQ(ints[i], i);
+		EXPECT_EQ(doubles[i], i * 2.0);
+		EXPECT_EQ(array.Get<1>(i), i);
+	}
+}
+
+TEST(SoAArray, ColumnsShouldBeAligned)
+{
+	Baroque::SoAArray<std::uint8_t, std::uint16_t, double> array;
+
+	for (int i = 0; i < 37; ++i)
+	{
+		array.Add(std::uint8_t(i), std::uint16_t(i), double(i));
+	}
+
+	EXPECT_TRUE(Baroque::Memory::IsAligned(array.GetColumn<0>().begin(), 64));
+	EXPECT_TRUE(Baroque::Memory::IsAligned(array.GetColumn<1>().begin(), 64));
+	EXPECT_TRUE(Baroque::Memory::IsAligned(array.GetColumn<2>().begin(), 64));
+}
+
+TEST(SoAArray, ColumnsShouldBeWritable)
+{
+	ParticleArray array;
+
+	for (int i = 0; i < 10; ++i)
+	{
+		array.Add(1.0f, i, 0.0);
+	}
+
+	for (auto& value : array.GetColumn<0>())
+	{
+		value *= 3.0f;
+	}
+
+	array.Get<2>(4) = 8.0;
+
+	EXPECT_EQ(array.Get<0>(9), 3.0f);
+	EXPECT_EQ(array.Get<2>(4), 8.0);
+}
+
+TEST(SoAArray, ReserveShouldKeepItems)
+{
+	ParticleArray array;
+
+	array.Add(1.0f, 2, 3.0);
+	array.Reserve(1000);
+
+	EXPECT_EQ(array.Capacity(), 1000);
+	EXPECT_EQ(array.Get<0>(0), 1.0f);
+	EXPECT_EQ(array.Get<1>(0), 2);
+	EXPECT_EQ(array.Get<2>(0), 3.0);
+
+	array.Reserve(10);
+
+	EXPECT_EQ(array.Capacity(), 1000);
+}
+
+TEST(SoAArray, RemoveAtSwapShouldMoveLastItem)
+{
+	ParticleArray array;
+
+	for (int i = 0; i < 5; ++i)
+	{
+		array.Add(float(i), i, double(i));
+	}
+
+	array.RemoveAtSwap(1);
+
+	EXPECT_EQ(array.Size(), 4);
+	EXPECT_EQ(array.Get<0>(1), 4.0f);
+	EXPECT_EQ(array.Get<1>(1), 4);
+	EXPECT_EQ(array.Get<2>(1), 4.0);
+
+	array.RemoveAtSwap(3);
+
+	EXPECT_EQ(array.Size(), 3);
+	EXPECT_EQ(array.Get<1>(2), 2);
+
+	array.RemoveAtSwap(3);
+
+	EXPECT_EQ(array.Size(), 3);
+}
+
+TEST(SoAArray, ShouldDestroyComplexColumns)
+{
+	TestComplexType::Reset();
+
+	{
+		Baroque::SoAArray<int, TestComplexType> array;
+
+		for (int i = 0; i < 20; ++i)
+		{
+			array.Add(i, TestComplexType(i));
+		}
+
+		array.RemoveAtSwap(0);
+
+		EXPECT_EQ(array.Get<1>(0).Value, 19);
+
+		Baroque::SoAArray<int, TestComplexType> copy(array);
+
+		EXPECT_EQ(TestComplexType::CopyCtorCount, 19);
+		EXPECT_EQ(copy.Get<1>(0).Value, 19);
+	}
+
+	EXPECT_EQ(TestComplexType::CtorCount + TestComplexType::CopyCtorCount, TestComplexType::DtorCount);
+}
+
+TEST(SoAArray, CopyShouldDuplicateItems)
+{
+	ParticleArray original;
+
+	for (int i = 0; i < 10; ++i)
+	{
+		original.Add(float(i), i, double(i));
+	}
+
+	ParticleArray copy(original);
+
+	copy.Get<1>(0) = 42;
+
+	EXPECT_EQ(copy.Size(), 10);
+	EXPECT_EQ(original.Get<1>(0), 0);
+	EXPECT_EQ(copy.Get<1>(9), 9);
+
+	original = copy;
+
+	EXPECT_EQ(original.Get<1>(0), 42);
+}
+
+TEST(SoAArray, MoveShouldStealHeapData)
+{
+	ParticleArray original;
+
+	for (int i = 0; i < 10; ++i)
+	{
+		original.Add(float(i), i, double(i));
+	}
+
+	auto* data = original.GetColumn<1>().begin();
+
+	ParticleArray moved(std::move(original));
+
+	EXPECT_EQ(moved.GetColumn<1>().begin(), data);
+	EXPECT_EQ(moved.Size(), 10);
+	EXPECT_TRUE(original.IsEmpty());
+	EXPECT_EQ(original.Capacity(), 0);
+
+	original = std::move(moved);
+
+	EXPECT_EQ(original.GetColumn<1>().begin(), data);
+	EXPECT_TRUE(moved.IsEmpty());
+}
+
+TEST(SoAArray, MoveShouldMoveInlineItems)
+{
+	SmallParticleArray original;
+
+	for (int i = 0; i < 10; ++i)
+	{
+		original.Add(float(i), i);
+	}
+
+	auto* originalStart = reinterpret_cast<std::uint8_t*>(&original);
+	auto* originalData = reinterpret_cast<std::uint8_t*>(original.GetColumn<1>().begin());
+	EXPECT_TRUE(originalData >= originalStart && originalData < originalStart + sizeof(original));
+
+	SmallParticleArray moved(std::move(original));
+
+	auto* movedStart = reinterpret_cast<std::uint8_t*>(&moved);
+	auto* movedData = reinterpret_cast<std::uint8_t*>(moved.GetColumn<1>().begin());
+	EXPECT_TRUE(movedData >= movedStart && movedData < movedStart + sizeof(moved));
+
+	EXPECT_EQ(moved.Size(), 10);
+	EXPECT_EQ(moved.Get<1>(9), 9);
+	EXPECT_TRUE(original.IsEmpty());
+
+	original.Add(1.0f, 1);
+	EXPECT_EQ(original.Get<1>(0), 1);
+}
+
+TEST(SoAArray, ShouldGrowOutOfInlineStorage)
+{
+	SmallParticleArray array;
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		array.Add(float(i), i);
+	}
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		EXPECT_EQ(array.Get<0>(i), float(i));
+		EXPECT_EQ(array.Get<1>(i), i);
+	}
+}
+
+TEST(SoAArray, GrowthShouldFillPaddedColumns)
+{
+	ParticleArray array;
+
+	array.Add(1.0f, 1, 1.0);
+
+	// Each column is padded to a cache line, the double column holds 8 items in its 64 bytes
+	EXPECT_EQ(array.Capacity(), 8);
+}
+
+TEST(SoAArray, ShouldFillLargeInlineStorage)
+{
+	using LargeInlineArray = Baroque::SoAArrayImplementation<Baroque::Memory::SmallAllocator<512 * 1024>, Baroque::DefaultGrowthPolicy, std::uint8_t>;
+
+	auto array = std::make_unique<LargeInlineArray>();
+
+	array->Add(std::uint8_t(1));
+
+	// Aligning the column on a cache line can take up to 48 bytes of the stack, the column loses its last cache line
+	EXPECT_EQ(array->Capacity(), 512 * 1024 - 64);
+}
+
+TEST(SoAArray, Swap)
+{
+	ParticleArray left;
+	ParticleArray right;
+
+	left.Add(1.0f, 1, 1.0);
+	right.Add(2.0f, 2, 2.0);
+	right.Add(3.0f, 3, 3.0);
+
+	left.Swap(right);
+
+	EXPECT_EQ(left.Size(), 2);
+	EXPECT_EQ(left.Get<1>(1), 3);
+	EXPECT_EQ(right.Size(), 1);
+	EXPECT_EQ(right.Get<1>(0), 1);
+}
+
+TEST(SoAArray, ClearShouldKeepCapacity)
+{
+	ParticleArray array;
+
+	for (int i = 0; i < 10; ++i)
+	{
+		array.Add(float(i), i, double(i));
+	}
+
+	const auto capacity = array.Capacity();
+
+	array.Clear();
+
+	EXPECT_TRUE(array.IsEmpty());
+	EXPECT_EQ(array.Capacity(), capacity);
+}
\ No newline at end of file
@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+
+#include "Core/Memory/AffixAllocator.h"
+#include "Core/Memory/MallocAllocator.h"
+#include "Core/Memory/StackAllocator.h"
+
+#include <cstring>
+
+namespace
+{
+	struct Violation
+	{
+		const void* Allocation = nullptr;
+		std::size_t Size = 0;
+		int Count = 0;
+	};
+
+	Violation LastViolation;
+
+	void recordViolation(const void* allocation, std::size_t size)
+	{
+		LastViolation.Allocation = allocation;
+		LastViolation.Size = size;
+		++LastViolation.Count;
+	}
+
+	class ScopedViolationRecorder
+	{
+	public:
+		ScopedViolationRecorder()
+		{
+			LastViolation = Violation{};
+			Baroque::Memory::SetGuardBandViolationCallback(&recordViolation);
+		}
+
+		~ScopedViolationRecorder()
+		{
+			Baroque::Memory::SetGuardBandViolationCallback(nullptr);
+		}
+	};
+
+	struct Tail
+	{
+		std::uint32_t Value;
+	};
+
+	using SizedAllocator = Baroque::Memory::AffixAllocator<Baroque::Memory::MallocAllocator, Baroque::Memory::SizePrefix>;
+	using TailAllocator = Baroque::Memory::AffixAllocator<Baroque::Memory::MallocAllocator, Baroque::Memory::SizePrefix, Tail>;
+	using GuardedAllocator = Baroque::Memory::GuardBandAllocator<Baroque::Memory::MallocAllocator>;
+}
+
+TEST(AffixAllocator, ShouldKeepTheRequestedSizeInThePrefix)
+{
+	SizedAllocator allocator;
+
+	void* first = allocator.Allocate(24);
+	void* second = allocator.Allocate(1000);
+
+	EXPECT_EQ(SizedAllocator::GetSize(first), 24u);
+	EXPECT_EQ(SizedAllocator::GetSize(second), 1000u);
+	EXPECT_TRUE(Baroque::Memory::IsAligned(first, Baroque::Memory::DefaultAlignment));
+	EXPECT_TRUE(Baroque::Memory::IsAligned(second, Baroque::Memory::DefaultAlignment));
+
+	std::memset(first, 0xAB, 24);
+	EXPECT_EQ(SizedAllocator::GetSize(first), 24u);
+
+	allocator.Deallocate(first);
+	allocator.Deallocate(second);
+}
+
+TEST(AffixAllocator, ShouldPlaceTheSuffixAfterTheBlock)
+{
+	TailAllocator allocator;
+
+	auto* ptr = static_cast<std::uint8_t*>(allocator.Allocate(13));
+
+	auto* tail = &TailAllocator::GetSuffix(ptr);
+	EXPECT_GE(reinterpret_cast<std::uint8_t*>(tail), ptr + 13);
+	EXPECT_TRUE(Baroque::Memory::IsAligned(tail, alignof(Tail)));
+
+	tail->Value = 42;
+	std::memset(ptr, 0, 13);
+	EXPECT_EQ(TailAllocator::GetSuffix(ptr).Value, 42u);
+
+	allocator.Deallocate(ptr);
+}
+
+TEST(AffixAllocator, ShouldNotReportIntactGuardBands)
+{
+	ScopedViolationRecorder recorder;
+	GuardedAllocator allocator;
+
+	for (std::size_t size : { 1u, 16u, 31u, 4096u })
+	{
+		void* ptr = allocator.Allocate(size);
+		std::memset(ptr, 0, size);
+		allocator.Deallocate(ptr);
+	}
+
+	EXPECT_EQ(LastViolation.Count, 0);
+}
+
+TEST(AffixAllocator, ShouldReportBufferOverrun)
+{
+	ScopedViolationRecorder recorder;
+	GuardedAllocator allocator;
+
+	auto* ptr = static_cast<std::uint8_t*>(allocator.Allocate(20));
+	ptr[20] = 0;
+	allocator.Deallocate(ptr);
+
+	EXPECT_EQ(LastViolation.Count, 1);
+	EXPECT_EQ(LastViolation.Allocation, ptr);
+	EXPECT_EQ(LastViolation.Size, 20u);
+}
+
+TEST(AffixAllocator, ShouldReportBufferUnderrun)
+{
+	ScopedViolationRecorder recorder;
+	GuardedAllocator allocator;
+
+	auto* ptr = static_cast<std::uint8_t*>(allocator.Allocate(20));
+
+	// Through the prefix, the write stays inside an object the compiler knows about
+	auto& guard = GuardedAllocator::GetPrefix(ptr).Guard;
+	std::memset(guard.Bytes, 0, sizeof(guard.Bytes));
+
+	allocator.Deallocate(ptr);
+
+	EXPECT_EQ(LastViolation.Count, 1);
+	EXPECT_EQ(LastViolation.Allocation, ptr);
+}
+
+TEST(AffixAllocator, ShouldReduceTheStackCapacityByTheAffixes)
+{
+	using StackGuardedAllocator = Baroque::Memory::GuardBandAllocator<Baroque::Memory::StackAllocator<256>>;
+
+	static_assert(StackGuardedAllocator::StackCapacity == 256 - StackGuardedAllocator::Overhead, "The affixes must be taken from the stack");
+
+	ScopedViolationRecorder recorder;
+	StackGuardedAllocator allocator;
+
+	void* ptr = allocator.Allocate(StackGuardedAllocator::StackCapacity);
+	EXPECT_NE(ptr, nullptr);
+	EXPECT_TRUE(allocator.Owns(ptr));
+	EXPECT_EQ(allocator.Allocate(1), nullptr);
+
+	allocator.Deallocate(ptr);
+	EXPECT_EQ(LastViolation.Count, 0);
+}
+
+TEST(AffixAllocator, ShouldSupportAlignmentsDividingThePrefix)
+{
+	GuardedAllocator allocator;
+
+	void* ptr = allocator.Allocate(64, GuardedAllocator::PrefixSize);
+	EXPECT_NE(ptr, nullptr);
+	EXPECT_TRUE(Baroque::Memory::IsAligned(ptr, GuardedAllocator::PrefixSize));
+	allocator.Deallocate(ptr);
+
+	EXPECT_EQ(allocator.Allocate(64, GuardedAllocator::PrefixSize * 2), nullptr);
+}
+
+TEST(AffixAllocator, ShouldMoveTheAffixesOnReallocate)
+{
+	static_assert(Baroque::Memory::CanReallocate_v<GuardedAllocator>, "AffixAllocator forwards Reallocate");
+
+	ScopedViolationRecorder recorder;
+	GuardedAllocator allocator;
+
+	auto* ptr = static_cast<std::uint8_t*>(allocator.Allocate(16));
+	std::memset(ptr, 7, 16);
+
+	auto* grown = static_cast<std::uint8_t*>(allocator.Reallocate(ptr, 16, 10000));
+	ASSERT_NE(grown, nullptr);
+	EXPECT_EQ(GuardedAllocator::GetSize(grown), 10000u);
+	EXPECT_EQ(grown[15], 7);
+
+	std::memset(grown, 0, 10000);
+	allocator.Deallocate(grown);
+
+	EXPECT_EQ(LastViolation.Count, 0);
+}
\ No newline at end of file
@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+
+#include "Core/Containers/Array.h"
+#include "Core/Memory/ConcurrentPoolAllocator.h"
+#include "Core/Memory/FallbackAllocator.h"
+#include "Core/Memory/MallocAllocator.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Memory/PoolAllocator.h"
+#include "Core/Memory/SegregatorAllocator.h"
+#include "Core/Memory/StackAllocator.h"
+#include "Core/Memory/ThreadCachingAllocator.h"
+#include "Core/Memory/VirtualMemoryAllocator.h"
+
+#include <cstring>
+
+namespace
+{
+	BAROQUE_REGISTER_MEMORY_CATEGORY(TestAlignedAllocation)
+
+	struct alignas(32) Vector8
+	{
+		float Values[8];
+	};
+
+	struct alignas(64) CacheLinePadded
+	{
+		CacheLinePadded(std::uint32_t value)
+		: Value(value)
+		{
+		}
+
+		std::uint32_t Value;
+	};
+
+	static_assert(alignof(Vector8) > Baroque::Memory::DefaultAlignment, "Test types must be over-aligned");
+	static_assert(alignof(CacheLinePadded) > Baroque::Memory::DefaultAlignment, "Test types must be over-aligned");
+
+	using Baroque::Memory::IsAligned;
+}
+
+TEST(AlignedAllocation, MallocAllocatorShouldAlign)
+{
+	Baroque::Memory::MallocAllocator allocator;
+
+	for (std::size_t alignment = 1; alignment <= 4096; alignment *= 2)
+	{
+		void* allocation = allocator.Allocate(100, alignment);
+
+		ASSERT_TRUE(allocation != nullptr);
+		EXPECT_TRUE(IsAligned(allocation, alignment));
+		EXPECT_TRUE(IsAligned(allocation, Baroque::Memory::DefaultAlignment));
+
+		allocator.Deallocate(allocation);
+	}
+}
+
+TEST(AlignedAllocation, StackAllocatorShouldAlign)
+{
+	Baroque::Memory::StackAllocator<512> allocator;
+
+	EXPECT_TRUE(IsAligned(allocator.Allocate(1), Baroque::Memory::DefaultAlignment));
+	EXPECT_TRUE(IsAligned(allocator.Allocate(3), Baroque::Memory::DefaultAlignment));
+	EXPECT_TRUE(IsAligned(allocator.Allocate(8, 64), 64));
+	EXPECT_TRUE(allocator.Allocate(512, 64) == nullptr);
+}
+
+TEST(AlignedAllocation, FallbackAndSegregatorAllocatorsShouldAlign)
+{
+	Baroque::Memory::FallbackAllocator<Baroque::Memory::StackAllocator<128>, Baroque::Memory::MallocAllocator> fallbackAllocator;
+
+	void* primary = fallbackAllocator.Allocate(32, 32);
+	void* fallback = fallbackAllocator.Allocate(128, 256);
+
+	EXPECT_TRUE(IsAligned(primary, 32));
+	EXPECT_TRUE(IsAligned(fallback, 256));
+
+	fallbackAllocator.Deallocate(fallback);
+	fallbackAllocator.Deallocate(primary);
+
+	Baroque::Memory::SegregatorAllocator<256, Baroque::Memory::StackAllocator<512>, Baroque::Memory::MallocAllocator> segregatorAllocator;
+
+	void* small = segregatorAllocator.Allocate(100, 64);
+	void* large = segregatorAllocator.Allocate(1000, 128);
+
+	EXPECT_TRUE(IsAligned(small, 64));
+	EXPECT_TRUE(IsAligned(large, 128));
+
+	segregatorAllocator.Deallocate(large);
+	segregatorAllocator.Deallocate(small);
+}
+
+TEST(AlignedAllocation, PoolObjectAllocatorsShouldAlignOverAlignedTypes)
+{
+	Baroque::Memory::PoolObjectAllocator<CacheLinePadded, Baroque::Memory::MallocAllocator, 16> poolAllocator;
+	Baroque::Memory::ConcurrentPoolObjectAllocator<CacheLinePadded, Baroque::Memory::MallocAllocator, 16> concurrentPoolAllocator;
+
+	CacheLinePadded* objects[100];
+	CacheLinePadded* concurrentObjects[100];
+
+	for (std::uint32_t i = 0; i < 100; ++i)
+	{
+		objects[i] = poolAllocator.Allocate(i);
+		concurrentObjects[i] = concurrentPoolAllocator.Allocate(i);
+
+		EXPECT_TRUE(IsAligned(objects[i], alignof(CacheLinePadded)));
+		EXPECT_TRUE(IsAligned(concurrentObjects[i], alignof(CacheLinePadded)));
+	}
+
+	for (std::uint32_t i = 0; i < 100; ++i)
+	{
+		EXPECT_EQ(objects[i]->Value, i);
+		EXPECT_EQ(concurrentObjects[i]->Value, i);
+
+		poolAllocator.Deallocate(objects[i]);
+		concurrentPoolAllocator.Deallocate(concurrentObjects[i]);
+	}
+}
+
+TEST(AlignedAllocation, ThreadCachingAllocatorShouldAlign)
+{
+	Baroque::Memory::ThreadCachingAllocator allocator;
+
+	const std::size_t sizes[] = { 1, 24, 100, 200, 1000, 5000, 40000, 200000 };
+
+	for (std::size_t alignment = 1; alignment <= 32 * 1024; alignment *= 2)
+	{
+		for (auto size : sizes)
+		{
+			void* allocation = allocator.Allocate(size, alignment);
+
+			ASSERT_TRUE(allocation != nullptr);
+			EXPECT_TRUE(IsAligned(allocation, alignment));
+			EXPECT_TRUE(allocator.Owns(allocation));
+
+			std::memset(allocation, 0xCD, size);
+
+			allocator.Deallocate(allocation);
+		}
+	}
+}
+
+TEST(AlignedAllocation, VirtualMemoryAllocatorsShouldAlign)
+{
+	Baroque::Memory::VirtualMemoryAllocator virtualMemoryAllocator;
+	Baroque::Memory::HugePageAllocator hugePageAllocator;
+
+	const auto hugePageSize = Baroque::Memory::VirtualMemoryAllocator::GetHugePageSize();
+
+	for (std::size_t alignment = 16; alignment <= hugePageSize; alignment *= 4)
+	{
+		void* allocation = virtualMemoryAllocator.Allocate(1000, alignment);
+		void* hugeAllocation = hugePageAllocator.Allocate(2 * hugePageSize, alignment);
+
+		ASSERT_TRUE(allocation != nullptr);
+		ASSERT_TRUE(hugeAllocation != nullptr);
+		EXPECT_TRUE(IsAligned(allocation, alignment));
+		EXPECT_TRUE(IsAligned(hugeAllocation, alignment));
+
+		std::memset(allocation, 0xCD, 1000);
+		std::memset(hugeAllocation, 0xCD, 2 * hugePageSize);
+
+		virtualMemoryAllocator.Deallocate(allocation);
+		hugePageAllocator.Deallocate(hugeAllocation);
+	}
+}
+
+TEST(AlignedAllocation, DefaultAllocatorShouldAlign)
+{
+	Baroque::Memory::DefaultAllocator allocator;
+
+	void* allocation = BAROQUE_ALLOC_ALIGNED(allocator, 100, 256, TestAlignedAllocation);
+
+	EXPECT_TRUE(IsAligned(allocation, 256));
+
+	allocator.Deallocate(allocation);
+}
+
+TEST(AlignedAllocation, ArrayShouldAlignOverAlignedTypes)
+{
+	Baroque::Array<Vector8> vectors;
+	Baroque::Array<CacheLinePadded> paddedValues;
+
+	for (std::uint32_t i = 0; i < 100; ++i)
+	{
+		Vector8 vector;
+		for (auto& value : vector.Values)
+		{
+			value = static_cast<float>(i);
+		}
+
+		vectors.Add(vector);
+		paddedValues.Add(CacheLinePadded(i));
+
+		EXPECT_TRUE(IsAligned(vectors.Data(), alignof(Vector8)));
+		EXPECT_TRUE(IsAligned(paddedValues.Data(), alignof(CacheLinePadded)));
+	}
+
+	for (std::uint32_t i = 0; i < 100; ++i)
+	{
+		EXPECT_EQ(vectors[i].Values[7], static_cast<float>(i));
+		EXPECT_EQ(paddedValues[i].Value, i);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+#include <gtest/gtest.h>
+
+#include "Core/Memory/Alignment.h"
+
+#include <limits>
+
+TEST(Alignment, NextPowerOfTwoShouldRoundUp)
+{
+	using Baroque::Memory::NextPowerOfTwo;
+
+	EXPECT_EQ(NextPowerOfTwo(0), 1);
+	EXPECT_EQ(NextPowerOfTwo(1), 1);
+	EXPECT_EQ(NextPowerOfTwo(2), 2);
+	EXPECT_EQ(NextPowerOfTwo(3), 4);
+	EXPECT_EQ(NextPowerOfTwo(1000), 1024);
+	EXPECT_EQ(NextPowerOfTwo(1024), 1024);
+	EXPECT_EQ(NextPowerOfTwo(1025), 2048);
+}
+
+TEST(Alignment, NextPowerOfTwoShouldBeZeroWhenItDoesNotFit)
+{
+	using Baroque::Memory::NextPowerOfTwo;
+
+	constexpr std::size_t highestPowerOfTwo = std::size_t(1) << (std::numeric_limits<std::size_t>::digits - 1);
+
+	static_assert(NextPowerOfTwo(highestPowerOfTwo - 1) == highestPowerOfTwo, "The highest power of two is reachable");
+
+	EXPECT_EQ(NextPowerOfTwo(highestPowerOfTwo), highestPowerOfTwo);
+	EXPECT_EQ(NextPowerOfTwo(highestPowerOfTwo + 1), 0);
+	EXPECT_EQ(NextPowerOfTwo(std::numeric_limits<std::size_t>::max()), 0);
+}
\ No newline at end of file
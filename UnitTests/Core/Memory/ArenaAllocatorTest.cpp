@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include "Core/Containers/Array.h"
+#include "Core/Memory/ArenaAllocator.h"
+
+namespace
+{
+	using TestArenaAllocator = Baroque::Memory::ArenaAllocator<Baroque::Memory::DefaultAllocator, 1024>;
+}
+
+TEST(ArenaAllocator, ShouldAllocateConsecutively)
+{
+	TestArenaAllocator arena;
+
+	auto* first = static_cast<std::uint8_t*>(arena.Allocate(32));
+	auto* second = static_cast<std::uint8_t*>(arena.Allocate(32));
+
+	ASSERT_TRUE(first != nullptr);
+	EXPECT_EQ(second, first + 32);
+	EXPECT_TRUE(arena.Owns(first));
+	EXPECT_TRUE(arena.Owns(second));
+}
+
+TEST(ArenaAllocator, ShouldAlignAllocations)
+{
+	TestArenaAllocator arena;
+
+	arena.Allocate(1);
+
+	EXPECT_EQ(reinterpret_cast<std::uintptr_t>(arena.Allocate(8)) % Baroque::Memory::DefaultAlignment, 0u);
+	EXPECT_EQ(reinterpret_cast<std::uintptr_t>(arena.Allocate(8, 64)) % 64, 0u);
+	EXPECT_EQ(reinterpret_cast<std::uintptr_t>(arena.Allocate(8, 512)) % 512, 0u);
+	EXPECT_EQ(reinterpret_cast<std::uintptr_t>(arena.Allocate(3000, 4096)) % 4096, 0u);
+}
+
+TEST(ArenaAllocator, ShouldRollbackTheLastAllocation)
+{
+	TestArenaAllocator arena;
+
+	void* first = arena.Allocate(32);
+	void* second = arena.Allocate(32);
+
+	arena.Deallocate(first);
+	arena.Deallocate(second);
+
+	EXPECT_EQ(arena.Allocate(32), second);
+}
+
+TEST(ArenaAllocator, ShouldChainPagesAndReuseThemAfterReset)
+{
+	TestArenaAllocator arena;
+
+	void* first = arena.Allocate(16);
+
+	for (std::size_t i = 0; i < 100; ++i)
+	{
+		ASSERT_TRUE(arena.Allocate(100) != nullptr);
+	}
+
+	void* big = arena.Allocate(10000);
+	ASSERT_TRUE(big != nullptr);
+
+	const auto reservedBytes = arena.GetReservedBytes();
+	EXPECT_GE(reservedBytes, 100 * 100 + 10000);
+
+	arena.Reset();
+
+	EXPECT_FALSE(arena.Owns(big));
+	EXPECT_EQ(arena.Allocate(16), first);
+
+	for (std::size_t i = 0; i < 100; ++i)
+	{
+		ASSERT_TRUE(arena.Allocate(100) != nullptr);
+	}
+
+	EXPECT_TRUE(arena.Allocate(10000) != nullptr);
+	EXPECT_EQ(arena.GetReservedBytes(), reservedBytes);
+}
+
+TEST(ArenaAllocator, ShouldRewindToMarkers)
+{
+	TestArenaAllocator arena;
+
+	arena.Allocate(64);
+
+	auto outerMarker = arena.GetMarker();
+	void* outer = arena.Allocate(64);
+
+	auto innerMarker = arena.GetMarker();
+	void* inner = arena.Allocate(64);
+
+	for (std::size_t i = 0; i < 50; ++i)
+	{
+		arena.Allocate(100);
+	}
+
+	arena.Rewind(innerMarker);
+	EXPECT_EQ(arena.Allocate(64), inner);
+
+	arena.Rewind(outerMarker);
+	EXPECT_EQ(arena.Allocate(64), outer);
+}
+
+TEST(ArenaAllocator, ShouldBeUsableByContainers)
+{
+	using ArenaArray = Baroque::Array<int, Baroque::Memory::ScopedArenaAllocator<TestArenaAllocator>>;
+
+	TestArenaAllocator arena;
+
+	{
+		Baroque::Memory::ArenaScope<TestArenaAllocator> scope(arena);
+
+		ArenaArray values;
+
+		for (int i = 0; i < 100; ++i)
+		{
+			values.Add(i);
+		}
+
+		EXPECT_TRUE(arena.Owns(values.Data()));
+
+		for (int i = 0; i < 100; ++i)
+		{
+			EXPECT_EQ(values[i], i);
+		}
+	}
+
+	EXPECT_TRUE(Baroque::Memory::ScopedArenaAllocator<TestArenaAllocator>::Current() == nullptr);
+
+	arena.Reset();
+}
\ No newline at end of file
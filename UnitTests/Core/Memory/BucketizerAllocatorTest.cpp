@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include "Core/Memory/BucketizerAllocator.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Memory/SegregatorAllocator.h"
+
+#include <cstring>
+#include <vector>
+
+namespace
+{
+	using TestBucketizer = Baroque::Memory::BucketizerAllocator<16, 512, 16>;
+
+	std::size_t distance(const std::uint8_t* first, const std::uint8_t* second)
+	{
+		return static_cast<std::size_t>(first < second ? second - first : first - second);
+	}
+}
+
+TEST(BucketizerAllocator, ShouldAllocateFromTheRightBucket)
+{
+	TestBucketizer allocator;
+
+	auto* small = static_cast<std::uint8_t*>(allocator.Allocate(1));
+	auto* sameBucket = static_cast<std::uint8_t*>(allocator.Allocate(16));
+	auto* nextBucket = static_cast<std::uint8_t*>(allocator.Allocate(17));
+
+	ASSERT_TRUE(small != nullptr);
+
+	// Buckets are in separate ranges, entries of a bucket are next to each other
+	EXPECT_EQ(distance(small, sameBucket), 16u);
+	EXPECT_GE(distance(small, nextBucket), 1024u * 1024u);
+
+	EXPECT_EQ(allocator.Reallocate(small, 1, 16), small);
+	EXPECT_EQ(allocator.Reallocate(small, 16, 17), nullptr);
+	EXPECT_EQ(allocator.Reallocate(nextBucket, 17, 32), nextBucket);
+
+	allocator.Deallocate(small);
+	allocator.Deallocate(sameBucket);
+	allocator.Deallocate(nextBucket);
+}
+
+TEST(BucketizerAllocator, ShouldReuseFreedEntries)
+{
+	TestBucketizer allocator;
+
+	void* first = allocator.Allocate(100);
+	allocator.Deallocate(first);
+
+	EXPECT_EQ(allocator.Allocate(100), first);
+}
+
+TEST(BucketizerAllocator, ShouldOnlyServeItsSizes)
+{
+	TestBucketizer allocator;
+
+	EXPECT_EQ(allocator.Allocate(513), nullptr);
+	EXPECT_EQ(allocator.Allocate(16, 32), nullptr);
+	EXPECT_EQ(reinterpret_cast<std::uintptr_t>(allocator.Allocate(24, 16)) % 16, 0u);
+}
+
+TEST(BucketizerAllocator, ShouldOwnItsEntriesOnly)
+{
+	TestBucketizer allocator;
+	TestBucketizer otherAllocator;
+
+	void* entry = allocator.Allocate(64);
+	void* otherEntry = otherAllocator.Allocate(64);
+	int onStack = 0;
+
+	EXPECT_TRUE(allocator.Owns(entry));
+	EXPECT_FALSE(allocator.Owns(otherEntry));
+	EXPECT_FALSE(allocator.Owns(&onStack));
+	EXPECT_FALSE(allocator.Owns(nullptr));
+}
+
+TEST(BucketizerAllocator, ShouldKeepEntriesDistinct)
+{
+	TestBucketizer allocator;
+
+	std::vector<std::pair<std::uint8_t*, std::size_t>> allocations;
+
+	for (std::size_t i = 0; i < 20000; ++i)
+	{
+		const auto size = 1 + (i * 37) % 512;
+
+		auto* allocation = static_cast<std::uint8_t*>(allocator.Allocate(size));
+		ASSERT_TRUE(allocation != nullptr);
+
+		std::memset(allocation, static_cast<int>(i & 0xFF), size);
+		allocations.emplace_back(allocation, size);
+	}
+
+	for (std::size_t i = 0; i < allocations.size(); ++i)
+	{
+		for (std::size_t j = 0; j < allocations[i].second; ++j)
+		{
+			ASSERT_EQ(allocations[i].first[j], static_cast<std::uint8_t>(i & 0xFF));
+		}
+
+		allocator.Deallocate(allocations[i].first);
+	}
+}
+
+TEST(BucketizerAllocator, ShouldRecommitTrimmedBlocks)
+{
+	using SmallBucketizer = Baroque::Memory::BucketizerAllocator<4096, 4096, 16, 4>;
+
+	SmallBucketizer allocator;
+
+	std::vector<void*> allocations;
+
+	for (std::size_t i = 0; i < 64; ++i)
+	{
+		allocations.push_back(allocator.Allocate(4096));
+	}
+
+	// Freed in allocation order so the trimmed blocks aren't at the top of the region
+	for (auto* allocation : allocations)
+	{
+		allocator.Deallocate(allocation);
+	}
+
+	EXPECT_GT(allocator.Trim(), 0u);
+
+	for (std::size_t i = 0; i < 64; ++i)
+	{
+		auto* allocation = static_cast<std::uint8_t*>(allocator.Allocate(4096));
+		ASSERT_TRUE(allocator.Owns(allocation));
+		std::memset(allocation, 1, 4096);
+	}
+}
+
+TEST(BucketizerAllocator, ShouldComposeWithSegregatorAllocator)
+{
+	Baroque::Memory::SegregatorAllocator<512, TestBucketizer, Baroque::Memory::ThreadCachingAllocator> allocator;
+
+	void* small = allocator.Allocate(200);
+	void* large = allocator.Allocate(2000);
+
+	ASSERT_TRUE(small != nullptr);
+	ASSERT_TRUE(large != nullptr);
+	EXPECT_TRUE(allocator.Owns(small));
+	EXPECT_TRUE(allocator.Owns(large));
+
+	allocator.Deallocate(small);
+	allocator.Deallocate(large);
+}
\ No newline at end of file
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+
+#include "Core/Memory/ConcurrentPoolAllocator.h"
+#include "Core/Memory/MallocAllocator.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	struct TestAllocator
+	{
+		static constexpr std::size_t StackCapacity = 0;
+
+		void* Allocate(const std::size_t size)
+		{
+			++AllocateCount;
+			return Mallocator.Allocate(size);
+		}
+
+		void Deallocate(void* ptr)
+		{
+			++DellocateCount;
+			Mallocator.Deallocate(ptr);
+		}
+
+		Baroque::Memory::MallocAllocator Mallocator;
+
+		static std::atomic<std::size_t> AllocateCount;
+		static std::atomic<std::size_t> DellocateCount;
+	};
+
+	std::atomic<std::size_t> TestAllocator::AllocateCount{ 0 };
+	std::atomic<std::size_t> TestAllocator::DellocateCount{ 0 };
+
+	using TestPoolAllocator = Baroque::Memory::ConcurrentPoolAllocator<TestAllocator, 64, 32>;
+
+	struct TestObject
+	{
+		TestObject(std::size_t value)
+		: Value(value)
+		{
+		}
+
+		std::size_t Value;
+	};
+}
+
+TEST(ConcurrentPoolAllocator, ShouldProperlyDeallocateMemoryBlock)
+{
+	TestAllocator::AllocateCount = 0;
+	TestAllocator::DellocateCount = 0;
+
+	{
+		TestPoolAllocator allocator;
+
+		for (std::size_t i = 0; i < 64; ++i)
+		{
+			allocator.Allocate();
+		}
+
+		EXPECT_EQ(TestAllocator::AllocateCount, 2);
+	}
+
+	EXPECT_EQ(TestAllocator::DellocateCount, 2);
+}
+
+TEST(ConcurrentPoolAllocator, ShouldReturnTheSamePointerWhenAllocatingAfterAFree)
+{
+	TestPoolAllocator allocator;
+
+	void* first = allocator.Allocate();
+	allocator.Deallocate(first);
+
+	void* second = allocator.Allocate();
+
+	EXPECT_EQ(first, second);
+
+	allocator.Deallocate(second);
+}
+
+TEST(ConcurrentPoolAllocator, ShouldReuseEntriesFreedByAnotherThread)
+{
+	TestAllocator::AllocateCount = 0;
+
+	TestPoolAllocator allocator;
+
+	constexpr std::size_t EntryCount = 1000;
+
+	for (std::size_t round = 0; round < 10; ++round)
+	{
+		std::vector<void*> entries;
+
+		for (std::size_t i = 0; i < EntryCount; ++i)
+		{
+			entries.push_back(allocator.Allocate());
+		}
+
+		std::thread freeingThread([&]()
+		{
+			for (auto* entry : entries)
+			{
+				allocator.Deallocate(entry);
+			}
+		});
+
+		freeingThread.join();
+	}
+
+	// Only the first rounds allocate blocks, the next ones reuse the entries freed by the other threads
+	EXPECT_LT(TestAllocator::AllocateCount, 2 * EntryCount / 32);
+}
+
+TEST(ConcurrentPoolAllocator, ShouldGiveUniqueEntriesToConcurrentThreads)
+{
+	using ObjectAllocator = Baroque::Memory::ConcurrentPoolObjectAllocator<TestObject, Baroque::Memory::MallocAllocator, 64>;
+
+	ObjectAllocator allocator;
+
+	constexpr std::size_t ThreadCount = 8;
+	constexpr std::size_t IterationCount = 20000;
+	constexpr std::size_t LiveCount = 100;
+
+	std::atomic<bool> failed{ false };
+	std::vector<std::thread> threads;
+
+	for (std::size_t threadIndex = 0; threadIndex < ThreadCount; ++threadIndex)
+	{
+		threads.emplace_back([&, threadIndex]()
+		{
+			TestObject* objects[LiveCount] = {};
+
+			for (std::size_t i = 0; i < IterationCount; ++i)
+			{
+				auto& object = objects[i % LiveCount];
+
+				if (object)
+				{
+					if (object->Value != threadIndex * IterationCount + i - LiveCount)
+					{
+						failed = true;
+					}
+
+					allocator.Deallocate(object);
+				}
+
+				object = allocator.Allocate(threadIndex * IterationCount + i);
+			}
+
+			for (auto* object : objects)
+			{
+				allocator.Deallocate(object);
+			}
+		});
+	}
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	EXPECT_FALSE(failed);
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+#if defined(BAROQUE_TRACE_MEMORY)
+#include <gtest/gtest.h>
+
+#include "Core/Memory/HeapSnapshot.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+	Baroque::Memory::TraceMemoryCategory SnapshotCategoryTest("SnapshotTests");
+
+	const char* SnapshotFileName = "HeapSnapshotTest.snapshot";
+
+	template<typename T>
+	bool readValue(std::FILE* file, T& value)
+	{
+		return std::fread(&value, sizeof(value), 1, file) == 1;
+	}
+}
+
+TEST(HeapSnapshot, ShouldWriteLiveAllocations)
+{
+	// The table never dereferences the pointers, a fake address avoids allocating for real
+	const void* allocation = reinterpret_cast<const void*>(std::uintptr_t(0x200000000));
+
+	Baroque::Memory::RegisterAllocation(allocation, 96, SnapshotCategoryTest, Baroque::SourceLocation{ "SnapshotFile.cpp", "SnapshotFunction", 42 });
+
+	ASSERT_TRUE(Baroque::Memory::WriteHeapSnapshot(SnapshotFileName));
+
+	Baroque::Memory::UnregisterAllocation(allocation);
+
+	std::FILE* file = std::fopen(SnapshotFileName, "rb");
+	ASSERT_TRUE(file != nullptr);
+
+	Baroque::Memory::HeapSnapshotHeader header;
+	ASSERT_TRUE(readValue(file, header));
+	EXPECT_EQ(header.Magic, Baroque::Memory::HeapSnapshotMagic);
+	EXPECT_EQ(header.Version, Baroque::Memory::HeapSnapshotVersion);
+
+	char strings[16][64] = {};
+	bool foundAllocation = false;
+	bool foundEnd = false;
+
+	Baroque::Memory::HeapSnapshotRecordType recordType;
+	while (!foundEnd && readValue(file, recordType))
+	{
+		switch (recordType)
+		{
+			case Baroque::Memory::HeapSnapshotRecordType::String:
+			{
+				std::uint32_t id;
+				std::uint32_t length;
+				ASSERT_TRUE(readValue(file, id) && readValue(file, length));
+
+				char string[256] = {};
+				ASSERT_LT(length, sizeof(string));
+				ASSERT_TRUE(length == 0 || std::fread(string, length, 1, file) == 1);
+
+				if (id < 16)
+				{
+					std::strncpy(strings[id], string, sizeof(strings[id]) - 1);
+				}
+				break;
+			}
+			case Baroque::Memory::HeapSnapshotRecordType::Allocation:
+			{
+				Baroque::Memory::HeapSnapshotAllocation allocationRecord;
+				ASSERT_TRUE(readValue(file, allocationRecord));
+
+				if (allocationRecord.Address == reinterpret_cast<std::uintptr_t>(allocation))
+				{
+					foundAllocation = true;
+
+					EXPECT_EQ(allocationRecord.Size, 96u);
+					EXPECT_EQ(allocationRecord.SampledBytes, 96u);
+					EXPECT_EQ(allocationRecord.Line, 42u);
+					ASSERT_LT(allocationRecord.CategoryNameId, 16u);
+					ASSERT_LT(allocationRecord.FileNameId, 16u);
+					ASSERT_LT(allocationRecord.FunctionId, 16u);
+					EXPECT_STREQ(strings[allocationRecord.CategoryNameId], "SnapshotTests");
+					EXPECT_STREQ(strings[allocationRecord.FileNameId], "SnapshotFile.cpp");
+					EXPECT_STREQ(strings[allocationRecord.FunctionId], "SnapshotFunction");
+				}
+				break;
+			}
+			case Baroque::Memory::HeapSnapshotRecordType::End:
+				foundEnd = true;
+				break;
+			default:
+				FAIL() << "Unknown record type";
+		}
+	}
+
+	std::fclose(file);
+	std::remove(SnapshotFileName);
+
+	EXPECT_TRUE(foundAllocation);
+	EXPECT_TRUE(foundEnd);
+}
+#endif
\ No newline at end of file
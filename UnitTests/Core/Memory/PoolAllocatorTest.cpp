@@ -2,9 +2,16 @@
 
 #include "Core/Memory/PoolAllocator.h"
 #include "Core/Memory/MallocAllocator.h"
+#include "Core/Memory/ThreadCachingAllocator.h"
+#include "Core/Memory/VirtualMemoryAllocator.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
 
 namespace
 {
+	// Only gives default aligned blocks, the pool must not need more
 	struct TestAllocator
 	{
 		static constexpr std::size_t StackCapacity = 0;
@@ -31,6 +38,27 @@ namespace
 	std::size_t TestAllocator::DellocateCount = 0;
 
 	using TestPoolAllocator = Baroque::Memory::PoolAllocator<TestAllocator, 64, 32>;
+
+	constexpr std::size_t EntriesPerBlock = TestPoolAllocator::EntriesPerBlock;
+
+#if defined(BAROQUE_PLATFORM_LINUX)
+	std::size_t residentMemoryBytes()
+	{
+		std::size_t totalPages = 0;
+		std::size_t residentPages = 0;
+
+		if (std::FILE* statm = std::fopen("/proc/self/statm", "r"))
+		{
+			if (std::fscanf(statm, "%zu %zu", &totalPages, &residentPages) != 2)
+			{
+				residentPages = 0;
+			}
+			std::fclose(statm);
+		}
+
+		return residentPages * Baroque::Memory::VirtualMemoryAllocator::GetPageSize();
+	}
+#endif
 }
 
 TEST(PoolAllocator, ShouldProperlyDeallocateMemoryBlock)
@@ -41,15 +69,18 @@ TEST(PoolAllocator, ShouldProperlyDeallocateMemoryBlock)
 	{
 		TestPoolAllocator allocator;
 
-		for (std::size_t i = 0; i < 64; ++i)
+		for (std::size_t i = 0; i < EntriesPerBlock * 2; ++i)
 		{
 			allocator.Allocate();
 		}
 
-		EXPECT_EQ(TestAllocator::AllocateCount, 2);
+		EXPECT_EQ(allocator.GetBlockCount(), 2);
+
+		// The two blocks and the block index
+		EXPECT_EQ(TestAllocator::AllocateCount, 3);
 	}
 
-	EXPECT_EQ(TestAllocator::DellocateCount, 2);
+	EXPECT_EQ(TestAllocator::DellocateCount, 3);
 }
 
 TEST(PoolAllocator, ShouldReturnTheSamePointerWhenAllocatingAfterAFree)
@@ -64,4 +95,209 @@ TEST(PoolAllocator, ShouldReturnTheSamePointerWhenAllocatingAfterAFree)
 	EXPECT_EQ(first, second);
 
 	allocator.Deallocate(second);
-}
\ No newline at end of file
+}
+
+TEST(PoolAllocator, ShouldTrimFreeBlocks)
+{
+	TestAllocator::AllocateCount = 0;
+	TestAllocator::DellocateCount = 0;
+
+	TestPoolAllocator allocator;
+
+	std::vector<void*> entries;
+
+	for (std::size_t i = 0; i < EntriesPerBlock * 10; ++i)
+	{
+		entries.push_back(allocator.Allocate());
+	}
+
+	EXPECT_EQ(allocator.GetBlockCount(), 10);
+
+	// Keep one entry in the first block allocated
+	for (std::size_t i = 1; i < entries.size(); ++i)
+	{
+		allocator.Deallocate(entries[i]);
+	}
+
+	const auto allocateCountBeforeTrim = TestAllocator::AllocateCount;
+	const auto dellocateCountBeforeTrim = TestAllocator::DellocateCount;
+
+	EXPECT_EQ(allocator.Trim(), 9);
+	EXPECT_EQ(allocator.GetBlockCount(), 1);
+	EXPECT_EQ(allocator.GetFreeCount(), EntriesPerBlock - 1);
+
+	// Only the released blocks, trimming doesn't need any memory
+	EXPECT_EQ(TestAllocator::AllocateCount, allocateCountBeforeTrim);
+	EXPECT_EQ(TestAllocator::DellocateCount - dellocateCountBeforeTrim, 9);
+
+	// The remaining free entries are still usable
+	for (std::size_t i = 1; i < EntriesPerBlock; ++i)
+	{
+		entries[i] = allocator.Allocate();
+	}
+
+	EXPECT_EQ(allocator.GetBlockCount(), 1);
+	EXPECT_EQ(allocator.GetFreeCount(), 0);
+
+	for (std::size_t i = 0; i < EntriesPerBlock; ++i)
+	{
+		allocator.Deallocate(entries[i]);
+	}
+}
+
+TEST(PoolAllocator, ShouldKeepFreeEntriesUpToTheRequestedCount)
+{
+	TestPoolAllocator allocator;
+
+	std::vector<void*> entries;
+
+	for (std::size_t i = 0; i < EntriesPerBlock * 10; ++i)
+	{
+		entries.push_back(allocator.Allocate());
+	}
+
+	for (auto* entry : entries)
+	{
+		allocator.Deallocate(entry);
+	}
+
+	EXPECT_EQ(allocator.Trim(EntriesPerBlock * 3 + 1), 7);
+	EXPECT_EQ(allocator.GetFreeCount(), EntriesPerBlock * 3);
+	EXPECT_EQ(allocator.Trim(EntriesPerBlock * 3 + 1), 0);
+}
+
+TEST(PoolAllocator, ShouldTrimAutomaticallyOverTheHighWaterMark)
+{
+	TestPoolAllocator allocator;
+	allocator.SetHighWaterMark(EntriesPerBlock * 2);
+
+	std::vector<void*> entries;
+
+	for (std::size_t i = 0; i < EntriesPerBlock * 100; ++i)
+	{
+		entries.push_back(allocator.Allocate());
+	}
+
+	EXPECT_EQ(allocator.GetBlockCount(), 100);
+
+	const auto allocateCountBeforeFree = TestAllocator::AllocateCount;
+
+	for (auto* entry : entries)
+	{
+		allocator.Deallocate(entry);
+	}
+
+	EXPECT_LE(allocator.GetBlockCount(), 3);
+	EXPECT_EQ(TestAllocator::AllocateCount, allocateCountBeforeFree);
+}
+
+TEST(PoolAllocator, ShouldReleaseBlocksInAnyOrder)
+{
+	static_assert(EntriesPerBlock >= 32, "Blocks must hold at least PreAllocCount entries");
+
+	TestPoolAllocator allocator;
+	allocator.SetHighWaterMark(0);
+
+	std::vector<void*> entries;
+
+	for (std::size_t i = 0; i < EntriesPerBlock * 40; ++i)
+	{
+		entries.push_back(allocator.Allocate());
+	}
+
+	EXPECT_EQ(allocator.GetBlockCount(), 40);
+
+	// Every other entry, then the rest backwards, so the entries of all the blocks are mixed in the cache
+	for (std::size_t i = 0; i < entries.size(); i += 2)
+	{
+		allocator.Deallocate(entries[i]);
+	}
+
+	for (std::size_t i = entries.size() - 1; i < entries.size(); i -= 2)
+	{
+		allocator.Deallocate(entries[i]);
+	}
+
+	allocator.Trim();
+
+	EXPECT_EQ(allocator.GetBlockCount(), 0);
+	EXPECT_EQ(allocator.GetFreeCount(), 0);
+}
+
+TEST(PoolAllocator, ShouldAllocateFromTheDefaultAllocator)
+{
+	// The allocator behind DefaultAllocator, blocks of 128 KB are over the alignments it serves
+	using DefaultPoolAllocator = Baroque::Memory::PoolAllocator<Baroque::Memory::ThreadCachingAllocator, 256>;
+
+	static_assert(DefaultPoolAllocator::BlockSize == 128 * 1024, "The blocks should be large");
+
+	DefaultPoolAllocator allocator;
+
+	std::vector<void*> entries;
+
+	for (std::size_t i = 0; i < DefaultPoolAllocator::EntriesPerBlock * 3; ++i)
+	{
+		auto* entry = allocator.Allocate();
+		ASSERT_NE(entry, nullptr);
+
+		std::memset(entry, 0xCD, 256);
+		entries.push_back(entry);
+	}
+
+	EXPECT_EQ(allocator.GetBlockCount(), 3);
+
+	for (auto* entry : entries)
+	{
+		allocator.Deallocate(entry);
+	}
+
+	EXPECT_EQ(allocator.Trim(), 3);
+	EXPECT_EQ(allocator.GetBlockCount(), 0);
+}
+
+#if defined(BAROQUE_PLATFORM_LINUX)
+TEST(PoolAllocator, ShouldGiveMemoryBackAfterASpike)
+{
+	constexpr std::size_t SpikeCount = 1000000;
+	constexpr std::size_t EntrySize = 64;
+	constexpr std::size_t KeptEvery = 64 * 1024;
+
+	Baroque::Memory::PoolAllocator<Baroque::Memory::VirtualMemoryAllocator, EntrySize, 1024> allocator;
+
+	std::vector<void*> entries(SpikeCount);
+
+	const auto residentBefore = residentMemoryBytes();
+
+	for (auto& entry : entries)
+	{
+		entry = allocator.Allocate();
+		std::memset(entry, 0xCD, EntrySize);
+	}
+
+	const auto residentAtPeak = residentMemoryBytes();
+
+	// The blocks map exactly their pages, leave some room for pages the process gave back meanwhile
+	EXPECT_GE(residentAtPeak, residentBefore + SpikeCount * EntrySize * 9 / 10);
+
+	for (std::size_t i = 0; i < SpikeCount; ++i)
+	{
+		if (i % KeptEvery != 0)
+		{
+			allocator.Deallocate(entries[i]);
+		}
+	}
+
+	allocator.Trim();
+
+	const auto residentAfterTrim = residentMemoryBytes();
+
+	// Only the blocks holding the few kept entries stay resident
+	EXPECT_LT(residentAfterTrim, residentBefore + 8 * 1024 * 1024);
+	EXPECT_LE(allocator.GetBlockCount(), SpikeCount / KeptEvery + 1);
+
+	for (std::size_t i = 0; i < SpikeCount; i += KeptEvery)
+	{
+		allocator.Deallocate(entries[i]);
+	}
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,253 @@
+#include <gtest/gtest.h>
+
+#include "Core/Containers/Array.h"
+#include "Core/Memory/AllocatorTraits.h"
+#include "Core/Memory/ArenaAllocator.h"
+#include "Core/Memory/FallbackAllocator.h"
+#include "Core/Memory/MallocAllocator.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Memory/PoolAllocator.h"
+#include "Core/Memory/SegregatorAllocator.h"
+#include "Core/Memory/StackAllocator.h"
+#include "Core/Memory/ThreadCachingAllocator.h"
+
+#include <cstring>
+
+namespace
+{
+	class CountingMallocAllocator : public Baroque::Memory::MallocAllocator
+	{
+	public:
+		void* Allocate(const std::size_t size)
+		{
+			++AllocationCount;
+			return MallocAllocator::Allocate(size);
+		}
+
+		static inline std::size_t AllocationCount = 0;
+	};
+
+	BAROQUE_DEFINE_ALLOCATOR(CountingAllocator, CountingMallocAllocator);
+
+	struct MovedByConstructor
+	{
+		MovedByConstructor() = default;
+
+		MovedByConstructor(MovedByConstructor&& move)
+		: Value(move.Value)
+		{
+		}
+
+		std::uint32_t Value = 0;
+	};
+
+	static_assert(Baroque::Memory::CanReallocate_v<Baroque::Memory::MallocAllocator>, "MallocAllocator can reallocate");
+	static_assert(Baroque::Memory::CanReallocate_v<Baroque::Memory::DefaultAllocator>, "The default allocator can reallocate");
+	static_assert(!Baroque::Memory::CanReallocate_v<Baroque::Memory::PoolAllocator<Baroque::Memory::MallocAllocator, 64>>, "PoolAllocator can't reallocate");
+
+	void fill(void* ptr, std::size_t size)
+	{
+		auto* bytes = static_cast<std::uint8_t*>(ptr);
+
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			bytes[i] = static_cast<std::uint8_t>(i * 7);
+		}
+	}
+
+	bool isFilled(const void* ptr, std::size_t size)
+	{
+		auto* bytes = static_cast<const std::uint8_t*>(ptr);
+
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			if (bytes[i] != static_cast<std::uint8_t>(i * 7))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+TEST(Reallocate, MallocAllocatorShouldKeepTheContent)
+{
+	Baroque::Memory::MallocAllocator allocator;
+
+	void* ptr = allocator.Allocate(100);
+	fill(ptr, 100);
+
+	ptr = allocator.Reallocate(ptr, 100, 100000);
+
+	ASSERT_TRUE(ptr != nullptr);
+	EXPECT_TRUE(isFilled(ptr, 100));
+
+	allocator.Deallocate(ptr);
+}
+
+TEST(Reallocate, StackAllocatorShouldOnlyGrowTheLastAllocation)
+{
+	Baroque::Memory::StackAllocator<256> allocator;
+
+	void* first = allocator.Allocate(32);
+	void* second = allocator.Allocate(32);
+
+	EXPECT_EQ(allocator.Reallocate(first, 32, 64), nullptr);
+	EXPECT_EQ(allocator.Reallocate(second, 32, 128), second);
+	EXPECT_EQ(allocator.Reallocate(second, 128, 512), nullptr);
+
+	void* third = allocator.Allocate(16);
+	EXPECT_EQ(third, static_cast<std::uint8_t*>(second) + 128);
+}
+
+TEST(Reallocate, ArenaAllocatorShouldOnlyGrowTheLastAllocation)
+{
+	Baroque::Memory::ArenaAllocator<Baroque::Memory::DefaultAllocator, 1024> arena;
+
+	void* first = arena.Allocate(32);
+	void* second = arena.Allocate(32);
+
+	EXPECT_EQ(arena.Reallocate(first, 32, 64), nullptr);
+	EXPECT_EQ(arena.Reallocate(second, 32, 256), second);
+	EXPECT_EQ(arena.Reallocate(second, 256, 4096), nullptr);
+
+	void* third = arena.Allocate(16);
+	EXPECT_EQ(third, static_cast<std::uint8_t*>(second) + 256);
+}
+
+TEST(Reallocate, ThreadCachingAllocatorShouldStayInTheSizeClass)
+{
+	Baroque::Memory::ThreadCachingAllocator allocator;
+
+	void* ptr = allocator.Allocate(20);
+
+	EXPECT_EQ(allocator.Reallocate(ptr, 20, 32), ptr);
+	EXPECT_EQ(allocator.Reallocate(ptr, 32, 100), nullptr);
+
+	allocator.Deallocate(ptr);
+}
+
+TEST(Reallocate, ThreadCachingAllocatorShouldGrowLargeAllocationsInPlace)
+{
+	Baroque::Memory::ThreadCachingAllocator allocator;
+
+	constexpr std::size_t Size = 1024 * 1024;
+
+	void* ptr = allocator.Allocate(Size);
+	fill(ptr, Size);
+
+	ASSERT_EQ(allocator.Reallocate(ptr, Size, 2 * Size), ptr);
+	EXPECT_TRUE(isFilled(ptr, Size));
+
+	// The new pages are committed and zero-filled
+	EXPECT_EQ(static_cast<std::uint8_t*>(ptr)[2 * Size - 1], 0u);
+	fill(ptr, 2 * Size);
+
+	EXPECT_EQ(allocator.Reallocate(ptr, 2 * Size, 8 * Size), nullptr);
+	EXPECT_EQ(allocator.Reallocate(ptr, 2 * Size, Size), ptr);
+
+	allocator.Deallocate(ptr);
+}
+
+TEST(Reallocate, FallbackAndSegregatorAllocatorsShouldForward)
+{
+	Baroque::Memory::FallbackAllocator<Baroque::Memory::StackAllocator<128>, Baroque::Memory::MallocAllocator> fallback;
+
+	void* onStack = fallback.Allocate(32);
+	EXPECT_EQ(fallback.Reallocate(onStack, 32, 64), onStack);
+	EXPECT_EQ(fallback.Reallocate(onStack, 64, 1024), nullptr);
+
+	void* onHeap = fallback.Allocate(1024);
+	onHeap = fallback.Reallocate(onHeap, 1024, 4096);
+	EXPECT_TRUE(onHeap != nullptr);
+	fallback.Deallocate(onHeap);
+
+	Baroque::Memory::SegregatorAllocator<64, Baroque::Memory::StackAllocator<128>, Baroque::Memory::MallocAllocator> segregator;
+
+	void* small = segregator.Allocate(32);
+	EXPECT_EQ(segregator.Reallocate(small, 32, 64), small);
+	EXPECT_EQ(segregator.Reallocate(small, 64, 65), nullptr);
+}
+
+TEST(Reallocate, ArrayShouldGrowTriviallyRelocatableItemsWithReallocate)
+{
+	Baroque::Array<std::uint32_t, CountingAllocator> values;
+
+	CountingMallocAllocator::AllocationCount = 0;
+
+	for (std::uint32_t i = 0; i < 1000; ++i)
+	{
+		values.Add(i);
+	}
+
+	EXPECT_EQ(CountingMallocAllocator::AllocationCount, 1u);
+
+	for (std::uint32_t i = 0; i < 1000; ++i)
+	{
+		ASSERT_EQ(values[i], i);
+	}
+}
+
+TEST(Reallocate, ArrayShouldMoveOtherItems)
+{
+	Baroque::Array<MovedByConstructor, CountingAllocator> values;
+
+	CountingMallocAllocator::AllocationCount = 0;
+
+	for (std::uint32_t i = 0; i < 100; ++i)
+	{
+		values.Add(MovedByConstructor{});
+	}
+
+	EXPECT_GT(CountingMallocAllocator::AllocationCount, 1u);
+}
+
+TEST(Reallocate, ArrayShouldGrowLargeBuffersInPlace)
+{
+	Baroque::Array<std::uint8_t> bytes;
+
+	bytes.Resize(1024 * 1024);
+	fill(bytes.Data(), bytes.Size());
+
+	auto* data = bytes.Data();
+
+	bytes.Reserve(2 * 1024 * 1024);
+
+	EXPECT_EQ(bytes.Data(), data);
+	EXPECT_TRUE(isFilled(bytes.Data(), bytes.Size()));
+}
+
+TEST(Reallocate, ArrayShouldGrowInTheArena)
+{
+	Baroque::Memory::ArenaAllocator<> arena;
+	Baroque::Memory::ArenaScope<Baroque::Memory::ArenaAllocator<>> scope(arena);
+
+	Baroque::Array<std::uint16_t, Baroque::Memory::ScopedArenaAllocator<>> values;
+
+	values.Add(1);
+
+	auto* data = values.Data();
+
+	for (std::uint16_t i = 0; i < 1000; ++i)
+	{
+		values.Add(i);
+	}
+
+	EXPECT_EQ(values.Data(), data);
+}
+
+#if defined(BAROQUE_TRACE_MEMORY)
+TEST(Reallocate, ShouldTraceTheNewSize)
+{
+	Baroque::Array<std::uint8_t> bytes;
+
+	bytes.Reserve(1024 * 1024);
+	bytes.Reserve(2 * 1024 * 1024);
+
+	auto* allocationInfo = Baroque::Memory::GetAllocationInfo(bytes.Data());
+
+	ASSERT_TRUE(allocationInfo != nullptr);
+	EXPECT_EQ(allocationInfo->Size, 2u * 1024 * 1024);
+}
+#endif
\ No newline at end of file
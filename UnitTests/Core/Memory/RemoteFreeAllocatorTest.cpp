@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+
+#include "Core/Memory/MallocAllocator.h"
+#include "Core/Memory/PoolAllocator.h"
+#include "Core/Memory/RemoteFreeAllocator.h"
+#include "Core/Memory/StackAllocator.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	using Pool = Baroque::Memory::PoolAllocator<Baroque::Memory::MallocAllocator, 32, 64>;
+	using RemotePool = Baroque::Memory::RemoteFreeAllocator<Pool>;
+}
+
+TEST(RemoteFreeAllocator, ShouldFreeOwnerBlocksDirectly)
+{
+	RemotePool allocator;
+
+	void* first = allocator.Allocate(32);
+	allocator.Deallocate(first);
+
+	EXPECT_EQ(allocator.FreeRemoteBlocks(), 0u);
+	EXPECT_EQ(allocator.Allocate(32), first);
+}
+
+TEST(RemoteFreeAllocator, ShouldDeferFreesFromOtherThreads)
+{
+	RemotePool allocator;
+
+	void* blocks[16];
+	for (auto& block : blocks)
+	{
+		block = allocator.Allocate(32);
+	}
+
+	std::thread consumer([&]()
+	{
+		EXPECT_FALSE(allocator.IsOwnerThread());
+
+		for (auto* block : blocks)
+		{
+			allocator.Deallocate(block);
+		}
+	});
+	consumer.join();
+
+	EXPECT_TRUE(allocator.IsOwnerThread());
+	EXPECT_EQ(allocator.FreeRemoteBlocks(), 16u);
+	EXPECT_EQ(allocator.FreeRemoteBlocks(), 0u);
+}
+
+TEST(RemoteFreeAllocator, ShouldReuseRemoteBlocksOnAllocate)
+{
+	RemotePool allocator;
+
+	void* block = allocator.Allocate(32);
+
+	std::thread consumer([&]()
+	{
+		allocator.Deallocate(block, 32);
+	});
+	consumer.join();
+
+	// The remote free is given back to the pool before the allocation, the pool reuses it first
+	EXPECT_EQ(allocator.Allocate(32), block);
+	EXPECT_EQ(allocator.FreeRemoteBlocks(), 0u);
+}
+
+TEST(RemoteFreeAllocator, ShouldHandOverToAnotherThread)
+{
+	RemotePool allocator;
+
+	std::thread producer([&]()
+	{
+		allocator.BindToCurrentThread();
+		EXPECT_TRUE(allocator.IsOwnerThread());
+
+		allocator.Deallocate(allocator.Allocate(32));
+	});
+	producer.join();
+
+	EXPECT_FALSE(allocator.IsOwnerThread());
+	allocator.BindToCurrentThread();
+	EXPECT_TRUE(allocator.IsOwnerThread());
+}
+
+TEST(RemoteFreeAllocator, ShouldRebindWhileOtherThreadsFree)
+{
+	RemotePool allocator;
+
+	std::vector<void*> blocks(1000);
+	for (auto& block : blocks)
+	{
+		block = allocator.Allocate(32);
+	}
+
+	std::atomic<bool> done{ false };
+
+	std::thread consumer([&]()
+	{
+		for (auto* block : blocks)
+		{
+			allocator.Deallocate(block);
+		}
+
+		done.store(true, std::memory_order_release);
+	});
+
+	// The consumer reads the owner while it is written, it is never the owner and defers every free
+	while (!done.load(std::memory_order_acquire))
+	{
+		allocator.BindToCurrentThread();
+	}
+
+	consumer.join();
+
+	EXPECT_EQ(allocator.FreeRemoteBlocks(), blocks.size());
+}
+
+TEST(RemoteFreeAllocator, ShouldKeepStackAllocatorsUsable)
+{
+	Baroque::Memory::RemoteFreeAllocator<Baroque::Memory::StackAllocator<256>> allocator;
+
+	EXPECT_EQ(decltype(allocator)::StackCapacity, 256u);
+
+	void* block = allocator.Allocate(1);
+	EXPECT_TRUE(allocator.Owns(block));
+
+	std::thread consumer([&]()
+	{
+		allocator.Deallocate(block);
+	});
+	consumer.join();
+
+	EXPECT_EQ(allocator.Allocate(64), block);
+}
+
+TEST(RemoteFreeAllocator, ShouldFreeEveryBlockOfAProducerConsumerPipeline)
+{
+	constexpr std::size_t BlockCount = 100000;
+
+	RemotePool allocator;
+
+	std::atomic<void*> handoff[64] = {};
+	std::atomic<std::size_t> consumed{ 0 };
+
+	std::thread consumer([&]()
+	{
+		for (std::size_t i = 0; i < BlockCount; ++i)
+		{
+			auto& slot = handoff[i % 64];
+
+			void* block = nullptr;
+			while (!(block = slot.exchange(nullptr, std::memory_order_acquire)))
+			{
+				std::this_thread::yield();
+			}
+
+			EXPECT_EQ(*static_cast<std::size_t*>(block), i);
+			allocator.Deallocate(block);
+			consumed.fetch_add(1, std::memory_order_relaxed);
+		}
+	});
+
+	for (std::size_t i = 0; i < BlockCount; ++i)
+	{
+		auto* block = static_cast<std::size_t*>(allocator.Allocate(sizeof(std::size_t)));
+		*block = i;
+
+		auto& slot = handoff[i % 64];
+		while (slot.load(std::memory_order_relaxed))
+		{
+			std::this_thread::yield();
+		}
+		slot.store(block, std::memory_order_release);
+	}
+
+	consumer.join();
+	allocator.FreeRemoteBlocks();
+
+	EXPECT_EQ(consumed.load(), BlockCount);
+}
\ No newline at end of file
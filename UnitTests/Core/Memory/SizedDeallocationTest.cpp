@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+
+#include "Core/Containers/Array.h"
+#include "Core/Memory/AffixAllocator.h"
+#include "Core/Memory/AllocatorTraits.h"
+#include "Core/Memory/FallbackAllocator.h"
+#include "Core/Memory/MallocAllocator.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Memory/ObjectAllocator.h"
+#include "Core/Memory/PoolAllocator.h"
+#include "Core/Memory/SegregatorAllocator.h"
+#include "Core/Memory/StackAllocator.h"
+#include "Core/Memory/StatsAllocator.h"
+#include "Core/Memory/ThreadCachingAllocator.h"
+#include "Core/Utilities/UniquePtr.h"
+
+namespace
+{
+	// Remembers the size given to the last sized deallocation
+	class SizeRecordingAllocator : public Baroque::Memory::MallocAllocator
+	{
+	public:
+		using MallocAllocator::Deallocate;
+
+		void Deallocate(void* ptr, const std::size_t size)
+		{
+			LastSize = size;
+			++SizedCount;
+			MallocAllocator::Deallocate(ptr);
+		}
+
+		static void Reset()
+		{
+			LastSize = 0;
+			SizedCount = 0;
+		}
+
+		static inline std::size_t LastSize = 0;
+		static inline std::size_t SizedCount = 0;
+	};
+
+	BAROQUE_DEFINE_ALLOCATOR(RecordingAllocator, SizeRecordingAllocator);
+
+	struct Object
+	{
+		std::uint64_t Values[5];
+	};
+
+	struct StatsTag {};
+
+	using SmallPool = Baroque::Memory::PoolAllocator<Baroque::Memory::ThreadCachingAllocator, 64, 16>;
+	using Stats = Baroque::Memory::StatsAllocator<SizeRecordingAllocator, StatsTag>;
+
+	static_assert(Baroque::Memory::CanDeallocateSized_v<Baroque::Memory::ThreadCachingAllocator>, "ThreadCachingAllocator takes the size");
+	static_assert(Baroque::Memory::CanDeallocateSized_v<Baroque::Memory::SegregatorAllocator<64, SmallPool, Baroque::Memory::MallocAllocator>>, "SegregatorAllocator takes the size");
+	static_assert(!Baroque::Memory::CanDeallocateSized_v<Baroque::Memory::MallocAllocator>, "MallocAllocator ignores the size");
+}
+
+TEST(SizedDeallocation, ShouldFallBackToDeallocateWithoutSize)
+{
+	Baroque::Memory::MallocAllocator allocator;
+
+	void* ptr = allocator.Allocate(100);
+	Baroque::Memory::DeallocateSized(allocator, ptr, 100);
+}
+
+TEST(SizedDeallocation, ShouldRouteSegregatedBlocksBySize)
+{
+	Baroque::Memory::SegregatorAllocator<64, SmallPool, Baroque::Memory::MallocAllocator> allocator;
+
+	void* small = allocator.Allocate(48);
+	void* large = allocator.Allocate(4096);
+
+	allocator.Deallocate(small, 48);
+	allocator.Deallocate(large, 4096);
+
+	// The freed entry is the head of the pool free list
+	EXPECT_EQ(allocator.Allocate(64), small);
+}
+
+TEST(SizedDeallocation, ShouldFindPoolEntriesInEveryBlock)
+{
+	SmallPool pool;
+
+	// Two full blocks and part of a third one
+	void* entries[SmallPool::EntriesPerBlock * 2 + 8];
+	for (auto& entry : entries)
+	{
+		entry = pool.Allocate();
+	}
+
+	EXPECT_EQ(pool.GetBlockCount(), 3u);
+
+	for (auto* entry : entries)
+	{
+		EXPECT_TRUE(pool.Owns(entry));
+	}
+
+	int other = 0;
+	EXPECT_FALSE(pool.Owns(&other));
+
+	for (auto* entry : entries)
+	{
+		pool.Deallocate(entry);
+	}
+}
+
+TEST(SizedDeallocation, ShouldFreeLargeBlocksBySize)
+{
+	Baroque::Memory::ThreadCachingAllocator allocator;
+
+	void* large = allocator.Allocate(4 * 1024 * 1024);
+	ASSERT_NE(large, nullptr);
+	allocator.Deallocate(large, 4 * 1024 * 1024);
+	EXPECT_FALSE(allocator.Owns(large));
+
+	// Small aligned blocks can live in a bigger size class, they are looked up
+	void* aligned = allocator.Allocate(100, 16 * 1024);
+	ASSERT_NE(aligned, nullptr);
+	allocator.Deallocate(aligned, 100);
+
+	void* sizeClassBlock = allocator.Allocate(16 * 1024);
+	EXPECT_EQ(sizeClassBlock, aligned);
+	allocator.Deallocate(sizeClassBlock, 16 * 1024);
+
+	void* small = allocator.Allocate(100);
+	allocator.Deallocate(small, 100);
+}
+
+TEST(SizedDeallocation, ShouldGiveTheCapacityOfArrays)
+{
+	SizeRecordingAllocator::Reset();
+
+	{
+		Baroque::Array<std::uint32_t, RecordingAllocator> values;
+		values.Reserve(100);
+		values.Add(1);
+	}
+
+	EXPECT_EQ(SizeRecordingAllocator::SizedCount, 1u);
+	EXPECT_EQ(SizeRecordingAllocator::LastSize, 100 * sizeof(std::uint32_t));
+}
+
+TEST(SizedDeallocation, ShouldGiveTheObjectSize)
+{
+	SizeRecordingAllocator::Reset();
+
+	Baroque::Memory::ObjectAllocator<Object, SizeRecordingAllocator> allocator;
+
+	auto* object = allocator.Allocate();
+	allocator.Deallocate(object);
+
+	EXPECT_EQ(SizeRecordingAllocator::SizedCount, 1u);
+	EXPECT_EQ(SizeRecordingAllocator::LastSize, sizeof(Object));
+}
+
+TEST(SizedDeallocation, ShouldGiveTheBlockSizeThroughDecorators)
+{
+	SizeRecordingAllocator::Reset();
+
+	Stats stats;
+	stats.Deallocate(stats.Allocate(200));
+
+	EXPECT_EQ(SizeRecordingAllocator::LastSize, 200 + Stats::HeaderSize);
+
+	using Guarded = Baroque::Memory::GuardBandAllocator<SizeRecordingAllocator>;
+
+	Guarded guarded;
+	guarded.Deallocate(guarded.Allocate(32));
+
+	EXPECT_EQ(SizeRecordingAllocator::LastSize, Guarded::PrefixSize + 32 + sizeof(Baroque::Memory::GuardBand<>));
+	EXPECT_EQ(SizeRecordingAllocator::SizedCount, 2u);
+}
+
+TEST(SizedDeallocation, ShouldAskThePrimaryOfFallbackAllocators)
+{
+	SizeRecordingAllocator::Reset();
+
+	Baroque::Memory::FallbackAllocator<Baroque::Memory::StackAllocator<64>, SizeRecordingAllocator> allocator;
+
+	void* stack = allocator.Allocate(32);
+	void* heap = allocator.Allocate(128);
+
+	allocator.Deallocate(heap, 128);
+	allocator.Deallocate(stack, 32);
+
+	EXPECT_EQ(SizeRecordingAllocator::SizedCount, 1u);
+	EXPECT_EQ(SizeRecordingAllocator::LastSize, 128u);
+}
+
+TEST(SizedDeallocation, UniquePtrShouldNotGuessTheSize)
+{
+	SizeRecordingAllocator::Reset();
+
+	SizeRecordingAllocator allocator;
+
+	{
+		// A block larger than the pointed type, the deleter only knows sizeof(Object)
+		auto* object = new (allocator.Allocate(sizeof(Object) * 4)) Object();
+
+		Baroque::UniquePtr<Object, Baroque::Private::AllocatorDeleter<Object, SizeRecordingAllocator>> ptr(allocator, object);
+	}
+
+	EXPECT_EQ(SizeRecordingAllocator::SizedCount, 0u);
+}
\ No newline at end of file
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+
+#include "Core/Memory/ConcurrentPoolAllocator.h"
+#include "Core/Memory/FallbackAllocator.h"
+#include "Core/Memory/MallocAllocator.h"
+#include "Core/Memory/PoolAllocator.h"
+#include "Core/Memory/StackAllocator.h"
+#include "Core/Memory/StatsAllocator.h"
+#include "Core/Memory/ThreadCachingAllocator.h"
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	struct CountingTag
+	{
+		static constexpr const char* Name = "CountingTag";
+	};
+
+	struct PeakTag {};
+	struct ThreadsTag {};
+	struct StackTag {};
+	struct HeapTag {};
+
+	template<typename Tag>
+	using TestStatsAllocator = Baroque::Memory::StatsAllocator<Baroque::Memory::MallocAllocator, Tag>;
+
+	// The size header doesn't fit in pool entries, StatsAllocator refuses them
+	static_assert(Baroque::Memory::HasFixedEntrySize_v<Baroque::Memory::PoolAllocator<Baroque::Memory::MallocAllocator, 64, 4>>, "Pools serve fixed size entries");
+	static_assert(Baroque::Memory::HasFixedEntrySize_v<Baroque::Memory::ConcurrentPoolAllocator<Baroque::Memory::MallocAllocator, 64, 4>>, "Pools serve fixed size entries");
+	static_assert(!Baroque::Memory::HasFixedEntrySize_v<Baroque::Memory::MallocAllocator>, "MallocAllocator serves the requested size");
+}
+
+TEST(StatsAllocator, ShouldCountAllocations)
+{
+	TestStatsAllocator<CountingTag> allocator;
+
+	void* first = allocator.Allocate(100);
+	void* second = allocator.Allocate(1000);
+	allocator.Deallocate(first);
+
+	auto snapshot = TestStatsAllocator<CountingTag>::GetStats().GetSnapshot();
+
+	EXPECT_STREQ(snapshot.Name, "CountingTag");
+	EXPECT_EQ(snapshot.AllocationCount, 2u);
+	EXPECT_EQ(snapshot.DeallocationCount, 1u);
+	EXPECT_EQ(snapshot.AllocatedBytes, 1100u);
+	EXPECT_EQ(snapshot.DeallocatedBytes, 100u);
+	EXPECT_EQ(snapshot.LiveBytes, 1000u);
+	EXPECT_EQ(snapshot.SizeHistogram[6], 1u);
+	EXPECT_EQ(snapshot.SizeHistogram[9], 1u);
+
+	allocator.Deallocate(second);
+}
+
+TEST(StatsAllocator, ShouldTrackThePeak)
+{
+	TestStatsAllocator<PeakTag> allocator;
+
+	std::vector<void*> allocations;
+
+	for (std::size_t i = 0; i < 100; ++i)
+	{
+		allocations.push_back(allocator.Allocate(10000));
+	}
+
+	for (auto* allocation : allocations)
+	{
+		allocator.Deallocate(allocation);
+	}
+
+	auto snapshot = TestStatsAllocator<PeakTag>::GetStats().GetSnapshot();
+
+	EXPECT_EQ(snapshot.LiveBytes, 0u);
+	EXPECT_GE(snapshot.PeakLiveBytes, 1000000u - Baroque::Memory::AllocatorStats::PeakGranularity);
+	EXPECT_LE(snapshot.PeakLiveBytes, 1000000u);
+}
+
+TEST(StatsAllocator, ShouldKeepAlignmentAndContent)
+{
+	TestStatsAllocator<CountingTag> allocator;
+
+	auto* aligned = static_cast<std::uint8_t*>(allocator.Allocate(256, 128));
+	EXPECT_EQ(reinterpret_cast<std::uintptr_t>(aligned) % 128, 0u);
+	std::memset(aligned, 1, 256);
+	allocator.Deallocate(aligned);
+
+	auto* block = static_cast<std::uint8_t*>(allocator.Allocate(64));
+	EXPECT_EQ(reinterpret_cast<std::uintptr_t>(block) % Baroque::Memory::DefaultAlignment, 0u);
+	std::memset(block, 2, 64);
+
+	block = static_cast<std::uint8_t*>(allocator.Reallocate(block, 64, 100000));
+	ASSERT_TRUE(block != nullptr);
+	EXPECT_EQ(block[63], 2u);
+
+	allocator.Deallocate(block);
+}
+
+TEST(StatsAllocator, ShouldCountFromEveryThread)
+{
+	TestStatsAllocator<ThreadsTag> allocator;
+
+	std::vector<std::thread> threads;
+
+	for (std::size_t i = 0; i < 8; ++i)
+	{
+		threads.emplace_back([&allocator]()
+		{
+			for (std::size_t j = 0; j < 1000; ++j)
+			{
+				allocator.Deallocate(allocator.Allocate(32));
+			}
+		});
+	}
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	auto snapshot = TestStatsAllocator<ThreadsTag>::GetStats().GetSnapshot();
+
+	EXPECT_EQ(snapshot.AllocationCount, 8000u);
+	EXPECT_EQ(snapshot.DeallocationCount, 8000u);
+	EXPECT_EQ(snapshot.LiveBytes, 0u);
+}
+
+TEST(StatsAllocator, ShouldCountStackSpills)
+{
+	using StackStats = Baroque::Memory::StatsAllocator<Baroque::Memory::StackAllocator<256>, StackTag>;
+	using HeapStats = Baroque::Memory::StatsAllocator<Baroque::Memory::ThreadCachingAllocator, HeapTag>;
+
+	Baroque::Memory::FallbackAllocator<StackStats, HeapStats> allocator;
+
+	void* onStack = allocator.Allocate(128);
+	void* spilled = allocator.Allocate(512);
+
+	EXPECT_EQ(StackStats::GetStats().GetSnapshot().AllocationCount, 1u);
+	EXPECT_EQ(StackStats::GetStats().GetSnapshot().FailedAllocationCount, 1u);
+	EXPECT_EQ(HeapStats::GetStats().GetSnapshot().AllocationCount, 1u);
+
+	allocator.Deallocate(spilled);
+	allocator.Deallocate(onStack);
+
+	EXPECT_EQ(StackStats::GetStats().GetSnapshot().LiveBytes, 0u);
+	EXPECT_EQ(HeapStats::GetStats().GetSnapshot().LiveBytes, 0u);
+}
+
+TEST(StatsAllocator, ShouldListTheStats)
+{
+	TestStatsAllocator<CountingTag> allocator;
+	allocator.Deallocate(allocator.Allocate(16));
+
+	bool found = false;
+
+	Baroque::Memory::ForEachAllocatorStats([&found](const Baroque::Memory::AllocatorStats& stats)
+	{
+		found |= std::strcmp(stats.GetName(), "CountingTag") == 0;
+	});
+
+	EXPECT_TRUE(found);
+}
\ No newline at end of file
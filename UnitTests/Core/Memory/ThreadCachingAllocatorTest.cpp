@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include "Core/Memory/ThreadCachingAllocator.h"
+
+#include <cstring>
+
+// TODO: Use my own thread class
+#include <thread>
+
+TEST(ThreadCachingAllocator, ShouldAllocateEverySize)
+{
+	Baroque::Memory::ThreadCachingAllocator allocator;
+
+	for (std::size_t size = 1; size <= 40000; size += (size < 1024 ? 7 : 509))
+	{
+		auto* allocation = static_cast<std::uint8_t*>(allocator.Allocate(size));
+
+		ASSERT_TRUE(allocation != nullptr);
+		EXPECT_TRUE(allocator.Owns(allocation));
+		EXPECT_EQ(reinterpret_cast<std::uintptr_t>(allocation) % 16, 0u);
+
+		std::memset(allocation, 0xCD, size);
+
+		allocator.Deallocate(allocation);
+	}
+}
+
+TEST(ThreadCachingAllocator, ShouldNotOwnOtherMemory)
+{
+	Baroque::Memory::ThreadCachingAllocator allocator;
+
+	int onStack = 0;
+
+	EXPECT_FALSE(allocator.Owns(&onStack));
+	EXPECT_FALSE(allocator.Owns(nullptr));
+}
+
+TEST(ThreadCachingAllocator, ShouldReturnDistinctBlocks)
+{
+	constexpr std::size_t AllocationCount = 10000;
+
+	Baroque::Memory::ThreadCachingAllocator allocator;
+
+	std::uint32_t* allocations[AllocationCount];
+
+	for (std::size_t i = 0; i < AllocationCount; ++i)
+	{
+		allocations[i] = static_cast<std::uint32_t*>(allocator.Allocate(24));
+		*allocations[i] = static_cast<std::uint32_t>(i);
+	}
+
+	for (std::size_t i = 0; i < AllocationCount; ++i)
+	{
+		EXPECT_EQ(*allocations[i], i);
+		allocator.Deallocate(allocations[i]);
+	}
+}
+
+TEST(ThreadCachingAllocator, ShouldReuseFreedBlock)
+{
+	Baroque::Memory::ThreadCachingAllocator allocator;
+
+	void* first = allocator.Allocate(64);
+	allocator.Deallocate(first);
+
+	void* second = allocator.Allocate(64);
+
+	EXPECT_EQ(first, second);
+
+	allocator.Deallocate(second);
+}
+
+TEST(ThreadCachingAllocator, ShouldFreeFromAnotherThread)
+{
+	constexpr std::size_t AllocationCount = 50000;
+
+	Baroque::Memory::ThreadCachingAllocator allocator;
+
+	void** allocations = static_cast<void**>(allocator.Allocate(AllocationCount * sizeof(void*)));
+
+	std::thread producer([&]()
+	{
+		for (std::size_t i = 0; i < AllocationCount; ++i)
+		{
+			allocations[i] = allocator.Allocate(16 + (i % 200));
+			std::memset(allocations[i], 0xAB, 16);
+		}
+	});
+	producer.join();
+
+	std::thread consumer([&]()
+	{
+		for (std::size_t i = 0; i < AllocationCount; ++i)
+		{
+			allocator.Deallocate(allocations[i]);
+		}
+	});
+	consumer.join();
+
+	// The blocks released by the exiting consumer thread are available again
+	for (std::size_t i = 0; i < AllocationCount; ++i)
+	{
+		allocations[i] = allocator.Allocate(16 + (i % 200));
+		ASSERT_TRUE(allocations[i] != nullptr);
+	}
+
+	for (std::size_t i = 0; i < AllocationCount; ++i)
+	{
+		allocator.Deallocate(allocations[i]);
+	}
+
+	allocator.Deallocate(allocations);
+}
\ No newline at end of file
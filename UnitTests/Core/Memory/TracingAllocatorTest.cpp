@@ -1,6 +1,7 @@
 #if defined(BAROQUE_TRACE_MEMORY)
 #include <gtest/gtest.h>
 
+#include "Core/Hashing/PointerHash.h"
 #include "Core/Memory/TracingAllocator.h"
 #include "Core/Memory/MallocAllocator.h"
 
@@ -10,6 +11,20 @@ namespace
 
 	Baroque::Memory::TraceMemoryCategory Debug_Category_UnitTests("UnitTests");
 	Baroque::Memory::TraceMemoryCategory CategoryTest("CategoryTests");
+	Baroque::Memory::TraceMemoryCategory ByteCategoryTest("ByteCategoryTests");
+	Baroque::Memory::TraceMemoryCategory ReallocateCategoryTest("ReallocateCategoryTests");
+
+	struct FailingReallocateAllocator : Baroque::Memory::MallocAllocator
+	{
+		void* Reallocate(void* ptr, const std::size_t oldSize, const std::size_t newSize)
+		{
+			BAROQUE_UNUSED(ptr);
+			BAROQUE_UNUSED(oldSize);
+			BAROQUE_UNUSED(newSize);
+
+			return nullptr;
+		}
+	};
 }
 
 TEST(TracingAllocator, ShouldRegisterTheAllocation)
@@ -55,4 +70,236 @@ TEST(TracingAllocator, ShouldChangeTraceCategoryInfo)
 
 	EXPECT_EQ(categoryInfo->DeallocationCount, 1);
 }
+
+TEST(TracingAllocator, ShouldTrackCategoryBytes)
+{
+	TheTracingAllocator allocator;
+	void* first = allocator.Allocate(128, ByteCategoryTest, BAROQUE_SOURCE_LOCATION);
+	void* second = allocator.Allocate(1000, ByteCategoryTest, BAROQUE_SOURCE_LOCATION);
+
+	auto categoryInfo = Baroque::Memory::GetTraceMemoryCategoryInfo(ByteCategoryTest);
+
+	EXPECT_EQ(categoryInfo->LiveBytes, 1128u);
+	EXPECT_EQ(categoryInfo->TotalAllocatedBytes, 1128u);
+	EXPECT_EQ(categoryInfo->PeakLiveBytes, 1128u);
+	EXPECT_EQ(categoryInfo->SizeHistogram[7], 1u);
+	EXPECT_EQ(categoryInfo->SizeHistogram[9], 1u);
+
+	allocator.Deallocate(second);
+
+	EXPECT_EQ(categoryInfo->LiveBytes, 128u);
+	EXPECT_EQ(categoryInfo->TotalAllocatedBytes, 1128u);
+	EXPECT_EQ(categoryInfo->PeakLiveBytes, 1128u);
+
+	allocator.Deallocate(first);
+
+	EXPECT_EQ(categoryInfo->LiveBytes, 0u);
+}
+
+TEST(TracingAllocator, ShouldEnumerateCategories)
+{
+	TheTracingAllocator allocator;
+	void* result = allocator.Allocate(16, CategoryTest, BAROQUE_SOURCE_LOCATION);
+
+	bool found = false;
+
+	Baroque::Memory::ForEachTraceMemoryCategory([&found](const Baroque::Memory::TraceMemoryCategoryInfo& categoryInfo)
+	{
+		if (categoryInfo.Category == &CategoryTest)
+		{
+			found = true;
+		}
+	});
+
+	EXPECT_TRUE(found);
+
+	allocator.Deallocate(result);
+}
+
+TEST(TracingAllocator, ReallocateShouldMoveTheAllocation)
+{
+	TheTracingAllocator allocator;
+	void* result = allocator.Allocate(128, Debug_Category_UnitTests, BAROQUE_SOURCE_LOCATION);
+
+	void* reallocated = allocator.Reallocate(result, 128, 100000, ReallocateCategoryTest, BAROQUE_SOURCE_LOCATION);
+	ASSERT_TRUE(reallocated != nullptr);
+
+	if (reallocated != result)
+	{
+		EXPECT_TRUE(Baroque::Memory::GetAllocationInfo(result) == nullptr);
+	}
+
+	auto allocationInfo = Baroque::Memory::GetAllocationInfo(reallocated);
+
+	ASSERT_TRUE(allocationInfo != nullptr);
+	EXPECT_EQ(allocationInfo->Size, 100000u);
+	EXPECT_EQ(allocationInfo->Category, &ReallocateCategoryTest);
+
+	allocator.Deallocate(reallocated);
+}
+
+TEST(TracingAllocator, FailedReallocateShouldKeepTheOldAllocation)
+{
+	Baroque::Memory::TracingAllocator<FailingReallocateAllocator> allocator;
+	void* result = allocator.Allocate(128, Debug_Category_UnitTests, BAROQUE_SOURCE_LOCATION);
+
+	EXPECT_TRUE(allocator.Reallocate(result, 128, 256, ReallocateCategoryTest, BAROQUE_SOURCE_LOCATION) == nullptr);
+
+	auto allocationInfo = Baroque::Memory::GetAllocationInfo(result);
+
+	ASSERT_TRUE(allocationInfo != nullptr);
+	EXPECT_EQ(allocationInfo->Size, 128u);
+	EXPECT_EQ(allocationInfo->Category, &Debug_Category_UnitTests);
+
+	allocator.Deallocate(result);
+
+	EXPECT_TRUE(Baroque::Memory::GetAllocationInfo(result) == nullptr);
+}
+
+TEST(TracingAllocator, ShouldKeepAllocationsWhileGrowing)
+{
+	constexpr std::size_t AllocationCount = 200000;
+
+	// The table never dereferences the pointers, fake addresses avoid allocating for real
+	auto fakeAllocation = [](std::size_t index)
+	{
+		return reinterpret_cast<const void*>(std::uintptr_t(0x100000000) + index * 16);
+	};
+
+	for (std::size_t i = 0; i < AllocationCount; ++i)
+	{
+		Baroque::Memory::RegisterAllocation(fakeAllocation(i), i, Debug_Category_UnitTests, BAROQUE_SOURCE_LOCATION);
+
+		// Remove every other allocation while the tables are being migrated
+		if (i % 2 == 1)
+		{
+			Baroque::Memory::UnregisterAllocation(fakeAllocation(i - 1));
+		}
+	}
+
+	for (std::size_t i = 0; i < AllocationCount; ++i)
+	{
+		auto allocationInfo = Baroque::Memory::GetAllocationInfo(fakeAllocation(i));
+
+		if (i % 2 == 0)
+		{
+			EXPECT_TRUE(allocationInfo == nullptr);
+		}
+		else
+		{
+			ASSERT_TRUE(allocationInfo != nullptr);
+			EXPECT_EQ(allocationInfo->Size, i);
+		}
+	}
+
+	for (std::size_t i = 1; i < AllocationCount; i += 2)
+	{
+		Baroque::Memory::UnregisterAllocation(fakeAllocation(i));
+	}
+
+	for (std::size_t i = 0; i < AllocationCount; ++i)
+	{
+		EXPECT_TRUE(Baroque::Memory::GetAllocationInfo(fakeAllocation(i)) == nullptr);
+	}
+}
+
+TEST(TracingAllocator, UnregisterShouldKeepTheRestOfTheProbeChain)
+{
+	// Same shard (high 6 bits) and same ideal slot for any shard table up to 64K slots, so the allocations probe one chain
+	constexpr std::uint64_t ChainMask = (~std::uint64_t(0) << 58) | 0xFFFF;
+	constexpr std::size_t ChainLength = 4;
+
+	const void* chain[ChainLength];
+	std::size_t chainSize = 0;
+
+	const auto firstAddress = std::uintptr_t(0x200000000);
+	const auto chainHash = Baroque::Hashing::PointerHash(reinterpret_cast<const void*>(firstAddress)) & ChainMask;
+
+	for (auto address = firstAddress; chainSize < ChainLength; address += 16)
+	{
+		auto allocation = reinterpret_cast<const void*>(address);
+
+		if ((Baroque::Hashing::PointerHash(allocation) & ChainMask) == chainHash)
+		{
+			chain[chainSize++] = allocation;
+		}
+	}
+
+	// The last pointer of the chain is never registered
+	for (std::size_t i = 0; i < ChainLength - 1; ++i)
+	{
+		Baroque::Memory::RegisterAllocation(chain[i], i + 1, Debug_Category_UnitTests, BAROQUE_SOURCE_LOCATION);
+	}
+
+	Baroque::Memory::UnregisterAllocation(chain[0]);
+	Baroque::Memory::UnregisterAllocation(chain[ChainLength - 1]);
+
+	EXPECT_TRUE(Baroque::Memory::GetAllocationInfo(chain[0]) == nullptr);
+	EXPECT_TRUE(Baroque::Memory::GetAllocationInfo(chain[ChainLength - 1]) == nullptr);
+
+	for (std::size_t i = 1; i < ChainLength - 1; ++i)
+	{
+		auto allocationInfo = Baroque::Memory::GetAllocationInfo(chain[i]);
+
+		ASSERT_TRUE(allocationInfo != nullptr);
+		EXPECT_EQ(allocationInfo->Size, i + 1);
+		EXPECT_EQ(allocationInfo->Category, &Debug_Category_UnitTests);
+	}
+
+	for (std::size_t i = 1; i < ChainLength - 1; ++i)
+	{
+		Baroque::Memory::UnregisterAllocation(chain[i]);
+		EXPECT_TRUE(Baroque::Memory::GetAllocationInfo(chain[i]) == nullptr);
+	}
+}
+#endif
+
+#if defined(BAROQUE_SAMPLE_MEMORY)
+#include <gtest/gtest.h>
+
+#include "Core/Memory/TracingAllocator.h"
+
+namespace
+{
+	Baroque::Memory::TraceMemoryCategory SamplingCategoryTest("SamplingTests");
+}
+
+TEST(TracingAllocator, ShouldEstimateBytesFromSamples)
+{
+	constexpr std::size_t AllocationCount = 200000;
+	constexpr std::size_t AllocationSize = 64;
+	constexpr std::size_t ExpectedBytes = AllocationCount * AllocationSize;
+
+	auto previousSamplingInterval = Baroque::Memory::GetTraceMemorySamplingInterval();
+	Baroque::Memory::SetTraceMemorySamplingInterval(4096);
+
+	// The table never dereferences the pointers, fake addresses avoid allocating for real
+	auto fakeAllocation = [](std::size_t index)
+	{
+		return reinterpret_cast<const void*>(std::uintptr_t(0x100000000) + index * AllocationSize);
+	};
+
+	for (std::size_t i = 0; i < AllocationCount; ++i)
+	{
+		Baroque::Memory::RegisterAllocation(fakeAllocation(i), AllocationSize, SamplingCategoryTest, BAROQUE_SOURCE_LOCATION);
+	}
+
+	auto categoryInfo = Baroque::Memory::GetTraceMemoryCategoryInfo(SamplingCategoryTest);
+	ASSERT_TRUE(categoryInfo != nullptr);
+
+	// About 3000 samples, the estimate is within a few percent
+	EXPECT_NEAR(static_cast<double>(categoryInfo->LiveBytes), static_cast<double>(ExpectedBytes), ExpectedBytes * 0.1);
+	EXPECT_NEAR(static_cast<double>(categoryInfo->AllocationCount), static_cast<double>(AllocationCount), AllocationCount * 0.1);
+	EXPECT_EQ(categoryInfo->SizeHistogram[6], categoryInfo->AllocationCount);
+
+	for (std::size_t i = 0; i < AllocationCount; ++i)
+	{
+		Baroque::Memory::UnregisterAllocation(fakeAllocation(i));
+	}
+
+	EXPECT_EQ(categoryInfo->LiveBytes, 0u);
+	EXPECT_EQ(categoryInfo->DeallocationCount, categoryInfo->AllocationCount);
+
+	Baroque::Memory::SetTraceMemorySamplingInterval(previousSamplingInterval);
+}
 #endif
\ No newline at end of file
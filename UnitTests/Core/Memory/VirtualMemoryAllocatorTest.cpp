@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include "Core/Memory/VirtualMemoryAllocator.h"
+
+#include <cstring>
+
+#if defined(BAROQUE_PLATFORM_LINUX)
+#include <sys/mman.h>
+#endif
+
+TEST(VirtualMemoryAllocator, ShouldAllocateZeroFilledMemory)
+{
+	Baroque::Memory::VirtualMemoryAllocator allocator;
+
+	auto* allocation = static_cast<std::uint8_t*>(allocator.Allocate(100000));
+	ASSERT_TRUE(allocation != nullptr);
+
+	EXPECT_EQ(allocation[0], 0u);
+	EXPECT_EQ(allocation[99999], 0u);
+
+	std::memset(allocation, 0xCD, 100000);
+
+	allocator.Deallocate(allocation);
+}
+
+TEST(VirtualMemoryAllocator, PageSizedAllocationsShouldBeExactlyTheirPages)
+{
+	using Baroque::Memory::VirtualMemoryAllocator;
+
+	const auto pageSize = VirtualMemoryAllocator::GetPageSize();
+
+	VirtualMemoryAllocator allocator;
+
+	auto* page = static_cast<std::uint8_t*>(allocator.Allocate(pageSize));
+	auto* aligned = static_cast<std::uint8_t*>(allocator.Allocate(4 * pageSize, 16 * pageSize));
+	ASSERT_TRUE(page != nullptr);
+	ASSERT_TRUE(aligned != nullptr);
+
+	EXPECT_EQ(reinterpret_cast<std::uintptr_t>(page) % pageSize, 0u);
+	EXPECT_EQ(reinterpret_cast<std::uintptr_t>(aligned) % (16 * pageSize), 0u);
+
+	std::memset(page, 0xAB, pageSize);
+	std::memset(aligned, 0xCD, 4 * pageSize);
+
+	allocator.Deallocate(page);
+	allocator.Deallocate(aligned);
+
+#if defined(BAROQUE_PLATFORM_LINUX)
+	// The whole mapping is gone after Deallocate()
+	unsigned char residency[4];
+	EXPECT_NE(::mincore(page, pageSize, residency), 0);
+	EXPECT_NE(::mincore(aligned + 3 * pageSize, pageSize, residency), 0);
+#endif
+}
+
+TEST(VirtualMemoryAllocator, ShouldTrackManyAllocations)
+{
+	Baroque::Memory::VirtualMemoryAllocator allocator;
+
+	constexpr std::size_t AllocationCount = 1000;
+	std::uint8_t* allocations[AllocationCount];
+
+	for (std::size_t i = 0; i < AllocationCount; ++i)
+	{
+		allocations[i] = static_cast<std::uint8_t*>(allocator.Allocate(i + 1));
+		ASSERT_TRUE(allocations[i] != nullptr);
+		allocations[i][i] = static_cast<std::uint8_t>(i);
+	}
+
+	// Free in a different order than the allocations to exercise the table removal
+	for (std::size_t i = 0; i < AllocationCount; i += 2)
+	{
+		EXPECT_EQ(allocations[i][i], static_cast<std::uint8_t>(i));
+		allocator.Deallocate(allocations[i]);
+	}
+
+	for (std::size_t i = 1; i < AllocationCount; i += 2)
+	{
+		EXPECT_EQ(allocations[i][i], static_cast<std::uint8_t>(i));
+		allocator.Deallocate(allocations[i]);
+	}
+}
+
+TEST(VirtualMemoryAllocator, ShouldCommitReservedPages)
+{
+	using Baroque::Memory::VirtualMemoryAllocator;
+
+	const auto pageSize = VirtualMemoryAllocator::GetPageSize();
+	const std::size_t reserveSize = 1024 * 1024 * 1024;
+
+	auto* reserved = static_cast<std::uint8_t*>(VirtualMemoryAllocator::Reserve(reserveSize));
+	ASSERT_TRUE(reserved != nullptr);
+	EXPECT_EQ(reinterpret_cast<std::uintptr_t>(reserved) % pageSize, 0u);
+
+	auto* pages = reserved + 100 * pageSize;
+
+	ASSERT_TRUE(VirtualMemoryAllocator::Commit(pages, 2 * pageSize));
+
+	EXPECT_EQ(pages[0], 0u);
+	std::memset(pages, 0xAB, 2 * pageSize);
+	EXPECT_EQ(pages[2 * pageSize - 1], 0xABu);
+
+	VirtualMemoryAllocator::Decommit(pages, 2 * pageSize);
+
+	// Committing again gives fresh zero-filled pages
+	ASSERT_TRUE(VirtualMemoryAllocator::Commit(pages, 2 * pageSize));
+	EXPECT_EQ(pages[0], 0u);
+	EXPECT_EQ(pages[2 * pageSize - 1], 0u);
+
+	VirtualMemoryAllocator::Release(reserved, reserveSize);
+}
+
+TEST(VirtualMemoryAllocator, ShouldReserveWithHugePages)
+{
+	using Baroque::Memory::VirtualMemoryAllocator;
+
+	const auto hugePageSize = VirtualMemoryAllocator::GetHugePageSize();
+
+	auto* reserved = static_cast<std::uint8_t*>(VirtualMemoryAllocator::Reserve(4 * hugePageSize, Baroque::Memory::VirtualMemoryPages::Huge));
+	ASSERT_TRUE(reserved != nullptr);
+
+	ASSERT_TRUE(VirtualMemoryAllocator::Commit(reserved, 4 * hugePageSize));
+	std::memset(reserved, 0xAB, 4 * hugePageSize);
+
+	VirtualMemoryAllocator::Release(reserved, 4 * hugePageSize);
+}
+
+TEST(HugePageAllocator, ShouldAllocateSmallAndLargeBlocks)
+{
+	Baroque::Memory::HugePageAllocator allocator;
+
+	const auto hugePageSize = Baroque::Memory::VirtualMemoryAllocator::GetHugePageSize();
+
+	auto* small = static_cast<std::uint8_t*>(allocator.Allocate(4096));
+	auto* large = static_cast<std::uint8_t*>(allocator.Allocate(3 * hugePageSize));
+
+	ASSERT_TRUE(small != nullptr);
+	ASSERT_TRUE(large != nullptr);
+
+	EXPECT_EQ(large[0], 0u);
+	EXPECT_EQ(large[3 * hugePageSize - 1], 0u);
+
+	std::memset(small, 0xCD, 4096);
+	std::memset(large, 0xCD, 3 * hugePageSize);
+
+	allocator.Deallocate(small);
+	allocator.Deallocate(large);
+}
\ No newline at end of file
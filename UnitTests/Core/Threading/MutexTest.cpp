@@ -25,3 +25,33 @@ TEST(Mutex, ShouldLock)
 	EXPECT_FALSE(lock.TryLock());
 	testThread.join();
 }
+
+TEST(Mutex, ShouldBeExclusiveUnderContention)
+{
+	constexpr int ThreadCount = 8;
+	constexpr int IterationCount = 20000;
+
+	Baroque::Mutex lock;
+	int counter = 0;
+
+	std::thread threads[ThreadCount];
+
+	for (auto& thread : threads)
+	{
+		thread = std::thread([&lock, &counter]()
+		{
+			for (int i = 0; i < IterationCount; ++i)
+			{
+				Baroque::AutoLock<Baroque::Mutex> autoLock(lock);
+				++counter;
+			}
+		});
+	}
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	EXPECT_EQ(counter, ThreadCount * IterationCount);
+}
\ No newline at end of file
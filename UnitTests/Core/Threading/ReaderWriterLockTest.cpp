@@ -46,4 +46,62 @@ TEST(ReaderWriterLock, LockWriteShouldBeExclusive)
 
 	EXPECT_TRUE(lock.TryLockWrite());
 	lock.UnlockWrite();
-}
\ No newline at end of file
+}
+
+TEST(ReaderWriterLock, AutoTryLockShouldReleaseTheLock)
+{
+	Baroque::ReaderWriterLock lock;
+
+	{
+		Baroque::AutoTryReadLock<Baroque::ReaderWriterLock> autoLock(lock);
+		EXPECT_FALSE(lock.TryLockWrite());
+	}
+
+	{
+		Baroque::AutoTryWriteLock<Baroque::ReaderWriterLock> autoLock(lock);
+		EXPECT_FALSE(lock.TryLockRead());
+	}
+
+	EXPECT_TRUE(lock.TryLockWrite());
+	lock.UnlockWrite();
+}
+
+#if defined(BAROQUE_PLATFORM_LINUX)
+TEST(ReaderWriterLock, WaitingWriterShouldBlockNewReaders)
+{
+	Baroque::ReaderWriterLock lock;
+	lock.LockRead();
+
+	std::thread writerThread(lockWriteThreadFunction, &lock);
+	std::this_thread::sleep_for(40ms);
+
+	EXPECT_FALSE(lock.TryLockRead());
+
+	lock.UnlockRead();
+	writerThread.join();
+
+	EXPECT_TRUE(lock.TryLockRead());
+	lock.UnlockRead();
+}
+
+TEST(ReaderWriterLock, ReaderPreferringShouldLetNewReadersIn)
+{
+	using ReaderPreferringLock = Baroque::ReaderWriterLockImplementation<Baroque::ReaderWriterLockMode::ReaderPreferring>;
+
+	ReaderPreferringLock lock;
+	lock.LockRead();
+
+	std::thread writerThread([&lock]()
+	{
+		lock.LockWrite();
+		lock.UnlockWrite();
+	});
+	std::this_thread::sleep_for(40ms);
+
+	EXPECT_TRUE(lock.TryLockRead());
+	lock.UnlockRead();
+
+	lock.UnlockRead();
+	writerThread.join();
+}
+#endif
\ No newline at end of file
@@ -16,7 +16,7 @@ function baroqueProject(name, projectKind)
 
     configuration "Profile"
         flags { "OptimizeSpeed" }
-        defines { "BAROQUE_PROFILE" }
+        defines { "BAROQUE_PROFILE", "BAROQUE_SAMPLE_MEMORY" }
 
     configuration "Retail"
         flags { "OptimizeSpeed" }
@@ -65,6 +65,20 @@ function baroqueUnitTest(name)
         }
         configuration "vs*"
             buildoptions { "/EHsc" }
+        configuration "linux"
+            links { "pthread" }
+end
+
+function baroqueBenchmark(name)
+    baroqueProject(name, "ConsoleApp")
+        configuration "linux"
+            links { "pthread" }
+end
+
+function baroqueTool(name)
+    baroqueProject(name, "ConsoleApp")
+        configuration "linux"
+            links { "pthread" }
 end
 
 solution "BaroqueEngine"
@@ -108,6 +122,12 @@ solution "BaroqueEngine"
                 "Core/Platforms/Win32/**.h"
             }
 
+        configuration "not linux"
+            excludes {
+                "Core/Platforms/Linux/**.cpp",
+                "Core/Platforms/Linux/**.h"
+            }
+
     group "3rdparty"
 
     baroqueStaticDependency "gtest"
@@ -129,3 +149,23 @@ solution "BaroqueEngine"
         }
 
         links { "Core" }
+
+    group "Benchmarks"
+
+    baroqueBenchmark "CoreBenchmark"
+        files {
+            "Benchmarks/Core/**.cpp",
+            "Benchmarks/Core/**.h"
+        }
+
+        links { "Core" }
+
+    group "Tools"
+
+    baroqueTool "HeapSnapshotDiff"
+        files {
+            "Tools/HeapSnapshotDiff/**.cpp",
+            "Tools/HeapSnapshotDiff/**.h"
+        }
+
+        links { "Core" }